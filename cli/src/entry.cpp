@@ -129,7 +129,23 @@ static std::filesystem::path find_runner(const std::filesystem::path& cli_dir) {
 }
 
 int main(const int argc, const char** argv) try {
-  const std::filesystem::path project_dir = argc >= 2 ? std::filesystem::path(argv[1]) : std::filesystem::current_path();
+  std::filesystem::path project_dir = std::filesystem::current_path();
+  umbra::PakWriterOptions source_options{};
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view argument = argv[i];
+
+    if (argument == "--bytecode") {
+      source_options.compile_scripts = true;
+    } else if (argument == "--strip") {
+      source_options.compile_scripts = true;
+      source_options.strip_debug_info = true;
+    } else if (argument.starts_with("--")) {
+      umbra::umbra_fail("CLI: unknown option '"s + std::string(argument) + "'");
+    } else {
+      project_dir = std::filesystem::path(argument);
+    }
+  }
 
   const umbra::Config config = umbra::load_config(project_dir);
 
@@ -140,7 +156,7 @@ int main(const int argc, const char** argv) try {
   std::vector<uint8_t> secret = generate_secret();
 
   {
-    const auto source_writer = std::make_unique<umbra::PakWriter>(out_dir / "src.pak", secret, config.source_dir);
+    const auto source_writer = std::make_unique<umbra::PakWriter>(out_dir / "src.pak", secret, config.source_dir, source_options);
     source_writer->add_tree(config.source_dir);
 
     const auto assets_writer = std::make_unique<umbra::PakWriter>(out_dir / "ass.pak", secret, config.assets_dir);
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Umbra/builtins.hpp"
+#include "Umbra/vfs.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  // Global `require` that resolves module names against a VFS mount instead of package.path.
+  // "a.b" is looked up as "<root>a/b.lua", then "<root>a/b/init.lua". Each resolved path is executed
+  // once; its result is kept in a registry table keyed by path and returned on every later call.
+  class RequireBuiltin final : public IBuiltin {
+  public:
+
+    explicit RequireBuiltin(const std::shared_ptr<VFS>& vfs, std::string root = "src://") : vfs_(vfs), root_(std::move(root)) {}
+
+    void register_builtin(const std::shared_ptr<sol::state>& lua_state) override {
+      sol::state& lua = *lua_state;
+
+      lua.registry()[LOADED_KEY] = lua.create_table();
+      lua.registry()[LOADING_KEY] = lua.create_table();
+
+      // The VFS owns a reference to this lua state, so only hold it weakly to avoid a cycle.
+      lua.set_function("require", [weak_vfs = std::weak_ptr(vfs_), root = root_](const std::string& module_name, const sol::this_state this_state) -> sol::object {
+        const std::shared_ptr<VFS> vfs = weak_vfs.lock();
+        if (!vfs) {
+          umbra_fail("require: virtual file system is no longer available");
+        }
+
+        sol::state_view state_view(this_state);
+        sol::table loaded = state_view.registry()[LOADED_KEY];
+        sol::table loading = state_view.registry()[LOADING_KEY];
+
+        const std::string path = resolve(*vfs, root, module_name);
+
+        if (sol::object cached = loaded.raw_get<sol::object>(path); cached.valid() && cached.get_type() != sol::type::lua_nil) {
+          return cached;
+        }
+
+        if (loading.raw_get_or(path, false)) {
+          umbra_fail("require: loop while loading module '" + module_name + "' (" + path + ")");
+        }
+
+        const sol::protected_function chunk = vfs->load(path);
+
+        loading.raw_set(path, true);
+        const sol::protected_function_result result = chunk(module_name, path);
+
+        loading.raw_set(path, sol::lua_nil);
+
+        if (!result.valid()) {
+          const sol::error err = result;
+          umbra_fail("require: error loading module '" + module_name + "': " + err.what());
+        }
+
+        sol::object value = result.return_count() > 0 ? result.get<sol::object>(0) : make_object(state_view, sol::lua_nil);
+        if (value.get_type() == sol::type::lua_nil) {
+          value = make_object(state_view, true);
+        }
+
+        loaded.raw_set(path, value);
+        return value;
+      });
+    }
+
+  private:
+    static constexpr const char* LOADED_KEY = "umbra.require.loaded";
+    static constexpr const char* LOADING_KEY = "umbra.require.loading";
+
+    static std::string resolve(const VFS& vfs, const std::string& root, const std::string& module_name) {
+      std::string relative = module_name;
+      std::ranges::replace(relative, '.', '/');
+
+      std::string file_path = root + relative + ".lua";
+      if (vfs.exists(file_path)) {
+        return file_path;
+      }
+
+      std::string init_path = root + relative + "/init.lua";
+      if (vfs.exists(init_path)) {
+        return init_path;
+      }
+
+      umbra_fail("require: module '" + module_name + "' not found (tried " + file_path + ", " + init_path + ")");
+    }
+
+    std::shared_ptr<VFS> vfs_;
+    std::string root_;
+  };
+
+}
@@ -20,6 +20,25 @@ namespace umbra {
     std::filesystem::path source_dir;
     std::string entry;
 
+    size_t pak_cache_budget = 0;
+    bool compress_user_data = false;
+    size_t ram_capacity = 0;
+
+    std::string gc_mode;
+    int gc_pause = 0;
+    int gc_step_multiplier = 0;
+    int gc_step_size = 0;
+    int gc_minor_multiplier = 0;
+    int gc_major_multiplier = 0;
+    double gc_frame_budget_ms = 0.0;
+
+    double target_fps = 0.0;
+    double idle_fps = 0.0;
+    double fixed_update_hz = 0.0;
+    int max_updates_per_frame = 0;
+
+    size_t max_workers = 0;
+
     std::filesystem::path out_dir() const;
   };
 
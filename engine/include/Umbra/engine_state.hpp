@@ -2,6 +2,7 @@
 
 #include "Umbra/builtins.hpp"
 #include "Umbra/config.hpp"
+#include "Umbra/lua_allocator.hpp"
 #include "Umbra/services.hpp"
 #include "Umbra/types.hpp"
 #include "Umbra/vfs.hpp"
@@ -17,8 +18,13 @@ namespace umbra {
 
     Config config;
 
+    std::shared_ptr<LuaAllocator> lua_allocator;
     std::shared_ptr<sol::state> lua_state;
 
+    // Set from Lua through umbra.on_update / umbra.on_render and driven by the engine loop
+    sol::protected_function update_callback;
+    sol::protected_function render_callback;
+
     std::shared_ptr<Ogre::Root> ogre_root;
     Ogre::SceneManager* ogre_scene_manager;
     Ogre::Camera* ogre_camera;
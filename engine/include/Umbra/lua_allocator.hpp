@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Umbra/umbra.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace umbra {
+
+  struct LuaAllocatorStats {
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+    size_t pool_bytes = 0;
+
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t allocated_bytes = 0;
+  };
+
+  // lua_Alloc backed by per-size-class free lists for small blocks. Blocks above LARGE_BLOCK go straight to
+  // malloc. Each Lua state owns its own allocator, so the pools are never shared between threads and take no locks.
+  class UMBRA_API LuaAllocator final {
+  public:
+
+    static constexpr size_t GRANULARITY = 16;
+    static constexpr size_t LARGE_BLOCK = 512;
+    static constexpr size_t CLASS_COUNT = LARGE_BLOCK / GRANULARITY;
+    static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+    LuaAllocator() = default;
+    ~LuaAllocator();
+
+    LuaAllocator(const LuaAllocator&) = delete;
+    LuaAllocator& operator=(const LuaAllocator&) = delete;
+    LuaAllocator(LuaAllocator&&) = delete;
+    LuaAllocator& operator=(LuaAllocator&&) = delete;
+
+    // Matches lua_Alloc; pass the allocator instance as the userdata pointer
+    static void* allocate(void* user_data, void* block, size_t old_size, size_t new_size) noexcept;
+
+    const LuaAllocatorStats& stats() const { return stats_; }
+
+  private:
+    struct FreeBlock {
+      FreeBlock* next;
+    };
+
+    std::array<FreeBlock*, CLASS_COUNT> free_lists_{};
+    std::vector<void*> slabs_;
+
+    LuaAllocatorStats stats_;
+
+    static constexpr size_t size_class(const size_t size) {
+      return (size - 1) / GRANULARITY;
+    }
+
+    void* acquire(size_t size) noexcept;
+    void release(void* block, size_t size) noexcept;
+    bool refill(size_t size_class) noexcept;
+  };
+
+}
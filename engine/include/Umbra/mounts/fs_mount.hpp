@@ -2,14 +2,33 @@
 
 #include "Umbra/vfs.hpp"
 
+#include <cstdint>
 #include <filesystem>
 
 namespace umbra {
 
+  // Stored without the terminator
+  constexpr char FS_COMPRESSED_MAGIC[] = "UMBRAZST";
+  constexpr size_t FS_COMPRESSED_MAGIC_LEN = sizeof(FS_COMPRESSED_MAGIC) - 1;
+
+#pragma pack(push, 1)
+  struct CompressedFileHeader final {
+    char magic[FS_COMPRESSED_MAGIC_LEN];
+    uint32_t version;
+    uint32_t reserved;
+
+    uint64_t raw_size;
+  };
+#pragma pack(pop)
+
+  static_assert(sizeof(CompressedFileHeader) == 24);
+
   class UMBRA_API VFSFSMount final : public IVFSMount {
   public:
 
-    explicit VFSFSMount(const std::filesystem::path& directory, vfs::permissions::VFSPermission permissions);
+    // When `compress` is set, writes are stored zstd-compressed behind a CompressedFileHeader, and reads
+    // detect the header so plain files already on disk keep working. Other mounts return files as stored.
+    explicit VFSFSMount(const std::filesystem::path& directory, vfs::permissions::VFSPermission permissions, bool compress = false);
 
   protected:
     bool exists_s(std::string_view virtual_path) const override;
@@ -20,12 +39,16 @@ namespace umbra {
     void write_s(std::string_view virtual_path, const std::vector<uint8_t>& data) const override;
 
     void execute_s(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const override;
+    sol::protected_function load_s(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const override;
+
+    uint64_t fingerprint_s(std::string_view virtual_path) const override;
 
     void create_s(std::string_view virtual_path) const override;
     void remove_s(std::string_view virtual_path) const override;
 
     vfs::permissions::VFSPermission permission_;
     std::filesystem::path directory_;
+    bool compress_;
   };
 
 }
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace umbra {
   class UMBRA_API VFSPakMount final : public IVFSMount {
   public:
 
-    explicit VFSPakMount(const std::filesystem::path& pak_path, const std::vector<uint8_t>& secret, vfs::permissions::VFSPermission permissions);
+    explicit VFSPakMount(const std::filesystem::path& pak_path, const std::vector<uint8_t>& secret, vfs::permissions::VFSPermission permissions, size_t cache_budget = 0);
 
   protected:
     bool exists_s(std::string_view virtual_path) const override;
@@ -19,6 +19,9 @@ namespace umbra {
     void write_s(std::string_view virtual_path, const std::vector<uint8_t>& data) const override;
 
     void execute_s(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const override;
+    sol::protected_function load_s(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const override;
+
+    uint64_t fingerprint_s(std::string_view virtual_path) const override;
 
     void create_s(std::string_view virtual_path) const override;
     void remove_s(std::string_view virtual_path) const override;
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Umbra/vfs.hpp"
+
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace umbra {
+
+  // Process-memory scratch storage. File contents and index nodes are carved out of a pooled slab
+  // allocator, and the total size of stored paths and contents may not exceed `capacity` bytes.
+  class UMBRA_API VFSRamMount final : public IVFSMount {
+  public:
+
+    explicit VFSRamMount(size_t capacity, vfs::permissions::VFSPermission permissions);
+
+    size_t capacity() const noexcept { return capacity_; }
+    size_t used() const;
+
+  protected:
+    bool exists_s(std::string_view virtual_path) const override;
+
+    std::vector<uint8_t> read_s(std::string_view virtual_path) const override;
+    std::vector<std::string> list_s(std::string_view virtual_path) const override;
+
+    void write_s(std::string_view virtual_path, const std::vector<uint8_t>& data) const override;
+
+    void execute_s(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const override;
+    sol::protected_function load_s(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const override;
+
+    uint64_t fingerprint_s(std::string_view virtual_path) const override;
+
+    void create_s(std::string_view virtual_path) const override;
+    void remove_s(std::string_view virtual_path) const override;
+
+  private:
+    struct RamFile {
+      std::pmr::vector<uint8_t> bytes;
+      uint64_t fingerprint;
+    };
+
+    size_t capacity_;
+    mutable size_t used_ = 0;
+
+    mutable std::mutex mutex_;
+    mutable std::pmr::unsynchronized_pool_resource pool_;
+    mutable std::pmr::unordered_map<std::pmr::string, RamFile> files_;
+  };
+
+}
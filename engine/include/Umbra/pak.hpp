@@ -4,6 +4,9 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <sodium.h>
 #include <string>
 #include <unordered_map>
@@ -58,6 +61,42 @@ namespace umbra {
     uint64_t raw_size;
   };
 
+  // Keeps decrypted but still zstd-compressed entries resident under a byte budget, evicting the least
+  // recently used entry first. A hit only pays for decompression.
+  class UMBRA_API PakCache final {
+  public:
+
+    explicit PakCache(size_t budget = 0) : budget_(budget) {}
+
+    PakCache(const PakCache&) = delete;
+    PakCache& operator=(const PakCache&) = delete;
+
+    std::shared_ptr<const std::vector<uint8_t>> fetch(size_t entry_index);
+    void store(size_t entry_index, std::shared_ptr<const std::vector<uint8_t>> compressed);
+
+    void set_budget(size_t budget);
+    void clear();
+
+    size_t budget() const;
+    size_t resident() const;
+
+  private:
+    struct Slot {
+      size_t entry_index;
+      std::shared_ptr<const std::vector<uint8_t>> compressed;
+    };
+
+    void evict_to(size_t budget);
+
+    std::list<Slot> slots_;
+    std::unordered_map<size_t, std::list<Slot>::iterator> index_;
+
+    size_t budget_ = 0;
+    size_t resident_ = 0;
+
+    mutable std::mutex mutex_;
+  };
+
   class UMBRA_API PakReader final {
   public:
 
@@ -68,14 +107,29 @@ namespace umbra {
     std::vector<uint8_t> read(const std::string& virtual_path) const;
     std::vector<std::string> list() const;
 
+    // Identifies the stored contents of an entry (derived from its nonce and sizes) without reading it.
+    uint64_t fingerprint(const std::string& virtual_path) const;
+
+    void set_cache_budget(size_t budget);
+
   private:
+    std::shared_ptr<const std::vector<uint8_t>> read_compressed(const PakEntry& entry) const;
+
     PakFile pak_file;
+    mutable PakCache cache;
+  };
+
+  struct PakWriterOptions {
+    // Precompile .lua files to Lua bytecode before they are compressed and encrypted.
+    bool compile_scripts = false;
+    // Drop debug information (line numbers, local names) from compiled scripts.
+    bool strip_debug_info = false;
   };
 
   class UMBRA_API PakWriter final {
   public:
 
-    PakWriter(const std::filesystem::path& out_file, const std::vector<uint8_t>& secret, const std::filesystem::path& virtual_base);
+    PakWriter(const std::filesystem::path& out_file, const std::vector<uint8_t>& secret, const std::filesystem::path& virtual_base, const PakWriterOptions& options = {});
     ~PakWriter();
 
     void add_file(const std::filesystem::path& disk_path, const std::filesystem::path& virtual_override = {});
@@ -84,6 +138,7 @@ namespace umbra {
   private:
     std::filesystem::path out_file;
     std::filesystem::path virtual_base;
+    PakWriterOptions options;
     std::vector<uint8_t> secret;
     std::vector<uint8_t> key;
     uint8_t salt[16];
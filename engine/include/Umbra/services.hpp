@@ -88,7 +88,7 @@ namespace umbra {
       static_assert(std::is_base_of_v<IService, T>, "Registered services must inherit from IService");
 
       const auto it = services_.find(name);
-      return it == services_.end() ? nullptr : it->second;
+      return it == services_.end() ? nullptr : std::static_pointer_cast<T>(it->second);
     }
 
     sol::object fetch_service_lua(const std::string& name) {
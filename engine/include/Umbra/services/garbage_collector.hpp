@@ -0,0 +1,225 @@
+#pragma once
+
+#include "Umbra/services.hpp"
+#include "Umbra/engine_state.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace umbra {
+
+  class UMBRA_API GarbageCollectorService final : public IService {
+  public:
+
+    GarbageCollectorService(const GarbageCollectorService&) = delete;
+    GarbageCollectorService& operator=(const GarbageCollectorService&) = delete;
+    GarbageCollectorService(GarbageCollectorService&&) = delete;
+    GarbageCollectorService& operator=(GarbageCollectorService&&) = delete;
+
+    explicit GarbageCollectorService(EngineState* engine_state) : engine_state_(engine_state) {
+      const Config& config = engine_state_->config;
+
+      frame_budget_ms_ = config.gc_frame_budget_ms;
+
+      if (config.gc_mode == "generational") {
+        set_generational(config.gc_minor_multiplier, config.gc_major_multiplier);
+      } else {
+        set_incremental(config.gc_pause, config.gc_step_multiplier, config.gc_step_size);
+      }
+    }
+
+    ~GarbageCollectorService() override = default;
+
+    const char* name() override { return "GarbageCollector"; }
+
+    // Parameters left at 0 keep the collector's current value
+    void set_generational(const sol::optional<int> minor_multiplier, const sol::optional<int> major_multiplier) {
+      lua_gc(lua(), LUA_GCGEN, minor_multiplier.value_or(0), major_multiplier.value_or(0));
+      generational_ = true;
+
+      if (minor_multiplier.value_or(0) != 0) {
+        minor_multiplier_ = *minor_multiplier;
+      }
+
+      minor_base_ = engine_state_->lua_allocator->stats().live_bytes;
+      frame_live_ = minor_base_;
+    }
+
+    void set_incremental(const sol::optional<int> pause, const sol::optional<int> step_multiplier, const sol::optional<int> step_size) {
+      lua_gc(lua(), LUA_GCINC, pause.value_or(0), step_multiplier.value_or(0), step_size.value_or(0));
+      generational_ = false;
+    }
+
+    std::string mode() const {
+      return generational_ ? "generational" : "incremental";
+    }
+
+    void collect() const {
+      lua_gc(lua(), LUA_GCCOLLECT);
+    }
+
+    // Returns true when the step finished a collection cycle
+    bool step(const sol::optional<int> size_kb) const {
+      return lua_gc(lua(), LUA_GCSTEP, size_kb.value_or(0)) != 0;
+    }
+
+    void stop() const {
+      lua_gc(lua(), LUA_GCSTOP);
+    }
+
+    void restart() const {
+      lua_gc(lua(), LUA_GCRESTART);
+    }
+
+    bool is_running() const {
+      return lua_gc(lua(), LUA_GCISRUNNING) != 0;
+    }
+
+    // Heap size in kilobytes
+    double count() const {
+      return lua_gc(lua(), LUA_GCCOUNT) + lua_gc(lua(), LUA_GCCOUNTB) / 1024.0;
+    }
+
+    void set_frame_budget(const double budget_ms) {
+      frame_budget_ms_ = std::max(0.0, budget_ms);
+    }
+
+    double get_frame_budget() const {
+      return frame_budget_ms_;
+    }
+
+    double get_last_step_time() const {
+      return last_step_ms_;
+    }
+
+    // Counters from the engine's Lua allocator; rates are averaged over the last sampling window
+    sol::table get_allocation_stats(sol::this_state this_state) const {
+      sol::state_view lua_state(this_state);
+      sol::table stats = lua_state.create_table();
+
+      const LuaAllocatorStats& allocator_stats = engine_state_->lua_allocator->stats();
+      stats["live_bytes"] = allocator_stats.live_bytes;
+      stats["peak_bytes"] = allocator_stats.peak_bytes;
+      stats["pool_bytes"] = allocator_stats.pool_bytes;
+      stats["allocations"] = allocator_stats.allocations;
+      stats["frees"] = allocator_stats.frees;
+      stats["allocated_bytes"] = allocator_stats.allocated_bytes;
+      stats["allocations_per_second"] = allocations_per_second_;
+      stats["bytes_per_second"] = bytes_per_second_;
+
+      return stats;
+    }
+
+    // Runs collector steps until available_ms (capped by the frame budget) has elapsed or a cycle completes.
+    // A generational step is a whole minor collection, so it only runs when the heap growth of the last
+    // frame would use up what is left before Lua's own next minor collection; the collection it would
+    // have started mid-frame then happens here instead, and idle frames do no work.
+    void step_frame(const double available_ms) {
+      using clock = std::chrono::steady_clock;
+
+      last_step_ms_ = 0.0;
+      sample_allocation_rate();
+
+      const bool minor_due = generational_ && minor_collection_due();
+
+      const double budget_ms = std::min(available_ms, frame_budget_ms_);
+      if (budget_ms <= 0.0 || !is_running()) {
+        return;
+      }
+
+      const clock::time_point start = clock::now();
+      const clock::time_point deadline = start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double, std::milli>(budget_ms));
+
+      if (generational_) {
+        if (minor_due) {
+          lua_gc(lua(), LUA_GCSTEP, 0);
+          minor_base_ = engine_state_->lua_allocator->stats().live_bytes;
+        }
+      } else {
+        while (clock::now() < deadline) {
+          if (lua_gc(lua(), LUA_GCSTEP, 0) != 0) {
+            break;
+          }
+        }
+      }
+
+      last_step_ms_ = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<GarbageCollectorService> user_type = lua_state.new_usertype<GarbageCollectorService>(name(),
+        "set_generational", &GarbageCollectorService::set_generational,
+        "set_incremental", &GarbageCollectorService::set_incremental,
+        "mode", &GarbageCollectorService::mode,
+        "collect", &GarbageCollectorService::collect,
+        "step", &GarbageCollectorService::step,
+        "stop", &GarbageCollectorService::stop,
+        "restart", &GarbageCollectorService::restart,
+        "is_running", &GarbageCollectorService::is_running,
+        "count", &GarbageCollectorService::count,
+        "set_frame_budget", &GarbageCollectorService::set_frame_budget,
+        "get_frame_budget", &GarbageCollectorService::get_frame_budget,
+        "get_last_step_time", &GarbageCollectorService::get_last_step_time,
+        "get_allocation_stats", &GarbageCollectorService::get_allocation_stats,
+        "step_frame", &GarbageCollectorService::step_frame
+      );
+    }
+
+  private:
+    EngineState* engine_state_;
+
+    double frame_budget_ms_ = 0.0;
+    double last_step_ms_ = 0.0;
+    bool generational_ = false;
+
+    // Lua's default minor multiplier, in percent of the heap after the last collection
+    int minor_multiplier_ = 20;
+
+    // Heap size after the last minor collection seen, and at the end of the previous frame
+    size_t minor_base_ = 0;
+    size_t frame_live_ = 0;
+
+    std::chrono::steady_clock::time_point sample_start_ = std::chrono::steady_clock::now();
+    uint64_t sample_allocations_ = 0;
+    uint64_t sample_bytes_ = 0;
+    double allocations_per_second_ = 0.0;
+    double bytes_per_second_ = 0.0;
+
+    lua_State* lua() const {
+      return engine_state_->lua_state->lua_state();
+    }
+
+    // Lua starts a minor collection once the heap has grown by minor_multiplier_ percent since the last
+    // one. Collections Lua ran by itself only show up as the heap shrinking, which lowers the base.
+    bool minor_collection_due() {
+      const size_t live = engine_state_->lua_allocator->stats().live_bytes;
+      const size_t frame_growth = live > frame_live_ ? live - frame_live_ : 0;
+      frame_live_ = live;
+      minor_base_ = std::min(minor_base_, live);
+
+      if (frame_growth == 0) {
+        return false;
+      }
+
+      const size_t threshold = minor_base_ / 100 * static_cast<size_t>(minor_multiplier_);
+      return live - minor_base_ + frame_growth >= threshold;
+    }
+
+    void sample_allocation_rate() {
+      const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      const double elapsed = std::chrono::duration<double>(now - sample_start_).count();
+      if (elapsed < 0.5) {
+        return;
+      }
+
+      const LuaAllocatorStats& allocator_stats = engine_state_->lua_allocator->stats();
+      allocations_per_second_ = static_cast<double>(allocator_stats.allocations - sample_allocations_) / elapsed;
+      bytes_per_second_ = static_cast<double>(allocator_stats.allocated_bytes - sample_bytes_) / elapsed;
+
+      sample_start_ = now;
+      sample_allocations_ = allocator_stats.allocations;
+      sample_bytes_ = allocator_stats.allocated_bytes;
+    }
+  };
+
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "Umbra/services.hpp"
+#include "Umbra/engine_state.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fmt/format.h>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <unordered_map>
+
+namespace umbra {
+
+  // Samples the main lua state's call stack from a count hook and aggregates the samples into collapsed
+  // stacks ("outer;inner;leaf weight"), the input format of flamegraph.pl, speedscope and inferno. Each
+  // sample is weighted by the microseconds since the previous one, and the bytes Lua allocated in that
+  // window are attributed to the same stack.
+  //
+  // The engine brackets the entry script and every Lua callback with enter_callback and leave_callback,
+  // so rendering, vsync and idle time between them is not charged to the first stack sampled afterwards.
+  //
+  // Coroutines inherit the hook when they are created, so coroutines that already existed when profiling
+  // started are not sampled.
+  class UMBRA_API ProfilerService final : public IService {
+  public:
+
+    static constexpr int DEFAULT_INTERVAL = 1000;
+    static constexpr int MAX_DEPTH = 64;
+
+    ProfilerService(const ProfilerService&) = delete;
+    ProfilerService& operator=(const ProfilerService&) = delete;
+    ProfilerService(ProfilerService&&) = delete;
+    ProfilerService& operator=(ProfilerService&&) = delete;
+
+    explicit ProfilerService(EngineState* engine_state) : engine_state_(engine_state) {}
+
+    ~ProfilerService() override {
+      stop();
+    }
+
+    const char* name() override { return "Profiler"; }
+
+    // Samples every `interval` VM instructions
+    void start(const sol::optional<int> interval) {
+      lua_State* L = engine_state_->lua_state->lua_state();
+
+      *static_cast<ProfilerService**>(lua_getextraspace(L)) = this;
+
+      last_sample_ = std::chrono::steady_clock::now();
+      last_allocated_ = engine_state_->lua_allocator->stats().allocated_bytes;
+      stack_sampled_ = false;
+
+      lua_sethook(L, &ProfilerService::sample_hook, LUA_MASKCOUNT, std::max(1, interval.value_or(DEFAULT_INTERVAL)));
+      running_ = true;
+    }
+
+    void stop() {
+      if (!running_) {
+        return;
+      }
+
+      lua_sethook(engine_state_->lua_state->lua_state(), nullptr, 0, 0);
+      running_ = false;
+    }
+
+    // Restarts the sample window when control passes into Lua
+    void enter_callback() {
+      if (!running_) {
+        return;
+      }
+
+      last_sample_ = std::chrono::steady_clock::now();
+      last_allocated_ = engine_state_->lua_allocator->stats().allocated_bytes;
+      stack_sampled_ = false;
+    }
+
+    // Charges the time since the last sample in this callback to that sample's stack
+    void leave_callback() {
+      if (!running_ || !stack_sampled_) {
+        return;
+      }
+
+      const auto [elapsed_us, allocated_bytes] = advance();
+      record(elapsed_us, allocated_bytes);
+      stack_sampled_ = false;
+    }
+
+    bool is_running() const {
+      return running_;
+    }
+
+    void reset() {
+      time_.clear();
+      allocations_.clear();
+      sample_count_ = 0;
+    }
+
+    uint64_t get_sample_count() const {
+      return sample_count_;
+    }
+
+    // Writes time-weighted stacks to `virtual_path` and allocation-weighted stacks next to it with an
+    // ".alloc" suffix. Defaults to data://profile.folded.
+    std::string save(const sol::optional<std::string>& virtual_path) const {
+      const std::string path = virtual_path.value_or("data://profile.folded");
+
+      write(path, time_);
+      write(allocation_path(path), allocations_);
+
+      return path;
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<ProfilerService> user_type = lua_state.new_usertype<ProfilerService>(name(),
+        "start", &ProfilerService::start,
+        "stop", &ProfilerService::stop,
+        "is_running", &ProfilerService::is_running,
+        "reset", &ProfilerService::reset,
+        "get_sample_count", &ProfilerService::get_sample_count,
+        "save", &ProfilerService::save
+      );
+    }
+
+  private:
+    EngineState* engine_state_;
+
+    bool running_ = false;
+    uint64_t sample_count_ = 0;
+
+    std::chrono::steady_clock::time_point last_sample_;
+    uint64_t last_allocated_ = 0;
+
+    std::unordered_map<std::string, uint64_t> time_;
+    std::unordered_map<std::string, uint64_t> allocations_;
+
+    // Reused between samples so a steady-state sample does not allocate. Holds the last sampled stack.
+    std::string stack_;
+
+    // Whether stack_ was sampled since the last enter_callback
+    bool stack_sampled_ = false;
+
+    static void sample_hook(lua_State* L, lua_Debug*) {
+      auto* self = *static_cast<ProfilerService**>(lua_getextraspace(L));
+      if (self && self->running_) {
+        self->sample(L);
+      }
+    }
+
+    // Microseconds and bytes allocated since the previous sample, starting the next window
+    std::pair<uint64_t, uint64_t> advance() {
+      const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      const auto elapsed_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - last_sample_).count());
+      last_sample_ = now;
+
+      const uint64_t allocated = engine_state_->lua_allocator->stats().allocated_bytes;
+      const uint64_t allocated_bytes = allocated - last_allocated_;
+      last_allocated_ = allocated;
+
+      return { elapsed_us, allocated_bytes };
+    }
+
+    void record(const uint64_t elapsed_us, const uint64_t allocated_bytes) {
+      time_[stack_] += std::max<uint64_t>(1, elapsed_us);
+      if (allocated_bytes > 0) {
+        allocations_[stack_] += allocated_bytes;
+      }
+    }
+
+    void sample(lua_State* L) {
+      const auto [elapsed_us, allocated_bytes] = advance();
+
+      lua_Debug frames[MAX_DEPTH];
+      int depth = 0;
+      while (depth < MAX_DEPTH && lua_getstack(L, depth, &frames[depth])) {
+        lua_getinfo(L, "Sn", &frames[depth]);
+        ++depth;
+      }
+
+      stack_.clear();
+      for (int level = depth - 1; level >= 0; --level) {
+        append_frame(stack_, frames[level]);
+        if (level > 0) {
+          stack_.push_back(';');
+        }
+      }
+
+      if (stack_.empty()) {
+        stack_sampled_ = false;
+        return;
+      }
+
+      ++sample_count_;
+      record(elapsed_us, allocated_bytes);
+      stack_sampled_ = true;
+    }
+
+    static void append_frame(std::string& out, const lua_Debug& frame) {
+      const size_t start = out.size();
+
+      if (frame.what && std::string_view(frame.what) == "C") {
+        fmt::format_to(std::back_inserter(out), "[C] {}", frame.name ? frame.name : "?");
+      } else if (frame.what && std::string_view(frame.what) == "main") {
+        fmt::format_to(std::back_inserter(out), "{} (main)", frame.short_src);
+      } else {
+        fmt::format_to(std::back_inserter(out), "{} ({}:{})", frame.name ? frame.name : "?", frame.short_src, frame.linedefined);
+      }
+
+      // ';' separates frames in the collapsed format
+      std::replace(out.begin() + static_cast<std::ptrdiff_t>(start), out.end(), ';', ',');
+    }
+
+    static std::string allocation_path(const std::string& path) {
+      const size_t slash = path.find_last_of('/');
+      const size_t dot = path.find_last_of('.');
+
+      if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return path + ".alloc";
+      }
+
+      return path.substr(0, dot) + ".alloc" + path.substr(dot);
+    }
+
+    void write(const std::string& virtual_path, const std::unordered_map<std::string, uint64_t>& stacks) const {
+      std::string out;
+      for (const auto& [stack, weight] : stacks) {
+        out += fmt::format("{} {}\n", stack, weight);
+      }
+
+      const std::shared_ptr<VFS>& vfs = engine_state_->vfs;
+      if (!vfs->exists(virtual_path)) {
+        vfs->create(virtual_path);
+      }
+
+      vfs->write(virtual_path, std::vector<uint8_t>(out.begin(), out.end()));
+    }
+  };
+
+}
@@ -2,11 +2,14 @@
 
 #include "Umbra/services.hpp"
 #include "Umbra/engine_state.hpp"
+#include "Umbra/services/garbage_collector.hpp"
 #include "Umbra/types/data/file.hpp"
 #include "Umbra/types/data/vector2.hpp"
 
+#include <chrono>
 #include <glfw/glfw3.h>
 #include <imgui.h>
+#include <limits>
 #include <thread>
 #include <OgreRenderSystem.h>
 #include <OgreRenderWindow.h>
@@ -251,12 +254,39 @@ namespace umbra {
       return glfwWindowShouldClose(window_);
     }
 
+    bool is_iconified() const {
+      return glfwGetWindowAttrib(window_, GLFW_ICONIFIED) != 0;
+    }
+
+    bool is_focused() const {
+      return glfwGetWindowAttrib(window_, GLFW_FOCUSED) != 0;
+    }
+
+    // Sleeps until an event arrives or the timeout passes, instead of spinning while idle
+    void wait_events(const double timeout_seconds) const {
+      if (timeout_seconds > 0.0) {
+        glfwWaitEventsTimeout(timeout_seconds);
+      } else {
+        glfwPollEvents();
+      }
+    }
+
     void begin_render() const {
+      frame_start_ = std::chrono::steady_clock::now();
       glfwPollEvents();
     }
 
     void end_render() const {
       engine_state_->ogre_root->renderOneFrame();
+
+      // Hand whatever is left of the frame to the collector so its work lands in slack time instead of mid-update
+      const double target_fps = engine_state_->config.target_fps;
+      const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frame_start_).count();
+      const double available_ms = target_fps > 0.0 ? 1000.0 / target_fps - elapsed_ms : std::numeric_limits<double>::infinity();
+
+      if (const auto garbage_collector = engine_state_->service_registry->fetch_service<GarbageCollectorService>("GarbageCollector")) {
+        garbage_collector->step_frame(available_ms);
+      }
     }
 
     Vector2 get_content_scale() const {
@@ -336,6 +366,8 @@ namespace umbra {
         "set_fullscreen", &RendererService::set_fullscreen,
         "is_fullscreen", &RendererService::is_fullscreen,
         "should_close", &RendererService::should_close,
+        "is_iconified", &RendererService::is_iconified,
+        "is_focused", &RendererService::is_focused,
         "begin_render", &RendererService::begin_render,
         "end_render", &RendererService::end_render,
         "get_content_scale", &RendererService::get_content_scale,
@@ -363,6 +395,8 @@ namespace umbra {
 
     bool fullscreen_ = false;
 
+    mutable std::chrono::steady_clock::time_point frame_start_ = std::chrono::steady_clock::now();
+
     static void framebuffer_resize_callback(GLFWwindow* window, const int framebuffer_width, const int framebuffer_height) {
       auto* self = static_cast<RendererService*>(glfwGetWindowUserPointer(window));
       if (!self) {
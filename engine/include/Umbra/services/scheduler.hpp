@@ -0,0 +1,321 @@
+#pragma once
+
+#include "Umbra/services.hpp"
+#include "Umbra/engine_state.hpp"
+#include "Umbra/timer_wheel.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace umbra {
+
+  // Runs Lua functions as coroutines that sleep on timer wheels instead of polling. Time is kept in milliseconds,
+  // frames are counted by tick(), which the main loop calls at the start of every frame.
+  class UMBRA_API SchedulerService final : public IService {
+  public:
+
+    SchedulerService(const SchedulerService&) = delete;
+    SchedulerService& operator=(const SchedulerService&) = delete;
+    SchedulerService(SchedulerService&&) = delete;
+    SchedulerService& operator=(SchedulerService&&) = delete;
+
+    explicit SchedulerService(EngineState* engine_state) : engine_state_(engine_state), epoch_(std::chrono::steady_clock::now()) {}
+    ~SchedulerService() override = default;
+
+    const char* name() override { return "Scheduler"; }
+
+    // Starts fn(...) as a task and runs it until it first waits. Returns the task's handle.
+    uint64_t spawn(const sol::protected_function&, const sol::variadic_args& args, const sol::this_state this_state) {
+      const uint64_t handle = next_handle_++;
+
+      sol::thread thread = sol::thread::create(engine_state_->lua_state->lua_state());
+      lua_State* co = thread.thread_state();
+
+      Task& task = tasks_.emplace(handle, Task{ std::move(thread), co }).first->second;
+      coroutines_.emplace(co, handle);
+
+      // The caller's stack is (self, fn, ...); copy fn and its arguments straight across
+      lua_State* L = this_state;
+      const int top = lua_gettop(L);
+      for (int i = 2; i <= top; ++i) {
+        lua_pushvalue(L, i);
+      }
+      lua_xmove(L, co, top - 1);
+
+      resume(handle, task, static_cast<int>(args.size()), L);
+      return handle;
+    }
+
+    // Stops a task; it will never be resumed again. Returns false if the task already finished.
+    bool cancel(const uint64_t handle) {
+      const auto it = tasks_.find(handle);
+      if (it == tasks_.end()) {
+        return false;
+      }
+
+      if (it->second.running) {
+        it->second.cancelled = true;
+        return true;
+      }
+
+      finish(it);
+      return true;
+    }
+
+    std::string status(const uint64_t handle) const {
+      const auto it = tasks_.find(handle);
+      if (it == tasks_.end()) {
+        return errors_.contains(handle) ? "error" : "dead";
+      }
+
+      return it->second.running ? "running" : "waiting";
+    }
+
+    // Traceback of a task that failed, or nil. Reading it forgets the failure, after which the task is
+    // reported as dead.
+    std::optional<std::string> get_error(const uint64_t handle) {
+      const auto it = errors_.find(handle);
+      if (it == errors_.end()) {
+        return std::nullopt;
+      }
+
+      std::string message = std::move(it->second);
+      errors_.erase(it);
+      return message;
+    }
+
+    size_t count() const {
+      return tasks_.size();
+    }
+
+    uint64_t get_frame() const {
+      return frames_.now();
+    }
+
+    double get_time() const {
+      return static_cast<double>(milliseconds_.now()) / 1000.0;
+    }
+
+    // Advances both wheels and resumes every task that became due
+    void tick() {
+      frames_.advance(frames_.now() + 1, [this](const Wake& wake) { ready_.push_back(wake); });
+      milliseconds_.advance(elapsed_ms(), [this](const Wake& wake) { ready_.push_back(wake); });
+
+      lua_State* main_state = engine_state_->lua_state->lua_state();
+
+      // Tasks woken by other tasks finishing are appended while draining, so index instead of iterating
+      for (size_t i = 0; i < ready_.size(); ++i) {
+        const Wake wake = ready_[i];
+
+        const auto it = tasks_.find(wake.handle);
+        if (it == tasks_.end() || it->second.token != wake.token || it->second.running) {
+          continue;
+        }
+
+        resume(wake.handle, it->second, 0, main_state);
+      }
+
+      ready_.clear();
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<SchedulerService> user_type = lua_state.new_usertype<SchedulerService>(name(),
+        "spawn", &SchedulerService::spawn,
+        "cancel", &SchedulerService::cancel,
+        "status", &SchedulerService::status,
+        "get_error", &SchedulerService::get_error,
+        "count", &SchedulerService::count,
+        "get_frame", &SchedulerService::get_frame,
+        "get_time", &SchedulerService::get_time,
+        "wait", &SchedulerService::raw_wait,
+        "wait_frames", &SchedulerService::raw_wait_frames,
+        "wait_for", &SchedulerService::raw_wait_for
+      );
+    }
+
+  private:
+    struct Task {
+      sol::thread thread;
+      lua_State* co = nullptr;
+
+      // Bumped on every wait so wheel entries left behind by an earlier wait are ignored
+      uint64_t token = 0;
+
+      bool running = false;
+      bool waiting = false;
+      bool cancelled = false;
+
+      std::vector<uint64_t> waiters;
+    };
+
+    struct Wake {
+      uint64_t handle;
+      uint64_t token;
+    };
+
+    EngineState* engine_state_;
+
+    std::unordered_map<uint64_t, Task> tasks_;
+    std::unordered_map<lua_State*, uint64_t> coroutines_;
+
+    TimerWheel<Wake> milliseconds_;
+    TimerWheel<Wake> frames_;
+    std::vector<Wake> ready_;
+
+    // Tracebacks of failed tasks that Lua has not read yet
+    std::unordered_map<uint64_t, std::string> errors_;
+
+    std::chrono::steady_clock::time_point epoch_;
+    uint64_t next_handle_ = 1;
+
+    uint64_t elapsed_ms() const {
+      return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - epoch_).count());
+    }
+
+    void resume(const uint64_t handle, Task& task, const int argument_count, lua_State* from) {
+      task.running = true;
+      task.waiting = false;
+
+      int result_count = 0;
+      const int status = lua_resume(task.co, from, argument_count, &result_count);
+
+      // resume can spawn tasks, which may rehash the map, so look the task up again
+      const auto it = tasks_.find(handle);
+      Task& resumed = it->second;
+      resumed.running = false;
+
+      if (status == LUA_YIELD && !resumed.cancelled) {
+        lua_pop(resumed.co, result_count);
+
+        // A bare coroutine.yield() inside a task sleeps until the next frame
+        if (!resumed.waiting) {
+          frames_.schedule(frames_.now() + 1, Wake{ handle, ++resumed.token });
+          resumed.waiting = true;
+        }
+
+        return;
+      }
+
+      if (status != LUA_OK && status != LUA_YIELD) {
+        const char* message = lua_tostring(resumed.co, -1);
+        luaL_traceback(from, resumed.co, message ? message : "(error object is not a string)", 0);
+        const std::string traceback = lua_tostring(from, -1);
+        lua_pop(from, 1);
+
+        std::cerr << "Scheduler: task " << handle << " failed: " << traceback << '\n';
+        errors_[handle] = traceback;
+      }
+
+      finish(it);
+    }
+
+    void finish(const std::unordered_map<uint64_t, Task>::iterator it) {
+      for (const uint64_t waiter : it->second.waiters) {
+        if (const auto waiting = tasks_.find(waiter); waiting != tasks_.end()) {
+          ready_.push_back(Wake{ waiter, ++waiting->second.token });
+        }
+      }
+
+      lua_settop(it->second.co, 0);
+      coroutines_.erase(it->second.co);
+      tasks_.erase(it);
+    }
+
+    // The wait functions are raw C functions because they have to yield the calling coroutine, and wait_for only
+    // yields when the target is still alive. Errors are raised with luaL_error since nothing here may throw.
+    static Task* calling_task(lua_State* L, SchedulerService& self, uint64_t& handle) {
+      const auto it = self.coroutines_.find(L);
+      if (it == self.coroutines_.end()) {
+        return nullptr;
+      }
+
+      handle = it->second;
+      return &self.tasks_.at(handle);
+    }
+
+    static SchedulerService* self_from_stack(lua_State* L) {
+      const sol::optional<SchedulerService*> self = sol::stack::check_get<SchedulerService*>(L, 1);
+      return self ? *self : nullptr;
+    }
+
+    static int raw_wait(lua_State* L) {
+      SchedulerService* self = self_from_stack(L);
+      if (!self) {
+        return luaL_error(L, "Scheduler: wait must be called as scheduler:wait(seconds)");
+      }
+
+      uint64_t handle = 0;
+      Task* task = calling_task(L, *self, handle);
+      if (!task) {
+        return luaL_error(L, "Scheduler: wait must be called from inside a scheduler task");
+      }
+
+      const double seconds = luaL_optnumber(L, 2, 0.0);
+
+      if (seconds <= 0.0 || !std::isfinite(seconds)) {
+        self->frames_.schedule(self->frames_.now() + 1, Wake{ handle, ++task->token });
+      } else {
+        const auto delay = static_cast<uint64_t>(std::ceil(seconds * 1000.0));
+        self->milliseconds_.schedule(self->milliseconds_.now() + delay, Wake{ handle, ++task->token });
+      }
+
+      task->waiting = true;
+      return lua_yield(L, 0);
+    }
+
+    static int raw_wait_frames(lua_State* L) {
+      SchedulerService* self = self_from_stack(L);
+      if (!self) {
+        return luaL_error(L, "Scheduler: wait_frames must be called as scheduler:wait_frames(count)");
+      }
+
+      uint64_t handle = 0;
+      Task* task = calling_task(L, *self, handle);
+      if (!task) {
+        return luaL_error(L, "Scheduler: wait_frames must be called from inside a scheduler task");
+      }
+
+      const lua_Integer frames = luaL_optinteger(L, 2, 1);
+
+      self->frames_.schedule(self->frames_.now() + static_cast<uint64_t>(std::max<lua_Integer>(1, frames)), Wake{ handle, ++task->token });
+
+      task->waiting = true;
+      return lua_yield(L, 0);
+    }
+
+    static int raw_wait_for(lua_State* L) {
+      SchedulerService* self = self_from_stack(L);
+      if (!self) {
+        return luaL_error(L, "Scheduler: wait_for must be called as scheduler:wait_for(handle)");
+      }
+
+      uint64_t handle = 0;
+      Task* task = calling_task(L, *self, handle);
+      if (!task) {
+        return luaL_error(L, "Scheduler: wait_for must be called from inside a scheduler task");
+      }
+
+      const auto target = static_cast<uint64_t>(luaL_checkinteger(L, 2));
+      if (target == handle) {
+        return luaL_error(L, "Scheduler: a task cannot wait for itself");
+      }
+
+      const auto it = self->tasks_.find(target);
+      if (it == self->tasks_.end()) {
+        return 0;
+      }
+
+      it->second.waiters.push_back(handle);
+      ++task->token;
+
+      task->waiting = true;
+      return lua_yield(L, 0);
+    }
+  };
+
+}
@@ -24,9 +24,7 @@ namespace umbra {
     }
 
     File read(const std::string_view virtual_path) const {
-      auto file = File(engine_state_->vfs->read(virtual_path));
-
-      return std::move(file);
+      return File(engine_state_->vfs->read(virtual_path));
     }
 
     std::vector<std::string> list(const std::string_view virtual_path) const {
@@ -49,6 +47,14 @@ namespace umbra {
       engine_state_->vfs->execute(virtual_path);
     }
 
+    void invalidate(const sol::optional<std::string_view> virtual_path) const {
+      if (virtual_path) {
+        engine_state_->vfs->invalidate(*virtual_path);
+      } else {
+        engine_state_->vfs->invalidate_all();
+      }
+    }
+
     void bind(sol::state& lua_state) {
       sol::usertype<VirtualFileSystemService> user_type = lua_state.new_usertype<VirtualFileSystemService>(name(),
         "exists", &VirtualFileSystemService::exists,
@@ -57,7 +63,8 @@ namespace umbra {
         "create", &VirtualFileSystemService::create,
         "remove", &VirtualFileSystemService::remove,
         "write", &VirtualFileSystemService::write,
-        "execute", &VirtualFileSystemService::execute
+        "execute", &VirtualFileSystemService::execute,
+        "invalidate", &VirtualFileSystemService::invalidate
       );
     }
 
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Umbra/services.hpp"
+#include "Umbra/engine_state.hpp"
+#include "Umbra/worker.hpp"
+
+#include <algorithm>
+#include <fmt/format.h>
+#include <thread>
+
+namespace umbra {
+
+  class UMBRA_API WorkerService final : public IService {
+  public:
+
+    WorkerService(const WorkerService&) = delete;
+    WorkerService& operator=(const WorkerService&) = delete;
+    WorkerService(WorkerService&&) = delete;
+    WorkerService& operator=(WorkerService&&) = delete;
+
+    explicit WorkerService(EngineState* engine_state) : engine_state_(engine_state) {
+      limit_ = engine_state_->config.max_workers;
+      if (limit_ == 0) {
+        // hardware_concurrency may report 0 when unknown, which must not wrap around to no limit
+        const unsigned hardware = std::thread::hardware_concurrency();
+        limit_ = hardware > 1 ? hardware - 1 : 1;
+      }
+    }
+
+    ~WorkerService() override {
+      for (const std::shared_ptr<Worker>& worker : workers_) {
+        worker->terminate();
+      }
+
+      for (const std::shared_ptr<Worker>& worker : workers_) {
+        worker->join();
+      }
+    }
+
+    const char* name() override { return "Workers"; }
+
+    // Starts the script at virtual_path in a new worker; extra arguments are copied into it as `...`
+    std::shared_ptr<Worker> spawn(const std::string& virtual_path, const sol::variadic_args& args, const sol::this_state this_state) {
+      prune();
+
+      if (workers_.size() >= limit_) {
+        umbra_fail(fmt::format("Workers: limit of {} running workers reached", limit_));
+      }
+
+      if (!engine_state_->vfs->exists(virtual_path)) {
+        umbra_fail(fmt::format("Workers: script not found: {}", virtual_path));
+      }
+
+      WorkerMessage arguments = Worker::pack(this_state, args.stack_index(), static_cast<int>(args.size()));
+
+      auto worker = std::make_shared<Worker>(*engine_state_->vfs, virtual_path, std::move(arguments));
+      workers_.push_back(worker);
+
+      return worker;
+    }
+
+    size_t count() {
+      prune();
+      return workers_.size();
+    }
+
+    size_t get_limit() const {
+      return limit_;
+    }
+
+    void bind(sol::state& lua_state) {
+      lua_state.new_usertype<Worker>("Worker", sol::no_constructor,
+        "send", &Worker::send,
+        "receive", &Worker::receive,
+        "pending", &Worker::pending,
+        "is_running", &Worker::is_running,
+        "get_error", &Worker::get_error,
+        "terminate", &Worker::terminate,
+        "join", &Worker::join,
+        "get_path", &Worker::path
+      );
+
+      sol::usertype<WorkerService> user_type = lua_state.new_usertype<WorkerService>(name(),
+        "spawn", &WorkerService::spawn,
+        "count", &WorkerService::count,
+        "get_limit", &WorkerService::get_limit
+      );
+    }
+
+  private:
+    EngineState* engine_state_;
+
+    std::vector<std::shared_ptr<Worker>> workers_;
+    size_t limit_ = 0;
+
+    // Finished workers stay reachable from Lua through their handles, but no longer count against the limit
+    void prune() {
+      std::erase_if(workers_, [](const std::shared_ptr<Worker>& worker) {
+        return !worker->is_running();
+      });
+    }
+  };
+
+}
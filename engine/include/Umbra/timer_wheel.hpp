@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace umbra {
+
+  // Hierarchical timing wheel. Each level has 2^LevelBits slots covering 2^(LevelBits * (level + 1)) ticks, so
+  // scheduling is O(1) and an advance only touches the slot that comes due plus the occasional cascade of a higher
+  // level slot into the levels below it. Sleeping entries cost nothing until their slot is reached.
+  template<class T, size_t LevelBits = 8, size_t Levels = 4>
+  class TimerWheel final {
+  public:
+
+    static constexpr size_t SLOTS = size_t{ 1 } << LevelBits;
+    static constexpr uint64_t MASK = SLOTS - 1;
+    static constexpr uint64_t RANGE = uint64_t{ 1 } << (LevelBits * Levels);
+
+    explicit TimerWheel(const uint64_t now = 0) : now_(now) {}
+
+    uint64_t now() const { return now_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Deadlines at or before the current tick fire on the next advance
+    void schedule(const uint64_t deadline, T value) {
+      place(Entry{ deadline > now_ ? deadline : now_ + 1, std::move(value) });
+      ++size_;
+    }
+
+    void clear() {
+      for (auto& level : levels_) {
+        for (auto& slot : level) {
+          slot.clear();
+        }
+      }
+
+      size_ = 0;
+    }
+
+    // Moves the wheel forward to `to`, calling fire(value) for every entry whose deadline has been reached
+    template<class F>
+    void advance(const uint64_t to, F&& fire) {
+      while (now_ < to) {
+        if (size_ == 0) {
+          now_ = to;
+          return;
+        }
+
+        ++now_;
+
+        size_t top = 0;
+        while (top + 1 < Levels && (now_ & ((uint64_t{ 1 } << (LevelBits * (top + 1))) - 1)) == 0) {
+          ++top;
+        }
+
+        for (size_t level = top; level > 0; --level) {
+          std::vector<Entry> cascading = std::move(levels_[level][(now_ >> (LevelBits * level)) & MASK]);
+          for (Entry& entry : cascading) {
+            place(std::move(entry));
+          }
+        }
+
+        std::vector<Entry> due = std::move(levels_[0][now_ & MASK]);
+        for (Entry& entry : due) {
+          if (entry.deadline > now_) {
+            place(std::move(entry));
+            continue;
+          }
+
+          --size_;
+          fire(std::move(entry.value));
+        }
+      }
+    }
+
+  private:
+    struct Entry {
+      uint64_t deadline;
+      T value;
+    };
+
+    std::array<std::array<std::vector<Entry>, SLOTS>, Levels> levels_;
+
+    uint64_t now_ = 0;
+    size_t size_ = 0;
+
+    void place(Entry entry) {
+      const uint64_t delta = entry.deadline - now_;
+
+      for (size_t level = 0; level < Levels; ++level) {
+        if (delta < (uint64_t{ 1 } << (LevelBits * (level + 1)))) {
+          levels_[level][(entry.deadline >> (LevelBits * level)) & MASK].push_back(std::move(entry));
+          return;
+        }
+      }
+
+      // Beyond the wheel's range: park in the top slot visited last and re-place when it cascades
+      constexpr size_t top = Levels - 1;
+      levels_[top][((now_ >> (LevelBits * top)) - 1) & MASK].push_back(std::move(entry));
+    }
+  };
+
+}
@@ -2,12 +2,20 @@
 
 #include "Umbra/umbra.hpp"
 
+#include <concepts>
 #include <memory>
 #include <unordered_set>
 #include <sol/sol.hpp>
 
 namespace umbra {
 
+  // Component type of the math value types. Builds with UMBRA_REAL_FLOAT store float to match Ogre::Real.
+#ifdef UMBRA_REAL_FLOAT
+  using real_t = float;
+#else
+  using real_t = double;
+#endif
+
   struct IType {
 
     virtual ~IType() = default;
@@ -15,7 +23,17 @@ namespace umbra {
 
   };
 
+  // Registration metadata for types that cannot carry an IType vtable, such as plain value types that
+  // must stay trivially copyable. Specializations provide `static constexpr const char* name`.
+  template<class T>
+  struct type_traits;
+
   namespace types_concepts {
+    template<class T>
+    concept has_type_traits = requires {
+      { type_traits<T>::name } -> std::convertible_to<const char*>;
+    };
+
     template<class T>
      concept has_static_bind_name = requires(sol::state& lua_state, const char* name) {
         { T::bind(lua_state, name) } -> std::same_as<void>;
@@ -48,8 +66,33 @@ namespace umbra {
 
     template<class T, class... Args>
     bool register_type(Args&&... args) {
-      static_assert(std::is_base_of_v<IType, T>, "Registered types must inherit from IType");
+      static_assert(std::is_base_of_v<IType, T> || types_concepts::has_type_traits<T>, "Registered types must inherit from IType or specialize umbra::type_traits");
+
+      if constexpr (types_concepts::has_type_traits<T>) {
+        static_assert(types_concepts::has_static_bind_name<T> || types_concepts::has_static_bind<T>,
+          "Types registered through type_traits are never instantiated and must provide a static bind"
+        );
+
+        const std::string type_name = type_traits<T>::name;
+        if (!mark_once(type_name)) {
+          return false;
+        }
+
+        if constexpr (types_concepts::has_static_bind_name<T>) {
+          T::bind(*lua_state_, type_name.c_str());
+        } else {
+          T::bind(*lua_state_);
+        }
 
+        return true;
+      } else {
+        return register_instance<T>(std::forward<Args>(args)...);
+      }
+    }
+
+  private:
+    template<class T, class... Args>
+    bool register_instance(Args&&... args) {
       T instance(std::forward<Args>(args)...);
       const char* raw_name = instance.name();
       const std::string type_name = (raw_name && *raw_name) ? raw_name : typeid(T).name();
@@ -78,7 +121,6 @@ namespace umbra {
       return true;
     }
 
-  private:
     bool mark_once(const std::string_view name) {
       auto [it, inserted] = registered_types_.insert(std::string(name));
       if (!inserted) {
@@ -100,4 +142,7 @@ namespace umbra {
 
   };
 
+  // Registers every engine type. The main state and each worker state share this list.
+  UMBRA_API void register_builtin_types(TypeRegistry& type_registry);
+
 }
\ No newline at end of file
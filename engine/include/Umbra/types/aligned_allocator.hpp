@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace umbra {
+
+  // std::allocator replacement that aligns every block to Alignment bytes, so bulk kernels can start on a
+  // cache line and the compiler can use aligned vector loads
+  template<class T, size_t Alignment = 64>
+  struct AlignedAllocator {
+    using value_type = T;
+
+    template<class U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+
+    template<class U>
+    explicit AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(const size_t count) {
+      return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+    }
+
+    void deallocate(T* pointer, size_t) noexcept {
+      ::operator delete(pointer, std::align_val_t{ Alignment });
+    }
+
+    template<class U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+  };
+
+}
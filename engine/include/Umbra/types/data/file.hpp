@@ -1,6 +1,18 @@
 #pragma once
 
 #include "Umbra/types.hpp"
+#include "Umbra/types/ordered/typed_array.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <sol/sol.hpp>
 
 namespace umbra {
 
@@ -9,7 +21,13 @@ namespace umbra {
 
     const char* name() override { return "File"; }
 
+    // Limits of string.pack formats: integers take up to 16 bytes, and '!' alone aligns to the strictest
+    // of the types Lua reads natively rather than to max_align_t
+    static constexpr size_t MAX_INTEGER_SIZE = 16;
+    static constexpr size_t NATIVE_ALIGN = std::max({ alignof(lua_Number), alignof(double), alignof(void*), alignof(lua_Integer), alignof(long) });
+
     explicit File(const std::vector<uint8_t>& data) noexcept : data(data) {}
+    explicit File(std::vector<uint8_t>&& data) noexcept : data(std::move(data)) {}
     File() noexcept {}
 
     size_t size() const noexcept {
@@ -20,12 +38,347 @@ namespace umbra {
       return std::string(data.begin(), data.end());
     }
 
+    // Offsets are 1-based byte positions, matching string.unpack. Reads past the end return nil.
+    std::optional<uint8_t> read_u8(const int64_t offset) const noexcept { return read_scalar<uint8_t>(offset, false); }
+    std::optional<int8_t> read_i8(const int64_t offset) const noexcept { return read_scalar<int8_t>(offset, false); }
+    std::optional<uint16_t> read_u16(const int64_t offset, const sol::optional<bool> big_endian) const noexcept { return read_scalar<uint16_t>(offset, big_endian.value_or(false)); }
+    std::optional<int16_t> read_i16(const int64_t offset, const sol::optional<bool> big_endian) const noexcept { return read_scalar<int16_t>(offset, big_endian.value_or(false)); }
+    std::optional<uint32_t> read_u32(const int64_t offset, const sol::optional<bool> big_endian) const noexcept { return read_scalar<uint32_t>(offset, big_endian.value_or(false)); }
+    std::optional<int32_t> read_i32(const int64_t offset, const sol::optional<bool> big_endian) const noexcept { return read_scalar<int32_t>(offset, big_endian.value_or(false)); }
+    std::optional<int64_t> read_i64(const int64_t offset, const sol::optional<bool> big_endian) const noexcept { return read_scalar<int64_t>(offset, big_endian.value_or(false)); }
+    std::optional<float> read_f32(const int64_t offset, const sol::optional<bool> big_endian) const noexcept { return read_scalar<float>(offset, big_endian.value_or(false)); }
+    std::optional<double> read_f64(const int64_t offset, const sol::optional<bool> big_endian) const noexcept { return read_scalar<double>(offset, big_endian.value_or(false)); }
+
+    std::optional<std::string> read_string(const int64_t offset, const int64_t length) const {
+      if (!in_bounds(offset, length)) {
+        return std::nullopt;
+      }
+
+      const auto begin = data.begin() + (offset - 1);
+      return std::string(begin, begin + length);
+    }
+
+    // Decodes `count` consecutive values of `type` ("u8", "i8", "u16", "i16", "u32", "i32", "i64", "f32", "f64")
+    // into an owned typed array in one call: u8 into a UInt8Array, i8, u16, i16 and i32 into an Int32Array,
+    // f32 into a Float32Array, and u32 and f64 into a Float64Array. No typed array holds every i64 exactly,
+    // so i64 still decodes into a sequential table of integers.
+    sol::object read_array(const std::string_view type, const int64_t offset, const int64_t count, const sol::optional<bool> big_endian, const sol::this_state this_state) const {
+      const bool big = big_endian.value_or(false);
+
+      if (type == "u8") return decode_array<uint8_t, UInt8Array>(offset, count, big, this_state);
+      if (type == "i8") return decode_array<int8_t, Int32Array>(offset, count, big, this_state);
+      if (type == "u16") return decode_array<uint16_t, Int32Array>(offset, count, big, this_state);
+      if (type == "i16") return decode_array<int16_t, Int32Array>(offset, count, big, this_state);
+      if (type == "u32") return decode_array<uint32_t, Float64Array>(offset, count, big, this_state);
+      if (type == "i32") return decode_array<int32_t, Int32Array>(offset, count, big, this_state);
+      if (type == "i64") return decode_table<int64_t>(offset, count, big, this_state);
+      if (type == "f32") return decode_array<float, Float32Array>(offset, count, big, this_state);
+      if (type == "f64") return decode_array<double, Float64Array>(offset, count, big, this_state);
+
+      umbra_fail("File: unknown array element type '" + std::string(type) + "'");
+    }
+
+    // Native counterpart of string.unpack that reads straight from the file buffer.
+    // Supports the options < > = ! b B h H i[n] I[n] l L j J T f d n s[n] z x X and spaces.
+    sol::variadic_results unpack(const std::string_view format, const sol::optional<int64_t> offset, const sol::this_state this_state) const {
+      sol::variadic_results results;
+
+      int64_t position = offset.value_or(1);
+      if (position < 1 || static_cast<uint64_t>(position - 1) > data.size()) {
+        umbra_fail("File: unpack initial position out of range");
+      }
+
+      size_t cursor = static_cast<size_t>(position - 1);
+      bool big_endian = std::endian::native == std::endian::big;
+      size_t max_align = 1;
+
+      for (size_t i = 0; i < format.size();) {
+        const char option = format[i++];
+
+        size_t size = 0;
+        bool is_signed = false;
+        enum class Kind { INTEGER, FLOAT, DOUBLE, SIZED_STRING, ZERO_STRING, PADDING, ALIGN, NONE } kind = Kind::NONE;
+
+        switch (option) {
+          case ' ': continue;
+          case '<': big_endian = false; continue;
+          case '>': big_endian = true; continue;
+          case '=': big_endian = std::endian::native == std::endian::big; continue;
+          case '!': max_align = read_format_size(format, i, NATIVE_ALIGN); continue;
+          case 'b': kind = Kind::INTEGER; size = sizeof(char); is_signed = true; break;
+          case 'B': kind = Kind::INTEGER; size = sizeof(char); break;
+          case 'h': kind = Kind::INTEGER; size = sizeof(short); is_signed = true; break;
+          case 'H': kind = Kind::INTEGER; size = sizeof(short); break;
+          case 'i': kind = Kind::INTEGER; size = read_format_size(format, i, sizeof(int)); is_signed = true; break;
+          case 'I': kind = Kind::INTEGER; size = read_format_size(format, i, sizeof(int)); break;
+          case 'l': kind = Kind::INTEGER; size = sizeof(long); is_signed = true; break;
+          case 'L': kind = Kind::INTEGER; size = sizeof(long); break;
+          case 'j': kind = Kind::INTEGER; size = sizeof(lua_Integer); is_signed = true; break;
+          case 'J': kind = Kind::INTEGER; size = sizeof(lua_Integer); break;
+          case 'T': kind = Kind::INTEGER; size = sizeof(size_t); break;
+          case 'f': kind = Kind::FLOAT; size = sizeof(float); break;
+          case 'd': kind = Kind::DOUBLE; size = sizeof(double); break;
+          case 'n': kind = Kind::DOUBLE; size = sizeof(lua_Number); break;
+          case 's': kind = Kind::SIZED_STRING; size = read_format_size(format, i, sizeof(size_t)); break;
+          case 'z': kind = Kind::ZERO_STRING; break;
+          case 'x': kind = Kind::PADDING; size = 1; break;
+          case 'X': kind = Kind::ALIGN; break;
+          default: umbra_fail("File: invalid unpack format option '" + std::string(1, option) + "'");
+        }
+
+        if (kind == Kind::ALIGN) {
+          if (i >= format.size()) {
+            umbra_fail("File: invalid next option for option 'X'");
+          }
+
+          const char next = format[i++];
+          size_t align = 0;
+          switch (next) {
+            case 'b': case 'B': align = sizeof(char); break;
+            case 'h': case 'H': align = sizeof(short); break;
+            case 'i': case 'I': align = read_format_size(format, i, sizeof(int)); break;
+            case 'l': case 'L': align = sizeof(long); break;
+            case 'j': case 'J': align = sizeof(lua_Integer); break;
+            case 'T': align = sizeof(size_t); break;
+            case 'f': align = sizeof(float); break;
+            case 'd': align = sizeof(double); break;
+            case 'n': align = sizeof(lua_Number); break;
+            default: umbra_fail("File: invalid next option for option 'X'");
+          }
+
+          cursor = align_cursor(cursor, std::min(align, max_align));
+          continue;
+        }
+
+        if (kind == Kind::INTEGER || kind == Kind::FLOAT || kind == Kind::DOUBLE) {
+          cursor = align_cursor(cursor, std::min(size, max_align));
+        }
+
+        if (kind == Kind::ZERO_STRING) {
+          const auto begin = data.begin() + static_cast<std::ptrdiff_t>(cursor);
+          const auto end = std::find(begin, data.end(), uint8_t{ 0 });
+          if (end == data.end()) {
+            umbra_fail("File: unfinished string for format 'z'");
+          }
+
+          results.push_back(make_object(this_state, std::string(begin, end)));
+          cursor += static_cast<size_t>(end - begin) + 1;
+          continue;
+        }
+
+        if (size > data.size() || cursor > data.size() - size) {
+          umbra_fail("File: data too short for unpack");
+        }
+
+        const uint8_t* source = data.data() + cursor;
+        cursor += size;
+
+        switch (kind) {
+          case Kind::INTEGER:
+            results.push_back(make_object(this_state, load_integer(source, size, is_signed, big_endian)));
+            break;
+          case Kind::FLOAT:
+            results.push_back(make_object(this_state, static_cast<lua_Number>(load<float>(source, big_endian))));
+            break;
+          case Kind::DOUBLE:
+            results.push_back(make_object(this_state, static_cast<lua_Number>(load<double>(source, big_endian))));
+            break;
+          case Kind::SIZED_STRING: {
+            const auto length = static_cast<uint64_t>(load_integer(source, size, false, big_endian));
+            if (length > data.size() - cursor) {
+              umbra_fail("File: data too short for unpack");
+            }
+
+            const auto begin = data.begin() + static_cast<std::ptrdiff_t>(cursor);
+            results.push_back(make_object(this_state, std::string(begin, begin + static_cast<std::ptrdiff_t>(length))));
+            cursor += length;
+            break;
+          }
+          default:
+            break;
+        }
+      }
+
+      results.push_back(make_object(this_state, static_cast<int64_t>(cursor + 1)));
+      return results;
+    }
+
     void bind(sol::state& lua_state) {
       sol::usertype<File> user_type = lua_state.new_usertype<File>(name(),
         "size", &File::size,
-        "as_string", &File::as_string
+        "as_string", &File::as_string,
+        "read_u8", &File::read_u8,
+        "read_i8", &File::read_i8,
+        "read_u16", &File::read_u16,
+        "read_i16", &File::read_i16,
+        "read_u32", &File::read_u32,
+        "read_i32", &File::read_i32,
+        "read_i64", &File::read_i64,
+        "read_f32", &File::read_f32,
+        "read_f64", &File::read_f64,
+        "read_string", &File::read_string,
+        "read_array", &File::read_array,
+        "unpack", &File::unpack
       );
+
+      user_type[sol::meta_function::length] = [](const File& file) { return file.size(); };
+    }
+
+  private:
+    bool in_bounds(const int64_t offset, const int64_t length) const noexcept {
+      return offset >= 1 && length >= 0 && static_cast<uint64_t>(offset - 1) <= data.size() && static_cast<uint64_t>(length) <= data.size() - static_cast<uint64_t>(offset - 1);
+    }
+
+    template<class T>
+    static T load(const uint8_t* source, const bool big_endian) noexcept {
+      using Bits = std::conditional_t<sizeof(T) == 1, uint8_t,
+                   std::conditional_t<sizeof(T) == 2, uint16_t,
+                   std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+      Bits bits;
+      std::memcpy(&bits, source, sizeof(Bits));
+
+      if constexpr (sizeof(T) > 1) {
+        if (big_endian != (std::endian::native == std::endian::big)) {
+          bits = std::byteswap(bits);
+        }
+      }
+
+      return std::bit_cast<T>(bits);
+    }
+
+    // Sizes above 8 bytes are accepted like string.unpack does, as long as the extra high bytes only
+    // extend the sign of the low 8
+    static int64_t load_integer(const uint8_t* source, const size_t size, const bool is_signed, const bool big_endian) {
+      const size_t low = std::min(size, sizeof(uint64_t));
+      const auto byte_at = [&](const size_t significance) { return big_endian ? source[size - 1 - significance] : source[significance]; };
+
+      uint64_t value = 0;
+      for (size_t i = low; i-- > 0;) {
+        value = (value << 8) | byte_at(i);
+      }
+
+      if (is_signed && size < sizeof(uint64_t)) {
+        const uint64_t sign_bit = uint64_t{ 1 } << (size * 8 - 1);
+        value = (value ^ sign_bit) - sign_bit;
+      }
+
+      const uint8_t extension = is_signed && static_cast<int64_t>(value) < 0 ? 0xff : 0x00;
+      for (size_t i = low; i < size; ++i) {
+        if (byte_at(i) != extension) {
+          umbra_fail("File: " + std::to_string(size) + "-byte integer does not fit into Lua Integer");
+        }
+      }
+
+      return static_cast<int64_t>(value);
+    }
+
+    template<class T>
+    std::optional<T> read_scalar(const int64_t offset, const bool big_endian) const noexcept {
+      if (!in_bounds(offset, sizeof(T))) {
+        return std::nullopt;
+      }
+
+      return load<T>(data.data() + (offset - 1), big_endian);
+    }
+
+    // Divides instead of multiplying `count` by the element size, which could overflow
+    bool array_in_bounds(const int64_t offset, const int64_t count, const size_t element_size) const noexcept {
+      return offset >= 1 && count >= 0 && static_cast<uint64_t>(offset - 1) <= data.size() && static_cast<uint64_t>(count) <= (data.size() - static_cast<uint64_t>(offset - 1)) / element_size;
+    }
+
+    template<class T, class Array>
+    sol::object decode_array(const int64_t offset, const int64_t count, const bool big_endian, const sol::this_state this_state) const {
+      if (!array_in_bounds(offset, count, sizeof(T))) {
+        umbra_fail("File: array read out of range");
+      }
+
+      Array out;
+      out.resize(static_cast<size_t>(count));
+
+      const uint8_t* source = data.data() + (offset - 1);
+      typename Array::value_type* target = out.data();
+      for (int64_t i = 0; i < count; ++i, source += sizeof(T)) {
+        target[i] = static_cast<typename Array::value_type>(load<T>(source, big_endian));
+      }
+
+      return make_object(this_state, std::move(out));
+    }
+
+    template<class T>
+    sol::object decode_table(const int64_t offset, const int64_t count, const bool big_endian, const sol::this_state this_state) const {
+      if (!array_in_bounds(offset, count, sizeof(T))) {
+        umbra_fail("File: array read out of range");
+      }
+
+      sol::state_view state_view(this_state);
+      sol::table out = state_view.create_table(static_cast<int>(count), 0);
+
+      const uint8_t* source = data.data() + (offset - 1);
+      for (int64_t i = 0; i < count; ++i, source += sizeof(T)) {
+        out.raw_set(i + 1, load<T>(source, big_endian));
+      }
+
+      return out;
+    }
+
+    static size_t read_format_size(const std::string_view format, size_t& i, const size_t fallback) {
+      if (i >= format.size() || !std::isdigit(static_cast<unsigned char>(format[i]))) {
+        return fallback;
+      }
+
+      size_t size = 0;
+      while (i < format.size() && std::isdigit(static_cast<unsigned char>(format[i]))) {
+        size = size * 10 + static_cast<size_t>(format[i++] - '0');
+      }
+
+      if (size < 1 || size > MAX_INTEGER_SIZE) {
+        umbra_fail("File: integral size " + std::to_string(size) + " out of limits [1," + std::to_string(MAX_INTEGER_SIZE) + "]");
+      }
+
+      return size;
+    }
+
+    static size_t align_cursor(const size_t cursor, const size_t align) {
+      if (align <= 1) {
+        return cursor;
+      }
+
+      if ((align & (align - 1)) != 0) {
+        umbra_fail("File: unpack format asks for alignment not power of 2");
+      }
+
+      return (cursor + align - 1) & ~(align - 1);
     }
   };
 
-}
\ No newline at end of file
+  template<class T>
+  TypedArray<T> TypedArray<T>::view(const sol::object& file, const int64_t offset, const sol::optional<int64_t> count) {
+    if (!file.is<File>()) {
+      umbra_fail(type_name() + ": view expects a File");
+    }
+
+    File& source = file.as<File&>();
+    if (offset < 1 || static_cast<uint64_t>(offset - 1) > source.data.size()) {
+      umbra_fail(type_name() + ": view offset out of range");
+    }
+
+    const size_t available = (source.data.size() - static_cast<size_t>(offset - 1)) / sizeof(T);
+    const int64_t elements = count.value_or(static_cast<int64_t>(available));
+    if (elements < 0 || static_cast<uint64_t>(elements) > available) {
+      umbra_fail(type_name() + ": view out of range");
+    }
+
+    uint8_t* bytes = source.data.data() + (offset - 1);
+    if (reinterpret_cast<uintptr_t>(bytes) % alignof(T) != 0) {
+      umbra_fail(type_name() + ": view offset is not aligned to the element size");
+    }
+
+    TypedArray out;
+    out.data_ = reinterpret_cast<T*>(bytes);
+    out.size_ = static_cast<size_t>(elements);
+    out.owner_ = file;
+    return out;
+  }
+
+}
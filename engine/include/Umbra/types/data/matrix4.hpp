@@ -0,0 +1,420 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <sol/sol.hpp>
+#include <OgreMatrix4.h>
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/data/quaternion.hpp"
+#include "Umbra/types/data/vector3.hpp"
+#include "Umbra/types/simd.hpp"
+
+namespace umbra {
+
+  // 4x4 transform as a plain value type, row-major with column vectors and the translation in the last
+  // column, the same element order and convention as Ogre::Matrix4. Elements are real_t, so outside a
+  // UMBRA_REAL_FLOAT build they are doubles and Ogre conversions narrow each one; only that build
+  // takes the float4 paths. Default-constructs to the identity. Registration metadata lives in
+  // type_traits<Matrix4>.
+  //
+  // Rows and columns are 1-based from Lua, like the array types.
+  struct UMBRA_API Matrix4 {
+    real_t m[4][4];
+
+    Matrix4() noexcept : m{ { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } {}
+
+    explicit Matrix4(const Ogre::Matrix4& ogre_matrix) noexcept {
+      for (size_t row = 0; row < 4; ++row) {
+        for (size_t column = 0; column < 4; ++column) {
+          m[row][column] = ogre_matrix[row][column];
+        }
+      }
+    }
+
+    static Matrix4 identity() noexcept {
+      return {};
+    }
+
+    static Matrix4 from_translation(const Vector3& translation) noexcept {
+      Matrix4 out;
+      out.m[0][3] = translation.x;
+      out.m[1][3] = translation.y;
+      out.m[2][3] = translation.z;
+      return out;
+    }
+
+    static Matrix4 from_scale(const Vector3& scale) noexcept {
+      Matrix4 out;
+      out.m[0][0] = scale.x;
+      out.m[1][1] = scale.y;
+      out.m[2][2] = scale.z;
+      return out;
+    }
+
+    static Matrix4 from_rotation(const Quaternion& rotation) noexcept {
+      return compose(Vector3(), rotation, Vector3(1.0, 1.0, 1.0));
+    }
+
+    // Translation * rotation * scale, the node transform of a scene graph, built without any multiply
+    static Matrix4 compose(const Vector3& translation, const Quaternion& rotation, const Vector3& scale) noexcept {
+      const double w = rotation.w, x = rotation.x, y = rotation.y, z = rotation.z;
+      const double r[3][3] = {
+        { 1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y - w * z), 2.0 * (x * z + w * y) },
+        { 2.0 * (x * y + w * z), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z - w * x) },
+        { 2.0 * (x * z - w * y), 2.0 * (y * z + w * x), 1.0 - 2.0 * (x * x + y * y) }
+      };
+      const double s[3] = { scale.x, scale.y, scale.z };
+
+      Matrix4 out;
+      for (size_t row = 0; row < 3; ++row) {
+        for (size_t column = 0; column < 3; ++column) {
+          out.m[row][column] = static_cast<real_t>(r[row][column] * s[column]);
+        }
+      }
+
+      out.m[0][3] = translation.x;
+      out.m[1][3] = translation.y;
+      out.m[2][3] = translation.z;
+      return out;
+    }
+
+    // Splits an affine transform back into (translation, rotation, scale). A mirrored basis reports
+    // the reflection as a negative X scale.
+    std::tuple<Vector3, Quaternion, Vector3> decompose() const noexcept {
+      double r[3][3];
+      double s[3];
+
+      for (size_t column = 0; column < 3; ++column) {
+        s[column] = std::sqrt(static_cast<double>(m[0][column]) * m[0][column] + static_cast<double>(m[1][column]) * m[1][column] + static_cast<double>(m[2][column]) * m[2][column]);
+      }
+
+      const double basis_determinant =
+        m[0][0] * (static_cast<double>(m[1][1]) * m[2][2] - static_cast<double>(m[1][2]) * m[2][1]) -
+        m[0][1] * (static_cast<double>(m[1][0]) * m[2][2] - static_cast<double>(m[1][2]) * m[2][0]) +
+        m[0][2] * (static_cast<double>(m[1][0]) * m[2][1] - static_cast<double>(m[1][1]) * m[2][0]);
+
+      if (basis_determinant < 0.0) {
+        s[0] = -s[0];
+      }
+
+      for (size_t row = 0; row < 3; ++row) {
+        for (size_t column = 0; column < 3; ++column) {
+          r[row][column] = s[column] != 0.0 ? m[row][column] / s[column] : (row == column ? 1.0 : 0.0);
+        }
+      }
+
+      // Picks the largest of w, x, y, z to divide by, which keeps the conversion stable
+      Quaternion rotation;
+      const double trace = r[0][0] + r[1][1] + r[2][2];
+      if (trace > 0.0) {
+        const double k = 0.5 / std::sqrt(trace + 1.0);
+        rotation = { 0.25 / k, (r[2][1] - r[1][2]) * k, (r[0][2] - r[2][0]) * k, (r[1][0] - r[0][1]) * k };
+      } else if (r[0][0] > r[1][1] && r[0][0] > r[2][2]) {
+        const double k = 0.5 / std::sqrt(1.0 + r[0][0] - r[1][1] - r[2][2]);
+        rotation = { (r[2][1] - r[1][2]) * k, 0.25 / k, (r[0][1] + r[1][0]) * k, (r[0][2] + r[2][0]) * k };
+      } else if (r[1][1] > r[2][2]) {
+        const double k = 0.5 / std::sqrt(1.0 + r[1][1] - r[0][0] - r[2][2]);
+        rotation = { (r[0][2] - r[2][0]) * k, (r[0][1] + r[1][0]) * k, 0.25 / k, (r[1][2] + r[2][1]) * k };
+      } else {
+        const double k = 0.5 / std::sqrt(1.0 + r[2][2] - r[0][0] - r[1][1]);
+        rotation = { (r[1][0] - r[0][1]) * k, (r[0][2] + r[2][0]) * k, (r[1][2] + r[2][1]) * k, 0.25 / k };
+      }
+
+      return { translation(), rotation.normalized(), Vector3(s[0], s[1], s[2]) };
+    }
+
+    Vector3 translation() const noexcept {
+      return { m[0][3], m[1][3], m[2][3] };
+    }
+
+    double get(const int row, const int column) const {
+      check(row, column);
+      return m[row - 1][column - 1];
+    }
+
+    void set(const int row, const int column, const double value) {
+      check(row, column);
+      m[row - 1][column - 1] = static_cast<real_t>(value);
+    }
+
+    // Applies the full matrix to a point, dividing by w for projective matrices like Ogre does
+    Vector3 transform_point(const Vector3& point) const noexcept {
+#if UMBRA_SIMD_FLOAT4 && defined(UMBRA_REAL_FLOAT)
+      // Scale each row by (x, y, z, 1), then transpose so the four row sums become lane-wise adds
+      const simd::float4 p = simd::set(point.x, point.y, point.z, 1.0f);
+      simd::float4 r0 = simd::mul(simd::load(m[0]), p);
+      simd::float4 r1 = simd::mul(simd::load(m[1]), p);
+      simd::float4 r2 = simd::mul(simd::load(m[2]), p);
+      simd::float4 r3 = simd::mul(simd::load(m[3]), p);
+      simd::transpose(r0, r1, r2, r3);
+
+      float out[4];
+      simd::store(out, simd::add(simd::add(simd::add(r0, r1), r2), r3));
+#else
+      const double out[4] = {
+        m[0][0] * point.x + m[0][1] * point.y + m[0][2] * point.z + m[0][3],
+        m[1][0] * point.x + m[1][1] * point.y + m[1][2] * point.z + m[1][3],
+        m[2][0] * point.x + m[2][1] * point.y + m[2][2] * point.z + m[2][3],
+        m[3][0] * point.x + m[3][1] * point.y + m[3][2] * point.z + m[3][3]
+      };
+#endif
+
+      const double inverse_w = out[3] != 0.0 ? 1.0 / out[3] : 1.0;
+      return { out[0] * inverse_w, out[1] * inverse_w, out[2] * inverse_w };
+    }
+
+    // Applies only the upper 3x3 part, for directions and normals under a rigid transform
+    Vector3 transform_direction(const Vector3& direction) const noexcept {
+      return {
+        m[0][0] * direction.x + m[0][1] * direction.y + m[0][2] * direction.z,
+        m[1][0] * direction.x + m[1][1] * direction.y + m[1][2] * direction.z,
+        m[2][0] * direction.x + m[2][1] * direction.y + m[2][2] * direction.z
+      };
+    }
+
+    Matrix4 transpose() const noexcept {
+      Matrix4 out;
+      for (size_t row = 0; row < 4; ++row) {
+        for (size_t column = 0; column < 4; ++column) {
+          out.m[row][column] = m[column][row];
+        }
+      }
+
+      return out;
+    }
+
+    double determinant() const noexcept {
+      const Minors minors(*this);
+      return minors.determinant();
+    }
+
+    // General inverse from the 2x2 minors of the top and bottom row pairs. Fails when the matrix is
+    // singular.
+    Matrix4 inverse() const {
+      const Minors minors(*this);
+      const double determinant_value = minors.determinant();
+      if (determinant_value == 0.0 || !std::isfinite(determinant_value)) {
+        umbra_fail("Matrix4: matrix is not invertible");
+      }
+
+      const auto& [s, c] = minors;
+      const auto a = [this](const size_t row, const size_t column) { return static_cast<double>(m[row][column]); };
+      const double inverse_determinant = 1.0 / determinant_value;
+
+      const double out[4][4] = {
+        {
+          a(1, 1) * c[5] - a(1, 2) * c[4] + a(1, 3) * c[3],
+          -a(0, 1) * c[5] + a(0, 2) * c[4] - a(0, 3) * c[3],
+          a(3, 1) * s[5] - a(3, 2) * s[4] + a(3, 3) * s[3],
+          -a(2, 1) * s[5] + a(2, 2) * s[4] - a(2, 3) * s[3]
+        },
+        {
+          -a(1, 0) * c[5] + a(1, 2) * c[2] - a(1, 3) * c[1],
+          a(0, 0) * c[5] - a(0, 2) * c[2] + a(0, 3) * c[1],
+          -a(3, 0) * s[5] + a(3, 2) * s[2] - a(3, 3) * s[1],
+          a(2, 0) * s[5] - a(2, 2) * s[2] + a(2, 3) * s[1]
+        },
+        {
+          a(1, 0) * c[4] - a(1, 1) * c[2] + a(1, 3) * c[0],
+          -a(0, 0) * c[4] + a(0, 1) * c[2] - a(0, 3) * c[0],
+          a(3, 0) * s[4] - a(3, 1) * s[2] + a(3, 3) * s[0],
+          -a(2, 0) * s[4] + a(2, 1) * s[2] - a(2, 3) * s[0]
+        },
+        {
+          -a(1, 0) * c[3] + a(1, 1) * c[1] - a(1, 2) * c[0],
+          a(0, 0) * c[3] - a(0, 1) * c[1] + a(0, 2) * c[0],
+          -a(3, 0) * s[3] + a(3, 1) * s[1] - a(3, 2) * s[0],
+          a(2, 0) * s[3] - a(2, 1) * s[1] + a(2, 2) * s[0]
+        }
+      };
+
+      Matrix4 result;
+      for (size_t row = 0; row < 4; ++row) {
+        for (size_t column = 0; column < 4; ++column) {
+          result.m[row][column] = static_cast<real_t>(out[row][column] * inverse_determinant);
+        }
+      }
+
+      return result;
+    }
+
+    bool fuzzy_eq(const Matrix4& other, const double epsilon = 0.00001) const noexcept {
+      for (size_t row = 0; row < 4; ++row) {
+        for (size_t column = 0; column < 4; ++column) {
+          if (std::abs(static_cast<double>(m[row][column]) - other.m[row][column]) > epsilon) {
+            return false;
+          }
+        }
+      }
+
+      return true;
+    }
+
+    // Row-major table of 16 numbers
+    static Matrix4 from_table(const sol::table& table) {
+      if (table.size() != 16) {
+        umbra_fail("Matrix4: from_table expects 16 numbers");
+      }
+
+      Matrix4 out;
+      for (size_t i = 0; i < 16; ++i) {
+        out.m[i / 4][i % 4] = table.get<real_t>(i + 1);
+      }
+
+      return out;
+    }
+
+    sol::table to_table(const sol::this_state this_state) const {
+      sol::state_view lua_state(this_state);
+      sol::table out = lua_state.create_table(16, 0);
+
+      for (size_t i = 0; i < 16; ++i) {
+        out[i + 1] = m[i / 4][i % 4];
+      }
+
+      return out;
+    }
+
+    // Each output row is a sum of the rhs rows scaled by one element, so the inner loop runs across a
+    // whole row and vectorises without shuffles
+    Matrix4 operator*(const Matrix4& rhs) const noexcept {
+      Matrix4 out;
+#if UMBRA_SIMD_FLOAT4 && defined(UMBRA_REAL_FLOAT)
+      const simd::float4 rows[4] = { simd::load(rhs.m[0]), simd::load(rhs.m[1]), simd::load(rhs.m[2]), simd::load(rhs.m[3]) };
+      for (size_t row = 0; row < 4; ++row) {
+        simd::float4 accumulated = simd::mul(simd::splat(m[row][0]), rows[0]);
+        for (size_t k = 1; k < 4; ++k) {
+          accumulated = simd::madd(accumulated, simd::splat(m[row][k]), rows[k]);
+        }
+
+        simd::store(out.m[row], accumulated);
+      }
+#else
+      for (size_t row = 0; row < 4; ++row) {
+        real_t accumulated[4] = { 0, 0, 0, 0 };
+
+        for (size_t k = 0; k < 4; ++k) {
+          const real_t scalar = m[row][k];
+          for (size_t column = 0; column < 4; ++column) {
+            accumulated[column] += scalar * rhs.m[k][column];
+          }
+        }
+
+        std::copy(std::begin(accumulated), std::end(accumulated), out.m[row]);
+      }
+#endif
+
+      return out;
+    }
+
+    Vector3 operator*(const Vector3& rhs) const noexcept { return transform_point(rhs); }
+
+    bool operator==(const Matrix4& rhs) const noexcept {
+      return std::equal(&m[0][0], &m[0][0] + 16, &rhs.m[0][0]);
+    }
+
+    explicit operator Ogre::Matrix4() const noexcept {
+      return Ogre::Matrix4(
+        m[0][0], m[0][1], m[0][2], m[0][3],
+        m[1][0], m[1][1], m[1][2], m[1][3],
+        m[2][0], m[2][1], m[2][2], m[2][3],
+        m[3][0], m[3][1], m[3][2], m[3][3]
+      );
+    }
+
+    static void bind(sol::state& lua_state, const char* name);
+
+  private:
+    // 2x2 minors of rows 0-1 (s) and rows 2-3 (c), shared by determinant and inverse
+    struct Minors {
+      double s[6];
+      double c[6];
+
+      explicit Minors(const Matrix4& matrix) noexcept {
+        const auto a = [&matrix](const size_t row, const size_t column) { return static_cast<double>(matrix.m[row][column]); };
+
+        s[0] = a(0, 0) * a(1, 1) - a(1, 0) * a(0, 1);
+        s[1] = a(0, 0) * a(1, 2) - a(1, 0) * a(0, 2);
+        s[2] = a(0, 0) * a(1, 3) - a(1, 0) * a(0, 3);
+        s[3] = a(0, 1) * a(1, 2) - a(1, 1) * a(0, 2);
+        s[4] = a(0, 1) * a(1, 3) - a(1, 1) * a(0, 3);
+        s[5] = a(0, 2) * a(1, 3) - a(1, 2) * a(0, 3);
+
+        c[0] = a(2, 0) * a(3, 1) - a(3, 0) * a(2, 1);
+        c[1] = a(2, 0) * a(3, 2) - a(3, 0) * a(2, 2);
+        c[2] = a(2, 0) * a(3, 3) - a(3, 0) * a(2, 3);
+        c[3] = a(2, 1) * a(3, 2) - a(3, 1) * a(2, 2);
+        c[4] = a(2, 1) * a(3, 3) - a(3, 1) * a(2, 3);
+        c[5] = a(2, 2) * a(3, 3) - a(3, 2) * a(2, 3);
+      }
+
+      double determinant() const noexcept {
+        return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+      }
+    };
+
+    static void check(const int row, const int column) {
+      if (row < 1 || row > 4 || column < 1 || column > 4) {
+        umbra_fail("Matrix4: row and column must be between 1 and 4");
+      }
+    }
+  };
+
+  static_assert(std::is_trivially_copyable_v<Matrix4> && sizeof(Matrix4) == 16 * sizeof(real_t));
+
+  template<>
+  struct type_traits<Matrix4> {
+    static constexpr const char* name = "Matrix4";
+  };
+
+  inline void Matrix4::bind(sol::state& lua_state, const char* name) {
+    sol::usertype<Matrix4> user_type = lua_state.new_usertype<Matrix4>(name,
+      sol::constructors<Matrix4()>(),
+      "identity", &Matrix4::identity,
+      "from_translation", &Matrix4::from_translation,
+      "from_scale", &Matrix4::from_scale,
+      "from_rotation", &Matrix4::from_rotation,
+      "compose", &Matrix4::compose,
+      "decompose", &Matrix4::decompose,
+      "translation", &Matrix4::translation,
+      "get", &Matrix4::get,
+      "set", &Matrix4::set,
+      "transform_point", &Matrix4::transform_point,
+      "transform_direction", &Matrix4::transform_direction,
+      "transpose", &Matrix4::transpose,
+      "determinant", &Matrix4::determinant,
+      "inverse", &Matrix4::inverse,
+      "fuzzy_eq", &Matrix4::fuzzy_eq,
+      "from_table", &Matrix4::from_table,
+      "to_table", &Matrix4::to_table
+    );
+
+    // Matrix4 * Matrix4 composes, Matrix4 * Vector3 transforms a point
+    user_type[sol::meta_function::multiplication] = sol::overload(
+      [](const Matrix4& self, const Matrix4& other) {
+        return self * other;
+      },
+      [](const Matrix4& self, const Vector3& other) {
+        return self * other;
+      }
+    );
+
+    user_type[sol::meta_function::equal_to] = [](const Matrix4& lhs, const Matrix4& rhs) {
+      return lhs == rhs;
+    };
+
+    user_type[sol::meta_function::to_string] = [](const Matrix4& matrix) {
+      std::string out = "Matrix4(";
+      for (size_t i = 0; i < 16; ++i) {
+        out += (i == 0 ? "" : ", ") + std::to_string(matrix.m[i / 4][i % 4]);
+      }
+
+      return out + ")";
+    };
+  }
+
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <sol/sol.hpp>
+#include <OgreQuaternion.h>
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/data/vector3.hpp"
+#include "Umbra/types/fast_bindings.hpp"
+#include "Umbra/types/simd.hpp"
+
+namespace umbra {
+
+  // Rotation quaternion as a plain value type, with components in Ogre::Quaternion's (w, x, y, z) order.
+  // Only a UMBRA_REAL_FLOAT build shares Ogre's float storage and takes the float4 paths below; by
+  // default components are doubles and each one is narrowed on conversion. Registration metadata lives
+  // in type_traits<Quaternion>.
+  struct UMBRA_API Quaternion {
+    real_t w;
+    real_t x;
+    real_t y;
+    real_t z;
+
+    Quaternion(const double w, const double x, const double y, const double z) noexcept : w(static_cast<real_t>(w)), x(static_cast<real_t>(x)), y(static_cast<real_t>(y)), z(static_cast<real_t>(z)) {}
+    Quaternion() noexcept : w(1), x(0), y(0), z(0) {}
+    explicit Quaternion(const Ogre::Quaternion& ogre_quaternion) noexcept : w(ogre_quaternion.w), x(ogre_quaternion.x), y(ogre_quaternion.y), z(ogre_quaternion.z) {}
+
+    static Quaternion identity() noexcept {
+      return {};
+    }
+
+    // `axis` does not need to be normalised; a zero axis gives the identity
+    static Quaternion from_axis_angle(const Vector3& axis, const double angle) noexcept {
+      const double length = axis.length();
+      if (length == 0.0) {
+        return {};
+      }
+
+      const double s = std::sin(angle * 0.5) / length;
+      return { std::cos(angle * 0.5), axis.x * s, axis.y * s, axis.z * s };
+    }
+
+    // Rotation about X, then Y, then Z, in radians
+    static Quaternion from_euler(const double pitch, const double yaw, const double roll) noexcept {
+      const double cx = std::cos(pitch * 0.5), sx = std::sin(pitch * 0.5);
+      const double cy = std::cos(yaw * 0.5), sy = std::sin(yaw * 0.5);
+      const double cz = std::cos(roll * 0.5), sz = std::sin(roll * 0.5);
+
+      return {
+        cz * cy * cx + sz * sy * sx,
+        cz * cy * sx - sz * sy * cx,
+        cz * sy * cx + sz * cy * sx,
+        sz * cy * cx - cz * sy * sx
+      };
+    }
+
+    double dot(const Quaternion& other) const noexcept {
+      return static_cast<double>(w) * other.w + static_cast<double>(x) * other.x + static_cast<double>(y) * other.y + static_cast<double>(z) * other.z;
+    }
+
+    double length() const noexcept {
+      return std::sqrt(dot(*this));
+    }
+
+    Quaternion normalized() const noexcept {
+      const double length_value = length();
+      if (length_value == 0.0) {
+        return *this;
+      }
+
+      return *this * (1.0 / length_value);
+    }
+
+    Quaternion conjugate() const noexcept {
+      return { w, -x, -y, -z };
+    }
+
+    // Zero for a zero quaternion, as in Ogre
+    Quaternion inverse() const noexcept {
+      const double norm = dot(*this);
+      if (norm == 0.0) {
+        return { 0.0, 0.0, 0.0, 0.0 };
+      }
+
+      return conjugate() * (1.0 / norm);
+    }
+
+    // Rotates `v` by this unit quaternion, using v' = v + 2w(q x v) + 2q x (q x v)
+    Vector3 rotate(const Vector3& v) const noexcept {
+#if UMBRA_SIMD_FLOAT4 && defined(UMBRA_REAL_FLOAT)
+      // Lanes (x, y, z, 0); each cross product is yzx * zxy - zxy * yzx
+      const simd::float4 axis = simd::set(x, y, z, 0.0f);
+      const simd::float4 vector = simd::set(v.x, v.y, v.z, 0.0f);
+      const auto cross = [](const simd::float4 a, const simd::float4 b) {
+        return simd::sub(
+          simd::mul(simd::shuffle<1, 2, 0, 3>(a), simd::shuffle<2, 0, 1, 3>(b)),
+          simd::mul(simd::shuffle<2, 0, 1, 3>(a), simd::shuffle<1, 2, 0, 3>(b))
+        );
+      };
+
+      const simd::float4 t = simd::mul(simd::splat(2.0f), cross(axis, vector));
+      float out[4];
+      simd::store(out, simd::add(simd::madd(vector, simd::splat(w), t), cross(axis, t)));
+      return { out[0], out[1], out[2] };
+#else
+      const double tx = 2.0 * (y * v.z - z * v.y);
+      const double ty = 2.0 * (z * v.x - x * v.z);
+      const double tz = 2.0 * (x * v.y - y * v.x);
+
+      return {
+        v.x + w * tx + (y * tz - z * ty),
+        v.y + w * ty + (z * tx - x * tz),
+        v.z + w * tz + (x * ty - y * tx)
+      };
+#endif
+    }
+
+    // Interpolates along the shorter arc. Nearly parallel inputs fall back to a normalised lerp, where
+    // the slerp weights lose precision.
+    Quaternion slerp(const Quaternion& other, const double alpha) const noexcept {
+      double cosine = dot(other);
+      Quaternion target = other;
+
+      if (cosine < 0.0) {
+        cosine = -cosine;
+        target = other * -1.0;
+      }
+
+      if (cosine > 0.9995) {
+        return (*this * (1.0 - alpha) + target * alpha).normalized();
+      }
+
+      const double angle = std::acos(cosine);
+      const double inverse_sine = 1.0 / std::sin(angle);
+      return *this * (std::sin((1.0 - alpha) * angle) * inverse_sine) + target * (std::sin(alpha * angle) * inverse_sine);
+    }
+
+    // Axis and angle in radians of this unit quaternion; the axis is X for the identity
+    std::tuple<Vector3, double> to_axis_angle() const noexcept {
+      const double sine_squared = static_cast<double>(x) * x + static_cast<double>(y) * y + static_cast<double>(z) * z;
+      if (sine_squared == 0.0) {
+        return { Vector3(1.0, 0.0, 0.0), 0.0 };
+      }
+
+      const double inverse = 1.0 / std::sqrt(sine_squared);
+      const double angle = 2.0 * std::atan2(std::sqrt(sine_squared), static_cast<double>(w));
+      return { Vector3(x * inverse, y * inverse, z * inverse), angle };
+    }
+
+    bool fuzzy_eq(const Quaternion& other, const double epsilon = 0.00001) const noexcept {
+      const Quaternion d = *this - other;
+      return d.dot(d) <= epsilon * epsilon;
+    }
+
+    void set(const double new_w, const double new_x, const double new_y, const double new_z) noexcept {
+      w = static_cast<real_t>(new_w);
+      x = static_cast<real_t>(new_x);
+      y = static_cast<real_t>(new_y);
+      z = static_cast<real_t>(new_z);
+    }
+
+    // Hamilton product: `a * b` applies b first, then a
+    Quaternion operator*(const Quaternion& rhs) const noexcept {
+#if UMBRA_SIMD_FLOAT4 && defined(UMBRA_REAL_FLOAT)
+      // rhs scaled by each of w, x, y, z, with its lanes permuted and negated to line up with the
+      // output (w, x, y, z); the sums run in the same order as the scalar form below
+      const simd::float4 b = simd::set(rhs.w, rhs.x, rhs.y, rhs.z);
+      const simd::float4 by_x = simd::mul(simd::shuffle<1, 0, 3, 2>(b), simd::set(-1.0f, 1.0f, -1.0f, 1.0f));
+      const simd::float4 by_y = simd::mul(simd::shuffle<2, 3, 0, 1>(b), simd::set(-1.0f, 1.0f, 1.0f, -1.0f));
+      const simd::float4 by_z = simd::mul(simd::shuffle<3, 2, 1, 0>(b), simd::set(-1.0f, -1.0f, 1.0f, 1.0f));
+
+      simd::float4 product = simd::mul(simd::splat(w), b);
+      product = simd::madd(product, simd::splat(x), by_x);
+      product = simd::madd(product, simd::splat(y), by_y);
+      product = simd::madd(product, simd::splat(z), by_z);
+
+      float out[4];
+      simd::store(out, product);
+      return { out[0], out[1], out[2], out[3] };
+#else
+      return {
+        w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z,
+        w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+        w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
+        w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w
+      };
+#endif
+    }
+
+    Vector3 operator*(const Vector3& rhs) const noexcept { return rotate(rhs); }
+
+    Quaternion operator+(const Quaternion& rhs) const noexcept { return { w + rhs.w, x + rhs.x, y + rhs.y, z + rhs.z }; }
+    Quaternion operator-(const Quaternion& rhs) const noexcept { return { w - rhs.w, x - rhs.x, y - rhs.y, z - rhs.z }; }
+    Quaternion operator*(const double rhs) const noexcept { return { w * rhs, x * rhs, y * rhs, z * rhs }; }
+
+    explicit operator Ogre::Quaternion() const noexcept { return Ogre::Quaternion(w, x, y, z); }
+
+    static void bind(sol::state& lua_state, const char* name);
+  };
+
+  static_assert(std::is_trivially_copyable_v<Quaternion> && sizeof(Quaternion) == 4 * sizeof(real_t));
+
+  template<>
+  struct type_traits<Quaternion> {
+    static constexpr const char* name = "Quaternion";
+    static constexpr real_t Quaternion::* components[] = { &Quaternion::w, &Quaternion::x, &Quaternion::y, &Quaternion::z };
+  };
+
+  inline void Quaternion::bind(sol::state& lua_state, const char* name) {
+    sol::usertype<Quaternion> user_type = lua_state.new_usertype<Quaternion>(name,
+      sol::constructors<Quaternion(), Quaternion(double, double, double, double)>(),
+      "w", &Quaternion::w,
+      "x", &Quaternion::x,
+      "y", &Quaternion::y,
+      "z", &Quaternion::z,
+
+      "identity", &Quaternion::identity,
+      "from_axis_angle", &Quaternion::from_axis_angle,
+      "from_euler", &Quaternion::from_euler,
+      "dot", &fast_bindings::dot<Quaternion>,
+      "length", &fast_bindings::length<Quaternion>,
+      "normalized", &Quaternion::normalized,
+      "conjugate", &Quaternion::conjugate,
+      "inverse", &Quaternion::inverse,
+      "rotate", &Quaternion::rotate,
+      "slerp", &Quaternion::slerp,
+      "to_axis_angle", &Quaternion::to_axis_angle,
+      "fuzzy_eq", &Quaternion::fuzzy_eq,
+
+      "set", &fast_bindings::set<Quaternion>,
+      "unpack", &fast_bindings::unpack<Quaternion>
+    );
+
+    // Quaternion * Quaternion composes, Quaternion * Vector3 rotates
+    user_type[sol::meta_function::multiplication] = sol::overload(
+      [](const Quaternion& self, const Quaternion& other) {
+        return self * other;
+      },
+      [](const Quaternion& self, const Vector3& other) {
+        return self * other;
+      }
+    );
+
+    user_type[sol::meta_function::equal_to] = &fast_bindings::eq<Quaternion>;
+
+    user_type[sol::meta_function::to_string] = [](const Quaternion& q) {
+      return "Quaternion(" + std::to_string(q.w) + ", " + std::to_string(q.x) + ", " + std::to_string(q.y) + ", " + std::to_string(q.z) + ")";
+    };
+  }
+
+}
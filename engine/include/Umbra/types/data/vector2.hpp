@@ -1,21 +1,23 @@
 #pragma once
 
 #include "Umbra/types.hpp"
+#include "Umbra/types/fast_bindings.hpp"
 
 #include <algorithm>
 #include <cmath>
 #include <string>
+#include <type_traits>
 #include <sol/sol.hpp>
 
 namespace umbra {
 
-  struct UMBRA_API Vector2 final : IType {
-    double x;
-    double y;
+  // Plain value type: no vtable, so a Lua userdata holds exactly two components. Registration metadata
+  // lives in type_traits<Vector2>.
+  struct UMBRA_API Vector2 {
+    real_t x;
+    real_t y;
 
-    const char* name() override  { return "Vector2"; }
-
-    Vector2(const double x, const double y) noexcept : x(x), y(y) {}
+    Vector2(const double x, const double y) noexcept : x(static_cast<real_t>(x)), y(static_cast<real_t>(y)) {}
     Vector2() noexcept : x(0), y(0) {}
 
     Vector2 abs() const noexcept {
@@ -39,20 +41,20 @@ namespace umbra {
     }
 
     double length() const noexcept {
-      return std::sqrt(x * x + y * y);
+      return std::sqrt(static_cast<double>(x) * x + static_cast<double>(y) * y);
     }
 
     double cross(const Vector2& other) const noexcept {
-      return x * other.y - y * other.x;
+      return static_cast<double>(x) * other.y - static_cast<double>(y) * other.x;
     }
 
     Vector2 sign() const noexcept {
-      auto sgn = [](const double v) -> double { return (v > 0.0f) - (v < 0.0f); };
+      auto sgn = [](const real_t v) -> double { return (v > 0.0f) - (v < 0.0f); };
       return { sgn(x), sgn(y) };
     }
 
     double dot(const Vector2& other) const noexcept {
-      return x * other.x + y * other.y;
+      return static_cast<double>(x) * other.x + static_cast<double>(y) * other.y;
     }
 
     double angle(const Vector2& other, bool is_signed) const noexcept {
@@ -78,13 +80,24 @@ namespace umbra {
     }
 
     bool fuzzy_eq(const Vector2& other, const double epsilon = 0.00001) const noexcept {
-      const double dx = x - other.x;
-      const double dy = y - other.y;
+      const double dx = static_cast<double>(x) - other.x;
+      const double dy = static_cast<double>(y) - other.y;
       const double dist2 = dx * dx + dy * dy;
       const double e2 = epsilon * epsilon;
       return dist2 <= e2;
     }
 
+    // In-place variants of the arithmetic operators. They write into the existing userdata instead of
+    // allocating a new one for the result, which matters in per-frame loops.
+    void add_assign(const Vector2& other) noexcept { *this += other; }
+    void sub_assign(const Vector2& other) noexcept { *this -= other; }
+    void scale_assign(const double scalar) noexcept { *this *= scalar; }
+
+    void set(const double new_x, const double new_y) noexcept {
+      x = static_cast<real_t>(new_x);
+      y = static_cast<real_t>(new_y);
+    }
+
     Vector2 operator+(const Vector2& rhs) const noexcept { return { x + rhs.x, y + rhs.y }; }
     Vector2 operator-(const Vector2& rhs) const noexcept { return { x - rhs.x, y - rhs.y }; }
     Vector2 operator*(const Vector2& rhs) const noexcept { return { x * rhs.x, y * rhs.y }; }
@@ -98,50 +111,54 @@ namespace umbra {
     Vector2& operator*=(const double rhs) noexcept { x *= rhs; y *= rhs; return *this; }
     Vector2& operator/=(const double rhs) noexcept { x /= rhs; y /= rhs; return *this; }
 
-    void bind(sol::state& lua_state) {
-      sol::usertype<Vector2> user_type = lua_state.new_usertype<Vector2>(name(),
-        sol::constructors<Vector2(), Vector2(double, double)>(),
-        "x", &Vector2::x,
-        "y", &Vector2::y,
-
-        "abs", &Vector2::abs,
-        "ceil", &Vector2::ceil,
-        "floor", &Vector2::floor,
-        "max", &Vector2::max,
-        "min", &Vector2::min,
-        "length", &Vector2::length,
-        "cross", &Vector2::cross,
-        "sign", &Vector2::sign,
-        "dot", &Vector2::dot,
-        "angle", &Vector2::angle,
-        "lerp", &Vector2::lerp,
-        "fuzzy_eq", &Vector2::fuzzy_eq
-      );
-
-      user_type[sol::meta_function::addition] = [](const Vector2& lhs, const Vector2& rhs) { return lhs + rhs; };
-      user_type[sol::meta_function::subtraction] = [](const Vector2& lhs, const Vector2& rhs) { return lhs - rhs; };
-
-      user_type[sol::meta_function::multiplication] = sol::overload(
-        [](const Vector2& lhs, const double rhs) { return lhs * rhs; },
-        [](const double lhs, const Vector2& rhs) { return rhs * lhs; },
-        [](const Vector2& lhs, const Vector2& rhs) { return lhs * rhs; }
-      );
-
-      user_type[sol::meta_function::division] = sol::overload(
-        [](const Vector2& lhs, const double rhs) { return lhs / rhs; },
-        [](const Vector2& lhs, const Vector2& rhs) { return lhs / rhs; }
-      );
-
-      user_type[sol::meta_function::unary_minus] = [](const Vector2& rhs) { return Vector2(-rhs.x, -rhs.y); };
-
-      user_type[sol::meta_function::equal_to] = [](const Vector2& lhs, const Vector2& rhs) {
-        return lhs.x == rhs.x && lhs.y == rhs.y;
-      };
-
-      user_type[sol::meta_function::to_string] = [](const Vector2& vector) {
-        return "Vector2(" + std::to_string(vector.x) + ", " + std::to_string(vector.y) + ")";
-      };
-    }
+    static void bind(sol::state& lua_state, const char* name);
+  };
+
+  static_assert(std::is_trivially_copyable_v<Vector2> && sizeof(Vector2) == 2 * sizeof(real_t));
+
+  template<>
+  struct type_traits<Vector2> {
+    static constexpr const char* name = "Vector2";
+    static constexpr real_t Vector2::* components[] = { &Vector2::x, &Vector2::y };
   };
 
-}
\ No newline at end of file
+  inline void Vector2::bind(sol::state& lua_state, const char* name) {
+    sol::usertype<Vector2> user_type = lua_state.new_usertype<Vector2>(name,
+      sol::constructors<Vector2(), Vector2(double, double)>(),
+      "x", &Vector2::x,
+      "y", &Vector2::y,
+
+      "abs", &Vector2::abs,
+      "ceil", &Vector2::ceil,
+      "floor", &Vector2::floor,
+      "max", &Vector2::max,
+      "min", &Vector2::min,
+      "length", &fast_bindings::length<Vector2>,
+      "cross", &Vector2::cross,
+      "sign", &Vector2::sign,
+      "dot", &fast_bindings::dot<Vector2>,
+      "angle", &Vector2::angle,
+      "lerp", &Vector2::lerp,
+      "fuzzy_eq", &Vector2::fuzzy_eq,
+
+      "add_assign", &fast_bindings::add_assign<Vector2>,
+      "sub_assign", &fast_bindings::sub_assign<Vector2>,
+      "scale_assign", &fast_bindings::scale_assign<Vector2>,
+      "set", &fast_bindings::set<Vector2>,
+      "unpack", &fast_bindings::unpack<Vector2>
+    );
+
+    // Hot operators bypass sol2's wrappers and overload resolution, see fast_bindings.hpp
+    user_type[sol::meta_function::addition] = &fast_bindings::add<Vector2>;
+    user_type[sol::meta_function::subtraction] = &fast_bindings::sub<Vector2>;
+    user_type[sol::meta_function::multiplication] = &fast_bindings::mul<Vector2>;
+    user_type[sol::meta_function::division] = &fast_bindings::div<Vector2>;
+    user_type[sol::meta_function::unary_minus] = &fast_bindings::unm<Vector2>;
+    user_type[sol::meta_function::equal_to] = &fast_bindings::eq<Vector2>;
+
+    user_type[sol::meta_function::to_string] = [](const Vector2& vector) {
+      return "Vector2(" + std::to_string(vector.x) + ", " + std::to_string(vector.y) + ")";
+    };
+  }
+
+}
@@ -3,21 +3,23 @@
 #include <algorithm>
 #include <cmath>
 #include <string>
+#include <type_traits>
 #include <sol/sol.hpp>
 #include <OgreVector3.h>
 
 #include "Umbra/types.hpp"
+#include "Umbra/types/fast_bindings.hpp"
 
 namespace umbra {
 
-  struct UMBRA_API Vector3 final : IType {
-    double x;
-    double y;
-    double z;
+  // Plain value type: no vtable, so a Lua userdata holds exactly three components. Registration metadata
+  // lives in type_traits<Vector3>.
+  struct UMBRA_API Vector3 {
+    real_t x;
+    real_t y;
+    real_t z;
 
-    const char* name() override { return "Vector3"; }
-
-    Vector3(const double x, const double y, const double z) noexcept : x(x), y(y), z(z) {}
+    Vector3(const double x, const double y, const double z) noexcept : x(static_cast<real_t>(x)), y(static_cast<real_t>(y)), z(static_cast<real_t>(z)) {}
     Vector3() noexcept : x(0), y(0), z(0) {}
     explicit Vector3(const Ogre::Vector3& ogre_vector) noexcept : x(ogre_vector.x), y(ogre_vector.y), z(ogre_vector.z) {}
 
@@ -42,7 +44,7 @@ namespace umbra {
     }
 
     double length() const noexcept {
-      return std::sqrt(x * x + y * y + z * z);
+      return std::sqrt(dot(*this));
     }
 
     Vector3 cross(const Vector3& other) const noexcept {
@@ -54,12 +56,12 @@ namespace umbra {
     }
 
     Vector3 sign() const noexcept {
-      auto sgn = [](const double v) -> double { return (v > 0.0f) - (v < 0.0f); };
+      auto sgn = [](const real_t v) -> double { return (v > 0.0f) - (v < 0.0f); };
       return { sgn(x), sgn(y), sgn(z) };
     }
 
     double dot(const Vector3& other) const noexcept {
-      return x * other.x + y * other.y + z * other.z;
+      return static_cast<double>(x) * other.x + static_cast<double>(y) * other.y + static_cast<double>(z) * other.z;
     }
 
     double angle(const Vector3& other) const noexcept {
@@ -69,17 +71,17 @@ namespace umbra {
       if (la == 0.0 || lb == 0.0) return 0.0;
 
       const Vector3 c = cross(other);
-      const double cl = std::sqrt(c.x*c.x + c.y*c.y + c.z*c.z);
+      const double cl = c.length();
       return std::atan2(cl, d);
     }
 
     double angle(const Vector3& other, const Vector3& axis) const noexcept {
       const double base = angle(other);
-      const double axis_len2 = axis.x*axis.x + axis.y*axis.y + axis.z*axis.z;
+      const double axis_len2 = axis.dot(axis);
       if (axis_len2 == 0.0) return base;
 
       const Vector3 c = cross(other);
-      const double sign_dot = axis.x * c.x + axis.y * c.y + axis.z * c.z;
+      const double sign_dot = axis.dot(c);
       const double sgn = (sign_dot > 0.0) - (sign_dot < 0.0);
       return sgn >= 0.0 ? base : -base;
     }
@@ -90,14 +92,26 @@ namespace umbra {
     }
 
     bool fuzzy_eq(const Vector3& other, const double epsilon = 0.00001) const noexcept {
-      const double dx = x - other.x;
-      const double dy = y - other.y;
-      const double dz = z - other.z;
+      const double dx = static_cast<double>(x) - other.x;
+      const double dy = static_cast<double>(y) - other.y;
+      const double dz = static_cast<double>(z) - other.z;
       const double dist2 = dx * dx + dy * dy + dz * dz;
       const double e2 = epsilon * epsilon;
       return dist2 <= e2;
     }
 
+    // In-place variants of the arithmetic operators. They write into the existing userdata instead of
+    // allocating a new one for the result, which matters in per-frame loops.
+    void add_assign(const Vector3& other) noexcept { *this += other; }
+    void sub_assign(const Vector3& other) noexcept { *this -= other; }
+    void scale_assign(const double scalar) noexcept { *this *= scalar; }
+
+    void set(const double new_x, const double new_y, const double new_z) noexcept {
+      x = static_cast<real_t>(new_x);
+      y = static_cast<real_t>(new_y);
+      z = static_cast<real_t>(new_z);
+    }
+
     Vector3 operator+(const Vector3& rhs) const noexcept { return { x + rhs.x, y + rhs.y, z + rhs.z }; }
     Vector3 operator-(const Vector3& rhs) const noexcept { return { x - rhs.x, y - rhs.y, z - rhs.z }; }
     Vector3 operator*(const Vector3& rhs) const noexcept { return { x * rhs.x, y * rhs.y, z * rhs.z }; }
@@ -113,59 +127,63 @@ namespace umbra {
 
     explicit operator Ogre::Vector3() const noexcept { return Ogre::Vector3(x, y, z); }
 
-    void bind(sol::state& lua_state) {
-      sol::usertype<Vector3> user_type = lua_state.new_usertype<Vector3>(name(),
-        sol::constructors<Vector3(), Vector3(double, double, double)>(),
-        "x", &Vector3::x,
-        "y", &Vector3::y,
-        "z", &Vector3::z,
-
-        "abs", &Vector3::abs,
-        "ceil", &Vector3::ceil,
-        "floor", &Vector3::floor,
-        "max", &Vector3::max,
-        "min", &Vector3::min,
-        "length", &Vector3::length,
-        "cross", &Vector3::cross,
-        "sign", &Vector3::sign,
-        "dot", &Vector3::dot,
-        "lerp", &Vector3::lerp,
-        "fuzzy_eq", &Vector3::fuzzy_eq
-      );
-
-      user_type.set_function("angle", sol::overload(
-        [](const Vector3& self, const Vector3& other) {
-          return self.angle(other);
-        },
-        [](const Vector3& self, const Vector3& other, const Vector3& axis) {
-          return self.angle(other, axis);
-        }
-      ));
-
-      user_type[sol::meta_function::addition] = [](const Vector3& lhs, const Vector3& rhs) { return lhs + rhs; };
-      user_type[sol::meta_function::subtraction] = [](const Vector3& lhs, const Vector3& rhs) { return lhs - rhs; };
-
-      user_type[sol::meta_function::multiplication] = sol::overload(
-        [](const Vector3& lhs, const double rhs) { return lhs * rhs; },
-        [](const double lhs, const Vector3& rhs) { return rhs * lhs; },
-        [](const Vector3& lhs, const Vector3& rhs) { return lhs * rhs; }
-      );
-
-      user_type[sol::meta_function::division] = sol::overload(
-        [](const Vector3& lhs, const double rhs) { return lhs / rhs; },
-        [](const Vector3& lhs, const Vector3& rhs) { return lhs / rhs; }
-      );
-
-      user_type[sol::meta_function::unary_minus] = [](const Vector3& rhs) { return Vector3(-rhs.x, -rhs.y, -rhs.z); };
-
-      user_type[sol::meta_function::equal_to] = [](const Vector3& lhs, const Vector3& rhs) {
-        return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
-      };
+    static void bind(sol::state& lua_state, const char* name);
+  };
 
-      user_type[sol::meta_function::to_string] = [](const Vector3& v) {
-        return "Vector3(" + std::to_string(v.x) + ", " + std::to_string(v.y) + ", " + std::to_string(v.z) + ")";
-      };
-    }
+  static_assert(std::is_trivially_copyable_v<Vector3> && sizeof(Vector3) == 3 * sizeof(real_t));
+
+  template<>
+  struct type_traits<Vector3> {
+    static constexpr const char* name = "Vector3";
+    static constexpr real_t Vector3::* components[] = { &Vector3::x, &Vector3::y, &Vector3::z };
   };
 
+  inline void Vector3::bind(sol::state& lua_state, const char* name) {
+    sol::usertype<Vector3> user_type = lua_state.new_usertype<Vector3>(name,
+      sol::constructors<Vector3(), Vector3(double, double, double)>(),
+      "x", &Vector3::x,
+      "y", &Vector3::y,
+      "z", &Vector3::z,
+
+      "abs", &Vector3::abs,
+      "ceil", &Vector3::ceil,
+      "floor", &Vector3::floor,
+      "max", &Vector3::max,
+      "min", &Vector3::min,
+      "length", &fast_bindings::length<Vector3>,
+      "cross", &Vector3::cross,
+      "sign", &Vector3::sign,
+      "dot", &fast_bindings::dot<Vector3>,
+      "lerp", &Vector3::lerp,
+      "fuzzy_eq", &Vector3::fuzzy_eq,
+
+      "add_assign", &fast_bindings::add_assign<Vector3>,
+      "sub_assign", &fast_bindings::sub_assign<Vector3>,
+      "scale_assign", &fast_bindings::scale_assign<Vector3>,
+      "set", &fast_bindings::set<Vector3>,
+      "unpack", &fast_bindings::unpack<Vector3>
+    );
+
+    user_type.set_function("angle", sol::overload(
+      [](const Vector3& self, const Vector3& other) {
+        return self.angle(other);
+      },
+      [](const Vector3& self, const Vector3& other, const Vector3& axis) {
+        return self.angle(other, axis);
+      }
+    ));
+
+    // Hot operators bypass sol2's wrappers and overload resolution, see fast_bindings.hpp
+    user_type[sol::meta_function::addition] = &fast_bindings::add<Vector3>;
+    user_type[sol::meta_function::subtraction] = &fast_bindings::sub<Vector3>;
+    user_type[sol::meta_function::multiplication] = &fast_bindings::mul<Vector3>;
+    user_type[sol::meta_function::division] = &fast_bindings::div<Vector3>;
+    user_type[sol::meta_function::unary_minus] = &fast_bindings::unm<Vector3>;
+    user_type[sol::meta_function::equal_to] = &fast_bindings::eq<Vector3>;
+
+    user_type[sol::meta_function::to_string] = [](const Vector3& v) {
+      return "Vector3(" + std::to_string(v.x) + ", " + std::to_string(v.y) + ", " + std::to_string(v.z) + ")";
+    };
+  }
+
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+
+#include <cstddef>
+#include <sol/sol.hpp>
+
+// Debug builds verify every argument through sol's full check. Release builds compare the userdata's
+// metatable with the usertype's, which rejects every other userdata without sol's derived class and
+// container handling.
+#if !defined(NDEBUG) || defined(SOL_ALL_SAFETIES_ON)
+#define UMBRA_CHECKED_BINDINGS 1
+#else
+#define UMBRA_CHECKED_BINDINGS 0
+#endif
+
+namespace umbra::fast_bindings {
+
+  // Raw lua_CFunctions for the hottest math type entry points. They are registered in place of sol2's
+  // generated wrappers and sol::overload dispatch, so a call is a type-tag check or two and the operation.
+  // T needs the arithmetic operators, dot() and length(), plus type_traits<T>::name and
+  // type_traits<T>::components, an array of pointers to its real_t members.
+  //
+  // Nothing in here owns resources, so raising a Lua error (a longjmp in C builds of Lua) is safe.
+
+  // Whether the metatable on top of the stack is the one registered under `name`. Pops nothing.
+  inline bool is_metatable(lua_State* L, const char* name) {
+    luaL_getmetatable(L, name);
+    const bool equal = lua_rawequal(L, -1, -2) != 0;
+    lua_pop(L, 1);
+    return equal;
+  }
+
+  // Whether the value at `index` is a T held by value or by reference. sol keys its metatables in the
+  // registry by these names; the name strings are static, so Lua's API string cache makes each lookup
+  // one hash probe.
+  template<class T>
+  bool is(lua_State* L, const int index) {
+    if (lua_type(L, index) != LUA_TUSERDATA || !lua_getmetatable(L, index)) {
+      return false;
+    }
+
+    const bool match = is_metatable(L, sol::usertype_traits<T>::metatable().c_str()) || is_metatable(L, sol::usertype_traits<T*>::metatable().c_str());
+    lua_pop(L, 1);
+    return match;
+  }
+
+  template<class T>
+  T& self(lua_State* L, const int index) {
+#if UMBRA_CHECKED_BINDINGS
+    if (!sol::stack::check<T>(L, index, sol::no_panic)) {
+      luaL_typeerror(L, index, type_traits<T>::name);
+    }
+#else
+    if (!is<T>(L, index)) {
+      luaL_typeerror(L, index, type_traits<T>::name);
+    }
+#endif
+
+    return *sol::stack::unqualified_get<T*>(L, index);
+  }
+
+  inline double number(lua_State* L, const int index) {
+    return luaL_checknumber(L, index);
+  }
+
+  template<class T>
+  int push(lua_State* L, const T& value) {
+    return sol::stack::push(L, value);
+  }
+
+  template<class T>
+  int add(lua_State* L) {
+    return push(L, self<T>(L, 1) + self<T>(L, 2));
+  }
+
+  template<class T>
+  int sub(lua_State* L) {
+    return push(L, self<T>(L, 1) - self<T>(L, 2));
+  }
+
+  // Accepts number * T, T * number and T * T, the same forms the sol::overload used to
+  template<class T>
+  int mul(lua_State* L) {
+    if (lua_type(L, 1) == LUA_TNUMBER) {
+      return push(L, self<T>(L, 2) * lua_tonumber(L, 1));
+    }
+
+    if (lua_type(L, 2) == LUA_TNUMBER) {
+      return push(L, self<T>(L, 1) * lua_tonumber(L, 2));
+    }
+
+    return push(L, self<T>(L, 1) * self<T>(L, 2));
+  }
+
+  template<class T>
+  int div(lua_State* L) {
+    if (lua_type(L, 2) == LUA_TNUMBER) {
+      return push(L, self<T>(L, 1) / lua_tonumber(L, 2));
+    }
+
+    return push(L, self<T>(L, 1) / self<T>(L, 2));
+  }
+
+  template<class T>
+  int unm(lua_State* L) {
+    return push(L, self<T>(L, 1) * -1.0);
+  }
+
+  template<class T>
+  int eq(lua_State* L) {
+    const T& lhs = self<T>(L, 1);
+    const T& rhs = self<T>(L, 2);
+
+    bool equal = true;
+    for (const auto component : type_traits<T>::components) {
+      equal = equal && lhs.*component == rhs.*component;
+    }
+
+    lua_pushboolean(L, equal);
+    return 1;
+  }
+
+  template<class T>
+  int dot(lua_State* L) {
+    lua_pushnumber(L, self<T>(L, 1).dot(self<T>(L, 2)));
+    return 1;
+  }
+
+  template<class T>
+  int length(lua_State* L) {
+    lua_pushnumber(L, self<T>(L, 1).length());
+    return 1;
+  }
+
+  template<class T>
+  int add_assign(lua_State* L) {
+    self<T>(L, 1) += self<T>(L, 2);
+    return 0;
+  }
+
+  template<class T>
+  int sub_assign(lua_State* L) {
+    self<T>(L, 1) -= self<T>(L, 2);
+    return 0;
+  }
+
+  template<class T>
+  int scale_assign(lua_State* L) {
+    self<T>(L, 1) *= number(L, 2);
+    return 0;
+  }
+
+  template<class T>
+  int set(lua_State* L) {
+    T& target = self<T>(L, 1);
+
+    int index = 2;
+    for (const auto component : type_traits<T>::components) {
+      target.*component = static_cast<real_t>(number(L, index++));
+    }
+
+    return 0;
+  }
+
+  // Returns every component as a separate number, reading a vector without one call per field
+  template<class T>
+  int unpack(lua_State* L) {
+    const T& source = self<T>(L, 1);
+
+    for (const auto component : type_traits<T>::components) {
+      lua_pushnumber(L, source.*component);
+    }
+
+    return static_cast<int>(std::size(type_traits<T>::components));
+  }
+
+}
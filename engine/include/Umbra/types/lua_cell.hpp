@@ -0,0 +1,248 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  // One Lua value in 16 bytes, the element type of the generic sequence containers. nil, booleans,
+  // integers and floats are stored inline, so storing or reading them never touches the registry.
+  // Strings, tables, userdata and functions hold a registry reference like sol::object does, taken on
+  // the main thread so the cell may outlive the coroutine that stored it.
+  //
+  // sol pushes a LuaCell, or a LuaCellView borrowing one, straight onto the stack; see sol_lua_push below.
+  class LuaCell {
+  public:
+    enum class Kind : uint8_t { NIL, BOOLEAN, INTEGER, NUMBER, REFERENCE };
+
+    LuaCell() noexcept = default;
+
+    LuaCell(const LuaCell& other) : payload_(other.payload_), kind_(other.kind_) {
+      if (kind_ == Kind::REFERENCE) {
+        lua_rawgeti(payload_.state, LUA_REGISTRYINDEX, other.reference_);
+        reference_ = luaL_ref(payload_.state, LUA_REGISTRYINDEX);
+      }
+    }
+
+    LuaCell(LuaCell&& other) noexcept : payload_(other.payload_), reference_(other.reference_), kind_(other.kind_) {
+      other.kind_ = Kind::NIL;
+      other.reference_ = LUA_NOREF;
+    }
+
+    LuaCell& operator=(const LuaCell& other) {
+      if (this != &other) {
+        LuaCell copy(other);
+        *this = std::move(copy);
+      }
+
+      return *this;
+    }
+
+    LuaCell& operator=(LuaCell&& other) noexcept {
+      if (this != &other) {
+        reset();
+        payload_ = other.payload_;
+        reference_ = other.reference_;
+        kind_ = other.kind_;
+        other.kind_ = Kind::NIL;
+        other.reference_ = LUA_NOREF;
+      }
+
+      return *this;
+    }
+
+    ~LuaCell() {
+      reset();
+    }
+
+    // Copies the value at `index`, without popping it
+    static LuaCell from_stack(lua_State* L, const int index) {
+      LuaCell cell;
+
+      switch (lua_type(L, index)) {
+        case LUA_TNONE:
+        case LUA_TNIL:
+          break;
+        case LUA_TBOOLEAN:
+          cell.kind_ = Kind::BOOLEAN;
+          cell.payload_.boolean = lua_toboolean(L, index) != 0;
+          break;
+        case LUA_TNUMBER:
+          if (lua_isinteger(L, index)) {
+            cell.kind_ = Kind::INTEGER;
+            cell.payload_.integer = lua_tointeger(L, index);
+          } else {
+            cell.kind_ = Kind::NUMBER;
+            cell.payload_.number = lua_tonumber(L, index);
+          }
+          break;
+        default: {
+          lua_State* main = sol::main_thread(L, L);
+          lua_pushvalue(L, index);
+          if (main != L) {
+            lua_xmove(L, main, 1);
+          }
+
+          cell.kind_ = Kind::REFERENCE;
+          cell.payload_.state = main;
+          cell.reference_ = luaL_ref(main, LUA_REGISTRYINDEX);
+          break;
+        }
+      }
+
+      return cell;
+    }
+
+    static LuaCell from_stack(const sol::stack_object& value) {
+      return from_stack(value.lua_state(), value.stack_index());
+    }
+
+    static const LuaCell& nil() noexcept {
+      static const LuaCell cell;
+      return cell;
+    }
+
+    Kind kind() const noexcept { return kind_; }
+    bool is_nil() const noexcept { return kind_ == Kind::NIL; }
+
+    bool boolean() const noexcept { return payload_.boolean; }
+    lua_Integer integer() const noexcept { return payload_.integer; }
+    lua_Number number() const noexcept { return payload_.number; }
+
+    void push(lua_State* L) const {
+      switch (kind_) {
+        case Kind::NIL:
+          lua_pushnil(L);
+          break;
+        case Kind::BOOLEAN:
+          lua_pushboolean(L, payload_.boolean);
+          break;
+        case Kind::INTEGER:
+          lua_pushinteger(L, payload_.integer);
+          break;
+        case Kind::NUMBER:
+          lua_pushnumber(L, payload_.number);
+          break;
+        case Kind::REFERENCE:
+          lua_rawgeti(L, LUA_REGISTRYINDEX, reference_);
+          break;
+      }
+    }
+
+    // The Lua type tag. Only references need a push to find out.
+    int type(lua_State* L) const {
+      switch (kind_) {
+        case Kind::NIL: return LUA_TNIL;
+        case Kind::BOOLEAN: return LUA_TBOOLEAN;
+        case Kind::INTEGER:
+        case Kind::NUMBER: return LUA_TNUMBER;
+        case Kind::REFERENCE: break;
+      }
+
+      push(L);
+      const int out = lua_type(L, -1);
+      lua_pop(L, 1);
+      return out;
+    }
+
+    // rawequal semantics: 1 and 1.0 are equal, references compare by identity or string contents
+    bool raw_equals(const LuaCell& other, lua_State* L) const {
+      if (kind_ != Kind::REFERENCE && other.kind_ != Kind::REFERENCE) {
+        if (kind_ == Kind::INTEGER && other.kind_ == Kind::INTEGER) {
+          return payload_.integer == other.payload_.integer;
+        }
+
+        if (kind_ == Kind::NUMBER && other.kind_ == Kind::NUMBER) {
+          return payload_.number == other.payload_.number;
+        }
+
+        if (kind_ == Kind::BOOLEAN && other.kind_ == Kind::BOOLEAN) {
+          return payload_.boolean == other.payload_.boolean;
+        }
+
+        if (kind_ == Kind::NIL || other.kind_ == Kind::NIL) {
+          return kind_ == other.kind_;
+        }
+      }
+
+      push(L);
+      other.push(L);
+      const bool out = lua_rawequal(L, -1, -2) != 0;
+      lua_pop(L, 2);
+      return out;
+    }
+
+  private:
+    union Payload {
+      bool boolean;
+      lua_Integer integer;
+      lua_Number number;
+      lua_State* state;
+    };
+
+    Payload payload_{ .integer = 0 };
+    int reference_ = LUA_NOREF;
+    Kind kind_ = Kind::NIL;
+
+    void reset() noexcept {
+      if (kind_ == Kind::REFERENCE) {
+        luaL_unref(payload_.state, LUA_REGISTRYINDEX, reference_);
+        reference_ = LUA_NOREF;
+      }
+
+      kind_ = Kind::NIL;
+    }
+  };
+
+  static_assert(sizeof(LuaCell) == 16);
+
+  // Borrows a cell for returning an element to Lua without copying it, which for a reference would
+  // take a second registry slot. Valid until the container is next modified.
+  struct LuaCellView {
+    const LuaCell* cell = &LuaCell::nil();
+  };
+
+  // sol2 customization point, found by ADL: lets bound functions return cells and take them as
+  // arguments to Lua calls
+  inline int sol_lua_push(lua_State* L, const LuaCell& cell) {
+    cell.push(L);
+    return 1;
+  }
+
+  inline int sol_lua_push(lua_State* L, const LuaCellView& view) {
+    view.cell->push(L);
+    return 1;
+  }
+
+  // Element formatting shared by the containers' __tostring: strings are quoted, everything else goes
+  // through the global tostring
+  inline void describe(std::ostream& out, const LuaCell& cell, const sol::function& to_string, lua_State* L) {
+    if (cell.type(L) == LUA_TSTRING) {
+      cell.push(L);
+      size_t length = 0;
+      const char* data = lua_tolstring(L, -1, &length);
+      out << '\'' << std::string_view(data, length) << '\'';
+      lua_pop(L, 1);
+      return;
+    }
+
+    if (!to_string.valid()) {
+      out << "<obj>";
+      return;
+    }
+
+    const sol::object value = to_string(LuaCellView{ &cell });
+    if (value.is<std::string>()) {
+      out << value.as<std::string>();
+    } else {
+      out << "<obj>";
+    }
+  }
+
+}
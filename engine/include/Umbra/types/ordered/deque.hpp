@@ -0,0 +1,349 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/lua_cell.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  // Double-ended queue over a contiguous ring buffer. The capacity is always a power of two, so a
+  // physical slot is (head_ + index) & mask, and pushing or popping at either end is O(1) amortised.
+  // Elements are LuaCells, like DynamicArray's. Slots outside [head_, head_ + size_) hold nil, so a
+  // popped value no longer pins its registry reference.
+  struct UMBRA_API Deque final : IType {
+  private:
+    static constexpr size_t MIN_CAPACITY = 8;
+
+    std::vector<LuaCell> data_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    size_t mask() const noexcept { return data_.size() - 1; }
+    size_t slot(const size_t index) const noexcept { return (head_ + index) & mask(); }
+
+    // Moves the live elements to the start of a new buffer of at least `minimum` slots
+    void reallocate(const size_t minimum) {
+      const size_t new_capacity = minimum == 0 ? 0 : std::bit_ceil(std::max(minimum, MIN_CAPACITY));
+      if (new_capacity == data_.size()) {
+        return;
+      }
+
+      std::vector<LuaCell> buffer(new_capacity);
+      for (size_t i = 0; i < size_; ++i) {
+        buffer[i] = std::move(data_[slot(i)]);
+      }
+
+      data_ = std::move(buffer);
+      head_ = 0;
+    }
+
+    void grow_for(const size_t count) {
+      if (size_ + count > data_.size()) {
+        reallocate(std::max(size_ + count, data_.size() * 2));
+      }
+    }
+
+  public:
+    const char* name() override { return "Deque"; }
+
+    Deque() noexcept = default;
+
+    int size() const noexcept { return static_cast<int>(size_); }
+    int capacity() const noexcept { return static_cast<int>(data_.size()); }
+    bool empty() const noexcept { return size_ == 0; }
+
+    void clear() noexcept {
+      for (size_t i = 0; i < size_; ++i) {
+        data_[slot(i)] = LuaCell();
+      }
+
+      head_ = 0;
+      size_ = 0;
+    }
+
+    void reserve(const int size) {
+      const auto wanted = static_cast<size_t>(std::abs(size));
+      if (wanted > data_.size()) {
+        reallocate(wanted);
+      }
+    }
+
+    void shrink_to_fit() { reallocate(size_); }
+
+    LuaCellView get(const int index) const noexcept {
+      if (index < 1 || index > size()) {
+        return {};
+      }
+
+      return { &data_[slot(static_cast<size_t>(index - 1))] };
+    }
+
+    void set(const int index, const sol::stack_object value) {
+      if (index < 1 || index > size()) {
+        return;
+      }
+
+      data_[slot(static_cast<size_t>(index - 1))] = LuaCell::from_stack(value);
+    }
+
+    LuaCellView front() const noexcept {
+      return get(1);
+    }
+
+    LuaCellView back() const noexcept {
+      return get(size());
+    }
+
+    void push_back(const sol::stack_object value) {
+      grow_for(1);
+      data_[slot(size_)] = LuaCell::from_stack(value);
+      size_++;
+    }
+
+    void push_front(const sol::stack_object value) {
+      grow_for(1);
+      head_ = (head_ - 1) & mask();
+      data_[head_] = LuaCell::from_stack(value);
+      size_++;
+    }
+
+    LuaCell pop_back() noexcept {
+      if (size_ == 0) {
+        return {};
+      }
+
+      size_--;
+      return std::move(data_[slot(size_)]);
+    }
+
+    LuaCell pop_front() noexcept {
+      if (size_ == 0) {
+        return {};
+      }
+
+      LuaCell value = std::move(data_[head_]);
+      head_ = (head_ + 1) & mask();
+      size_--;
+      return value;
+    }
+
+    // Shifts whichever side of `index` is shorter, so inserting near either end stays cheap
+    void insert(const int index, const sol::stack_object value) {
+      if (index < 1 || index > size() + 1) {
+        push_back(value);
+        return;
+      }
+
+      grow_for(1);
+
+      const auto position = static_cast<size_t>(index - 1);
+      if (position < size_ / 2) {
+        head_ = (head_ - 1) & mask();
+        for (size_t i = 0; i < position; ++i) {
+          data_[slot(i)] = std::move(data_[slot(i + 1)]);
+        }
+      } else {
+        for (size_t i = size_; i > position; --i) {
+          data_[slot(i)] = std::move(data_[slot(i - 1)]);
+        }
+      }
+
+      data_[slot(position)] = LuaCell::from_stack(value);
+      size_++;
+    }
+
+    void erase(const int index) noexcept {
+      if (index < 1 || index > size()) {
+        return;
+      }
+
+      const auto position = static_cast<size_t>(index - 1);
+      if (position < size_ / 2) {
+        for (size_t i = position; i > 0; --i) {
+          data_[slot(i)] = std::move(data_[slot(i - 1)]);
+        }
+
+        data_[head_] = LuaCell();
+        head_ = (head_ + 1) & mask();
+      } else {
+        for (size_t i = position; i + 1 < size_; ++i) {
+          data_[slot(i)] = std::move(data_[slot(i + 1)]);
+        }
+
+        data_[slot(size_ - 1)] = LuaCell();
+      }
+
+      size_--;
+    }
+
+    Deque concat(const Deque& other) const {
+      Deque out;
+      out.reallocate(size_ + other.size_);
+
+      for (size_t i = 0; i < size_; ++i) {
+        out.data_[out.size_++] = data_[slot(i)];
+      }
+
+      for (size_t i = 0; i < other.size_; ++i) {
+        out.data_[out.size_++] = other.data_[other.slot(i)];
+      }
+
+      return out;
+    }
+
+    static Deque from_table(const sol::table& table) {
+      Deque out;
+      const size_t size = table.size();
+
+      out.reallocate(size);
+
+      lua_State* L = table.lua_state();
+      table.push(L);
+      for (size_t i = 1; i <= size; ++i) {
+        lua_geti(L, -1, static_cast<lua_Integer>(i));
+        out.data_[out.size_++] = LuaCell::from_stack(L, -1);
+        lua_pop(L, 1);
+      }
+      lua_pop(L, 1);
+
+      return out;
+    }
+
+    sol::table to_table(const sol::this_state this_state) const {
+      lua_State* L = this_state;
+      lua_createtable(L, size(), 0);
+
+      for (size_t i = 0; i < size_; ++i) {
+        data_[slot(i)].push(L);
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+      }
+
+      return sol::stack::pop<sol::table>(L);
+    }
+
+    bool equals(const Deque& other, const sol::this_state this_state) const {
+      if (size_ != other.size_) {
+        return false;
+      }
+
+      for (size_t i = 0; i < size_; ++i) {
+        if (!data_[slot(i)].raw_equals(other.data_[other.slot(i)], this_state)) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    std::string to_string(const sol::this_state this_state) const {
+      sol::state_view state_view(this_state);
+      const sol::function to_string = state_view["tostring"];
+      std::ostringstream string_stream;
+
+      string_stream << "Deque(";
+      for (size_t i = 0; i < size_; ++i) {
+        if (i) {
+          string_stream << ", ";
+        }
+
+        describe(string_stream, data_[slot(i)], to_string, this_state);
+      }
+      string_stream << ")";
+
+      return string_stream.str();
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<Deque> user_type = lua_state.new_usertype<Deque>(name(),
+        sol::constructors<Deque()>(),
+        "size", &Deque::size,
+        "capacity", &Deque::capacity,
+        "empty", &Deque::empty,
+        "clear", &Deque::clear,
+        "reserve", &Deque::reserve,
+        "shrink_to_fit", &Deque::shrink_to_fit,
+        "get", &Deque::get,
+        "set", &Deque::set,
+        "front", &Deque::front,
+        "back", &Deque::back,
+        "push_back", &Deque::push_back,
+        "push_front", &Deque::push_front,
+        "pop_front", &Deque::pop_front,
+        "pop_back", &Deque::pop_back,
+        "insert", &Deque::insert,
+        "erase", &Deque::erase,
+        "from_table", &Deque::from_table,
+        "to_table", &Deque::to_table
+      );
+
+      user_type[sol::meta_function::length] = [](const Deque& deque) {
+        return deque.size();
+      };
+
+      user_type[sol::meta_function::addition] = [](const Deque& first, const Deque& second) {
+        return first.concat(second);
+      };
+
+      user_type[sol::meta_function::equal_to] = [](const Deque& first, const Deque& second, const sol::this_state this_state) {
+        return first.equals(second, this_state);
+      };
+
+      user_type[sol::meta_function::to_string] = [](const Deque& deque, const sol::this_state this_state) {
+        return deque.to_string(this_state);
+      };
+
+      user_type[sol::meta_function::index] = [](const Deque& deque, const sol::stack_object key) {
+        if (key.is<int>()) {
+          const int index = key.as<int>();
+          return deque.get(index);
+        }
+
+        if (key.is<double>()) {
+          const int index = static_cast<int>(key.as<double>());
+          return deque.get(index);
+        }
+
+        return LuaCellView();
+      };
+
+      user_type[sol::meta_function::ipairs] = [](const Deque& deque) {
+        auto iter = [](const Deque& deque_to_iter, const int i) -> std::tuple<std::optional<int>, LuaCellView> {
+          const int next = i + 1;
+          if (next > deque_to_iter.size()) {
+            return { std::nullopt, LuaCellView() };
+          }
+
+          const LuaCellView value = deque_to_iter.get(next);
+          if (value.cell->is_nil()) {
+            return { std::nullopt, LuaCellView() };
+          }
+
+          return { next, value };
+        };
+
+        return std::make_tuple(iter, std::ref(deque), 0);
+      };
+
+      user_type[sol::meta_function::pairs] = [](const Deque& deque) {
+        auto iter = [](const Deque& deque_to_iter, const int i) -> std::tuple<std::optional<int>, LuaCellView> {
+          const int next = i + 1;
+          if (next > deque_to_iter.size()) {
+            return { std::nullopt, LuaCellView() };
+          }
+
+          return { next, deque_to_iter.get(next) };
+        };
+
+        return std::make_tuple(iter, std::ref(deque), 0);
+      };
+    }
+  };
+
+}
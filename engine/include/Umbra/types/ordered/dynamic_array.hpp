@@ -1,8 +1,11 @@
 #pragma once
 
 #include "Umbra/types.hpp"
+#include "Umbra/types/lua_cell.hpp"
+#include "Umbra/types/ordered/ordering.hpp"
 
 #include <algorithm>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -10,9 +13,13 @@
 
 namespace umbra {
 
+  // Elements are LuaCells, so numbers and booleans are stored inline rather than in the registry
   struct UMBRA_API DynamicArray final : IType {
   private:
-    std::vector<sol::object> data_;
+    std::vector<LuaCell> data_;
+
+    // Held while sorting, searching or partitioning, so a comparator cannot resize data_ under them
+    ordering::Lock lock_;
 
   public:
     const char* name() override { return "DynamicArray"; }
@@ -23,60 +30,82 @@ namespace umbra {
     int capacity() const noexcept { return static_cast<int>(data_.capacity()); }
     bool empty() const noexcept { return data_.empty(); }
 
-    void clear() noexcept { data_.clear(); }
-    void reserve(const int size) { data_.reserve(std::abs(size)); }
-    void shrink_to_fit() { data_.shrink_to_fit(); }
+    void clear() {
+      lock_.check(name(), "clear");
+      data_.clear();
+    }
 
-    sol::object get(const int index, const sol::this_state this_state) const noexcept {
+    void reserve(const int size) {
+      lock_.check(name(), "reserve");
+      data_.reserve(std::abs(size));
+    }
+
+    void shrink_to_fit() {
+      lock_.check(name(), "shrink_to_fit");
+      data_.shrink_to_fit();
+    }
+
+    LuaCellView get(const int index) const noexcept {
       if (index < 1 || index > size()) {
-        return make_object(this_state, sol::lua_nil);
+        return {};
       }
 
-      return data_[static_cast<size_t>(index - 1)];
+      return { &data_[static_cast<size_t>(index - 1)] };
     }
 
-    void set(const int index, sol::object value) noexcept {
+    void set(const int index, const sol::stack_object value) {
       if (index < 1 || index > size()) {
         return;
       }
 
-      data_[static_cast<size_t>(index - 1)] = std::move(value);
+      data_[static_cast<size_t>(index - 1)] = LuaCell::from_stack(value);
+    }
+
+    void push_back(const sol::stack_object value) {
+      lock_.check(name(), "push_back");
+      data_.emplace_back(LuaCell::from_stack(value));
     }
 
-    void push_back(sol::object value) { data_.emplace_back(std::move(value)); }
-    void push_front(sol::object value) { data_.emplace(data_.begin(), std::move(value)); }
+    void push_front(const sol::stack_object value) {
+      lock_.check(name(), "push_front");
+      data_.emplace(data_.begin(), LuaCell::from_stack(value));
+    }
 
-    sol::object pop_back(const sol::this_state this_state) noexcept {
+    LuaCell pop_back() {
+      lock_.check(name(), "pop_back");
       if (data_.empty()) {
-        return make_object(this_state, sol::lua_nil);
+        return {};
       }
 
-      sol::object value = std::move(data_.back());
+      LuaCell value = std::move(data_.back());
       data_.pop_back();
       return value;
     }
 
-    sol::object pop_front(const sol::this_state this_state) noexcept {
+    LuaCell pop_front() {
+      lock_.check(name(), "pop_front");
       if (data_.empty()) {
-        return make_object(this_state, sol::lua_nil);
+        return {};
       }
 
-      sol::object value = std::move(data_.front());
+      LuaCell value = std::move(data_.front());
       data_.erase(data_.begin());
       return value;
     }
 
-    void insert(const int index, sol::object value) {
+    void insert(const int index, const sol::stack_object value) {
+      lock_.check(name(), "insert");
       const size_t data_size = size();
 
       if (index >= 1 && index <= static_cast<int>(data_size + 1)) {
-        data_.insert(data_.begin() + (index - 1), std::move(value));
+        data_.insert(data_.begin() + (index - 1), LuaCell::from_stack(value));
       } else {
-        data_.emplace_back(std::move(value));
+        data_.emplace_back(LuaCell::from_stack(value));
       }
     }
 
-    void erase(const int index) noexcept {
+    void erase(const int index) {
+      lock_.check(name(), "erase");
       const size_t data_size = size();
       if (index < 1 || index > data_size) {
         return;
@@ -99,15 +128,28 @@ namespace umbra {
 
       out.data_.reserve(size);
 
+      lua_State* L = table.lua_state();
+      table.push(L);
       for (size_t i = 1; i <= size; ++i) {
-        out.data_.emplace_back(table.get<sol::object>(i));
+        lua_geti(L, -1, static_cast<lua_Integer>(i));
+        out.data_.emplace_back(LuaCell::from_stack(L, -1));
+        lua_pop(L, 1);
       }
+      lua_pop(L, 1);
 
       return out;
     }
 
-    sol::as_table_t<std::vector<sol::object>> to_table() const {
-      return as_table(data_);
+    sol::table to_table(const sol::this_state this_state) const {
+      lua_State* L = this_state;
+      lua_createtable(L, size(), 0);
+
+      for (size_t i = 0; i < data_.size(); ++i) {
+        data_[i].push(L);
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+      }
+
+      return sol::stack::pop<sol::table>(L);
     }
 
     bool equals(const DynamicArray& other, const sol::this_state this_state) const {
@@ -115,23 +157,50 @@ namespace umbra {
         return false;
       }
 
-      sol::state_view state_view(this_state);
-      const sol::function raw_equal = state_view["rawequal"];
       for (size_t i = 0; i < data_.size(); ++i) {
-        if (raw_equal.valid()) {
-          if (!raw_equal(data_[i], other.data_[i])) {
-            return false;
-          }
-        } else {
-          if (data_[i] != other.data_[i]) {
-            return false;
-          }
+        if (!data_[i].raw_equals(other.data_[i], this_state)) {
+          return false;
         }
       }
 
       return true;
     }
 
+    void sort(const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      const ordering::Lock::Scope scope = lock_.hold();
+      ordering::sort_cells(std::span(data_), comparator, this_state, name());
+    }
+
+    void stable_sort(const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      const ordering::Lock::Scope scope = lock_.hold();
+      ordering::sort_cells(std::span(data_), comparator, this_state, name());
+    }
+
+    int lower_bound(const sol::stack_object value, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      const ordering::Lock::Scope scope = lock_.hold();
+      return ordering::lower_bound(std::span<const LuaCell>(data_), value, comparator, this_state, name());
+    }
+
+    int upper_bound(const sol::stack_object value, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      const ordering::Lock::Scope scope = lock_.hold();
+      return ordering::upper_bound(std::span<const LuaCell>(data_), value, comparator, this_state, name());
+    }
+
+    bool binary_search(const sol::stack_object value, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      const ordering::Lock::Scope scope = lock_.hold();
+      return ordering::binary_search(std::span<const LuaCell>(data_), value, comparator, this_state, name());
+    }
+
+    int partition(const sol::protected_function& predicate) {
+      const ordering::Lock::Scope scope = lock_.hold();
+      return ordering::partition(std::span(data_), predicate, name());
+    }
+
+    void nth_element(const int n, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      const ordering::Lock::Scope scope = lock_.hold();
+      ordering::nth_element(std::span(data_), n, comparator, this_state, name());
+    }
+
     std::string to_string(const sol::this_state this_state) const {
       sol::state_view state_view(this_state);
       const sol::function to_string = state_view["tostring"];
@@ -143,21 +212,7 @@ namespace umbra {
           string_stream << ", ";
         }
 
-        if (data_[i].is<std::string>()) {
-          string_stream << '\'' << data_[i].as<std::string>() << '\'';
-          continue;
-        }
-
-        if (to_string.valid()) {
-          sol::object value = to_string(data_[i]);
-          if (value.is<std::string>()) {
-            string_stream << value.as<std::string>();
-          } else {
-            string_stream << "<obj>";
-          }
-        } else {
-          string_stream << "<obj>";
-        }
+        describe(string_stream, data_[i], to_string, this_state);
       }
       string_stream << ")";
 
@@ -182,7 +237,14 @@ namespace umbra {
         "insert", &DynamicArray::insert,
         "erase", &DynamicArray::erase,
         "from_table", &DynamicArray::from_table,
-        "to_table", &DynamicArray::to_table
+        "to_table", &DynamicArray::to_table,
+        "sort", &DynamicArray::sort,
+        "stable_sort", &DynamicArray::stable_sort,
+        "lower_bound", &DynamicArray::lower_bound,
+        "upper_bound", &DynamicArray::upper_bound,
+        "binary_search", &DynamicArray::binary_search,
+        "partition", &DynamicArray::partition,
+        "nth_element", &DynamicArray::nth_element
       );
 
       user_type[sol::meta_function::length] = [](const DynamicArray& dynamic_array) {
@@ -201,49 +263,46 @@ namespace umbra {
         return dynamic_array.to_string(this_state);
       };
 
-      user_type[sol::meta_function::index] = [](const DynamicArray& dynamic_array, const sol::stack_object key, const sol::this_state this_state) {
+      user_type[sol::meta_function::index] = [](const DynamicArray& dynamic_array, const sol::stack_object key) {
         if (key.is<int>()) {
           const int index = key.as<int>();
-          return dynamic_array.get(index, this_state);
+          return dynamic_array.get(index);
         }
 
         if (key.is<double>()) {
           const int index = static_cast<int>(key.as<double>());
-          return dynamic_array.get(index, this_state);
+          return dynamic_array.get(index);
         }
 
-        return make_object(this_state, sol::lua_nil);
+        return LuaCellView();
       };
 
-      user_type[sol::meta_function::ipairs] = [](const DynamicArray& dynamic_array, const sol::this_state this_state) {
-        auto iter = [this_state](const DynamicArray& dynamic_array_to_iter, const int i) -> std::tuple<sol::object, sol::object> {
+      user_type[sol::meta_function::ipairs] = [](const DynamicArray& dynamic_array) {
+        auto iter = [](const DynamicArray& dynamic_array_to_iter, const int i) -> std::tuple<std::optional<int>, LuaCellView> {
           const int next = i + 1;
           if (next > dynamic_array_to_iter.size()) {
-            sol::object nil = make_object(this_state, sol::lua_nil);
-            return { nil, nil };
+            return { std::nullopt, LuaCellView() };
           }
 
-          sol::object value = dynamic_array_to_iter.get(next, this_state);
-          if (value.is<sol::lua_nil_t>()) {
-            sol::object nil = make_object(this_state, sol::lua_nil);
-            return { value, nil };
+          const LuaCellView value = dynamic_array_to_iter.get(next);
+          if (value.cell->is_nil()) {
+            return { std::nullopt, LuaCellView() };
           }
 
-          return { make_object(this_state, next), value };
+          return { next, value };
         };
 
         return std::make_tuple(iter, std::ref(dynamic_array), 0);
       };
 
-      user_type[sol::meta_function::pairs] = [](const DynamicArray& dynamic_array, const sol::this_state this_state) {
-        auto iter = [this_state](const DynamicArray& dynamic_array_to_iter, const int i) -> std::tuple<sol::object, sol::object> {
+      user_type[sol::meta_function::pairs] = [](const DynamicArray& dynamic_array) {
+        auto iter = [](const DynamicArray& dynamic_array_to_iter, const int i) -> std::tuple<std::optional<int>, LuaCellView> {
           const int next = i + 1;
           if (next > dynamic_array_to_iter.size()) {
-            sol::object nil = make_object(this_state, sol::lua_nil);
-            return { nil, nil };
+            return { std::nullopt, LuaCellView() };
           }
 
-          return { make_object(this_state, next), dynamic_array_to_iter.get(next, this_state) };
+          return { next, dynamic_array_to_iter.get(next) };
         };
 
         return std::make_tuple(iter, std::ref(dynamic_array), 0);
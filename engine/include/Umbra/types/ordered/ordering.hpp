@@ -0,0 +1,433 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/lua_cell.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra::ordering {
+
+  // Sorting, searching and partitioning shared by the sequence types. Positions are 1-based, like the
+  // rest of the container API.
+  //
+  // Without a comparator, elements that are all numbers or all strings are sorted by keys extracted
+  // once up front, so the sort itself never calls into Lua and can run on several threads. With a
+  // comparator, every comparison is a Lua call. Those sorts work on a vector of indices and permute the
+  // elements only after the comparator has finished without error, so a failing or inconsistent
+  // comparator never leaves the container half sorted. They use merge sort because it cannot run out of
+  // bounds when the comparator is inconsistent.
+
+  // Held by a growable container while its cells are being ordered. Comparators and predicates are Lua
+  // code that can reach the container, and the functions below keep pointers into its storage across
+  // those calls, so the container's methods that reallocate or shrink call check() and fail instead.
+  // A copied container starts unlocked.
+  class Lock final {
+  public:
+    class Scope final {
+    public:
+      explicit Scope(Lock& lock) noexcept : lock_(lock), previous_(lock.held_) {
+        lock_.held_ = true;
+      }
+
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+
+      ~Scope() {
+        lock_.held_ = previous_;
+      }
+
+    private:
+      Lock& lock_;
+      bool previous_;
+    };
+
+    Lock() noexcept = default;
+    Lock(const Lock&) noexcept {}
+    Lock& operator=(const Lock&) noexcept { return *this; }
+
+    Scope hold() noexcept { return Scope(*this); }
+
+    void check(const char* owner, const char* operation) const {
+      if (held_) {
+        umbra_fail(std::string(owner) + ": cannot " + operation + " while a comparator or predicate is running");
+      }
+    }
+
+  private:
+    bool held_ = false;
+  };
+
+  // Below this many elements a single-threaded sort is faster than fanning out
+  inline constexpr size_t PARALLEL_THRESHOLD = size_t{ 1 } << 15;
+
+  // Sorts the chunks on separate threads, then merges them pairwise, with each pass's merges also in
+  // parallel. `compare` must be safe to call from several threads.
+  template<class T, class Compare>
+  void sort(const std::span<T> values, Compare compare) {
+    const size_t count = values.size();
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunks = std::bit_floor(std::min(hardware, count / (PARALLEL_THRESHOLD / 2)));
+
+    if (count < PARALLEL_THRESHOLD || chunks < 2) {
+      std::sort(values.begin(), values.end(), compare);
+      return;
+    }
+
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t i = 0; i <= chunks; ++i) {
+      bounds[i] = count * i / chunks;
+    }
+
+    const auto begin = values.begin();
+
+    {
+      std::vector<std::jthread> workers;
+      for (size_t i = 1; i < chunks; ++i) {
+        workers.emplace_back([=] {
+          std::sort(begin + bounds[i], begin + bounds[i + 1], compare);
+        });
+      }
+
+      std::sort(begin + bounds[0], begin + bounds[1], compare);
+    }
+
+    for (size_t width = 1; width < chunks; width *= 2) {
+      std::vector<std::jthread> workers;
+      for (size_t i = 0; i + width < chunks; i += 2 * width) {
+        const auto first = begin + bounds[i];
+        const auto middle = begin + bounds[i + width];
+        const auto last = begin + bounds[std::min(i + 2 * width, chunks)];
+
+        workers.emplace_back([=] {
+          std::inplace_merge(first, middle, last, compare);
+        });
+      }
+    }
+  }
+
+  // Orders NaN after every other number, which keeps the order strict and weak
+  template<class T>
+  bool number_less(const T a, const T b) noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+      return a < b || (b != b && a == a);
+    } else {
+      return a < b;
+    }
+  }
+
+  // The value of one element. String views point into the Lua string, which the element's registry
+  // reference, or the argument's stack slot, keeps alive.
+  struct Key {
+    int type = LUA_TNIL;
+    bool is_integer = false;
+    lua_Integer integer = 0;
+    double number = 0.0;
+    std::string_view string;
+  };
+
+  inline Key read_key(lua_State* L, const int index) {
+    Key key;
+    key.type = lua_type(L, index);
+
+    if (key.type == LUA_TNUMBER) {
+      key.is_integer = lua_isinteger(L, index);
+      key.integer = lua_tointeger(L, index);
+      key.number = lua_tonumber(L, index);
+    } else if (key.type == LUA_TSTRING) {
+      size_t length = 0;
+      const char* data = lua_tolstring(L, index, &length);
+      key.string = std::string_view(data, length);
+    }
+
+    return key;
+  }
+
+  // Inline values are read straight from the cell; only references go through the stack
+  inline Key read_key(lua_State* L, const LuaCell& cell) {
+    Key key;
+
+    switch (cell.kind()) {
+      case LuaCell::Kind::NIL:
+        return key;
+      case LuaCell::Kind::BOOLEAN:
+        key.type = LUA_TBOOLEAN;
+        return key;
+      case LuaCell::Kind::INTEGER:
+        key.type = LUA_TNUMBER;
+        key.is_integer = true;
+        key.integer = cell.integer();
+        key.number = static_cast<double>(cell.integer());
+        return key;
+      case LuaCell::Kind::NUMBER:
+        key.type = LUA_TNUMBER;
+        key.number = cell.number();
+        return key;
+      case LuaCell::Kind::REFERENCE:
+        break;
+    }
+
+    cell.push(L);
+    key = read_key(L, -1);
+    lua_pop(L, 1);
+    return key;
+  }
+
+  inline Key read_key(const sol::stack_object& value) {
+    return read_key(value.lua_state(), value.stack_index());
+  }
+
+  // Lua's default order for numbers and strings. Strings compare bytewise rather than with strcoll.
+  inline bool key_less(const Key& a, const Key& b, const char* owner) {
+    if (a.type == LUA_TNUMBER && b.type == LUA_TNUMBER) {
+      if (a.is_integer && b.is_integer) {
+        return a.integer < b.integer;
+      }
+
+      return number_less(a.number, b.number);
+    }
+
+    if (a.type == LUA_TSTRING && b.type == LUA_TSTRING) {
+      return a.string < b.string;
+    }
+
+    umbra_fail(std::string(owner) + ": attempt to compare " + lua_typename(nullptr, a.type) + " with " + lua_typename(nullptr, b.type));
+  }
+
+  template<class A, class B>
+  bool call(const sol::protected_function& function, const A& a, const B& b, const char* owner) {
+    sol::protected_function_result result = function(a, b);
+    if (!result.valid()) {
+      const sol::error error = result;
+      umbra_fail(std::string(owner) + ": comparator failed: " + error.what());
+    }
+
+    return result.get<bool>();
+  }
+
+  // Moves cells[order[0]], cells[order[1]], ... into place
+  inline void permute(const std::span<LuaCell> cells, const std::span<const uint32_t> order) {
+    std::vector<LuaCell> sorted;
+    sorted.reserve(cells.size());
+
+    for (const uint32_t index : order) {
+      sorted.push_back(std::move(cells[index]));
+    }
+
+    std::move(sorted.begin(), sorted.end(), cells.begin());
+  }
+
+  // Sorts (key, original position) pairs. The position breaks ties, so the result is stable even
+  // though the sort itself is not.
+  template<class K, class Less>
+  void sort_keyed(const std::span<LuaCell> cells, std::vector<std::pair<K, uint32_t>>& keyed, Less less) {
+    ordering::sort(std::span(keyed), [less](const std::pair<K, uint32_t>& a, const std::pair<K, uint32_t>& b) {
+      if (less(a.first, b.first)) {
+        return true;
+      }
+
+      if (less(b.first, a.first)) {
+        return false;
+      }
+
+      return a.second < b.second;
+    });
+
+    std::vector<uint32_t> order(keyed.size());
+    for (size_t i = 0; i < keyed.size(); ++i) {
+      order[i] = keyed[i].second;
+    }
+
+    permute(cells, order);
+  }
+
+  // Extracts keys and sorts by them when every element is an integer, a number or a string. Returns
+  // false, leaving the cells untouched, when the elements are of any other or mixed types.
+  inline bool sort_fast(const std::span<LuaCell> cells, lua_State* L) {
+    std::vector<Key> keys(cells.size());
+
+    bool integers = true;
+    bool numbers = true;
+    bool strings = true;
+    for (size_t i = 0; i < cells.size(); ++i) {
+      keys[i] = read_key(L, cells[i]);
+      integers = integers && keys[i].type == LUA_TNUMBER && keys[i].is_integer;
+      numbers = numbers && keys[i].type == LUA_TNUMBER;
+      strings = strings && keys[i].type == LUA_TSTRING;
+    }
+
+    if (integers) {
+      std::vector<std::pair<lua_Integer, uint32_t>> keyed(keys.size());
+      for (size_t i = 0; i < keys.size(); ++i) {
+        keyed[i] = { keys[i].integer, static_cast<uint32_t>(i) };
+      }
+
+      sort_keyed(cells, keyed, [](const lua_Integer a, const lua_Integer b) { return a < b; });
+      return true;
+    }
+
+    if (numbers) {
+      std::vector<std::pair<double, uint32_t>> keyed(keys.size());
+      for (size_t i = 0; i < keys.size(); ++i) {
+        keyed[i] = { keys[i].number, static_cast<uint32_t>(i) };
+      }
+
+      sort_keyed(cells, keyed, number_less<double>);
+      return true;
+    }
+
+    if (strings) {
+      std::vector<std::pair<std::string_view, uint32_t>> keyed(keys.size());
+      for (size_t i = 0; i < keys.size(); ++i) {
+        keyed[i] = { keys[i].string, static_cast<uint32_t>(i) };
+      }
+
+      sort_keyed(cells, keyed, [](const std::string_view a, const std::string_view b) { return a < b; });
+      return true;
+    }
+
+    return false;
+  }
+
+  // Sorts with a comparator, or in Lua's default order. Every path is stable, so the containers'
+  // sort and stable_sort share this.
+  inline void sort_cells(const std::span<LuaCell> cells, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state, const char* owner) {
+    if (cells.size() < 2) {
+      return;
+    }
+
+    if (!comparator && ordering::sort_fast(cells, this_state)) {
+      return;
+    }
+
+    std::vector<uint32_t> order(cells.size());
+    std::iota(order.begin(), order.end(), 0u);
+
+    if (comparator) {
+      std::stable_sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) {
+        return call(*comparator, LuaCellView{ &cells[a] }, LuaCellView{ &cells[b] }, owner);
+      });
+    } else {
+      // Mixed element types: key_less fails on the first pair it cannot order, as table.sort would
+      std::vector<Key> keys(cells.size());
+      for (size_t i = 0; i < cells.size(); ++i) {
+        keys[i] = read_key(this_state, cells[i]);
+      }
+
+      std::stable_sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) {
+        return key_less(keys[a], keys[b], owner);
+      });
+    }
+
+    permute(cells, order);
+  }
+
+  // First position whose element is not less than `value`, or size + 1
+  inline int lower_bound(const std::span<const LuaCell> cells, const sol::stack_object& value, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state, const char* owner) {
+    if (comparator) {
+      const auto it = std::lower_bound(cells.begin(), cells.end(), value, [&](const LuaCell& element, const sol::stack_object& target) {
+        return call(*comparator, LuaCellView{ &element }, target, owner);
+      });
+      return static_cast<int>(it - cells.begin()) + 1;
+    }
+
+    const Key target = read_key(value);
+    const auto it = std::lower_bound(cells.begin(), cells.end(), target, [&](const LuaCell& element, const Key& key) {
+      return key_less(read_key(this_state, element), key, owner);
+    });
+    return static_cast<int>(it - cells.begin()) + 1;
+  }
+
+  // First position whose element is greater than `value`, or size + 1
+  inline int upper_bound(const std::span<const LuaCell> cells, const sol::stack_object& value, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state, const char* owner) {
+    if (comparator) {
+      const auto it = std::upper_bound(cells.begin(), cells.end(), value, [&](const sol::stack_object& target, const LuaCell& element) {
+        return call(*comparator, target, LuaCellView{ &element }, owner);
+      });
+      return static_cast<int>(it - cells.begin()) + 1;
+    }
+
+    const Key target = read_key(value);
+    const auto it = std::upper_bound(cells.begin(), cells.end(), target, [&](const Key& key, const LuaCell& element) {
+      return key_less(key, read_key(this_state, element), owner);
+    });
+    return static_cast<int>(it - cells.begin()) + 1;
+  }
+
+  inline bool binary_search(const std::span<const LuaCell> cells, const sol::stack_object& value, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state, const char* owner) {
+    const int position = ordering::lower_bound(cells, value, comparator, this_state, owner);
+    if (position > static_cast<int>(cells.size())) {
+      return false;
+    }
+
+    const LuaCell& found = cells[position - 1];
+    if (comparator) {
+      return !call(*comparator, value, LuaCellView{ &found }, owner);
+    }
+
+    return !key_less(read_key(value), read_key(this_state, found), owner);
+  }
+
+  // Moves the elements for which `predicate` is true in front of the others, keeping their relative
+  // order. The predicate runs once per element, front to back. Returns the position of the first
+  // element of the second group, or size + 1.
+  inline int partition(const std::span<LuaCell> cells, const sol::protected_function& predicate, const char* owner) {
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> rejected;
+    order.reserve(cells.size());
+
+    for (size_t i = 0; i < cells.size(); ++i) {
+      sol::protected_function_result result = predicate(LuaCellView{ &cells[i] });
+      if (!result.valid()) {
+        const sol::error error = result;
+        umbra_fail(std::string(owner) + ": predicate failed: " + error.what());
+      }
+
+      (result.get<bool>() ? order : rejected).push_back(static_cast<uint32_t>(i));
+    }
+
+    const int boundary = static_cast<int>(order.size()) + 1;
+    order.insert(order.end(), rejected.begin(), rejected.end());
+    permute(cells, order);
+
+    return boundary;
+  }
+
+  // Puts the element that belongs at position `n` there, with nothing greater before it and nothing
+  // smaller after it. With a comparator this falls back to a full merge sort, for the reason above.
+  inline void nth_element(const std::span<LuaCell> cells, const int n, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state, const char* owner) {
+    if (n < 1 || n > static_cast<int>(cells.size())) {
+      return;
+    }
+
+    if (comparator) {
+      sort_cells(cells, comparator, this_state, owner);
+      return;
+    }
+
+    std::vector<Key> keys(cells.size());
+    for (size_t i = 0; i < cells.size(); ++i) {
+      keys[i] = read_key(this_state, cells[i]);
+    }
+
+    std::vector<uint32_t> order(cells.size());
+    std::iota(order.begin(), order.end(), 0u);
+
+    // key_less is a strict weak order or it fails, so introselect is safe here
+    std::nth_element(order.begin(), order.begin() + (n - 1), order.end(), [&](const uint32_t a, const uint32_t b) {
+      return key_less(keys[a], keys[b], owner);
+    });
+
+    permute(cells, order);
+  }
+
+}
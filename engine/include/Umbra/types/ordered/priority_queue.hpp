@@ -0,0 +1,333 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/lua_cell.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  // Min-priority queue over a 4-ary heap. The heap array holds only the unboxed priority, an insertion
+  // sequence and a handle, 16 bytes per entry, so sifting never touches a Lua value. Payloads are
+  // LuaCells in a separate slot array, which lets the heap move entries around cheaply.
+  //
+  // push returns a handle that stays valid until its entry is popped or removed. Each handle carries
+  // the slot's generation, so a stale handle is rejected instead of addressing a reused slot. Equal
+  // priorities pop in insertion order.
+  struct UMBRA_API PriorityQueue final : IType {
+  private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t ARITY = 4;
+
+    struct Entry {
+      double priority;
+      uint32_t sequence;
+      uint32_t slot;
+    };
+
+    struct Slot {
+      LuaCell value;
+      uint32_t position = NONE;
+      uint32_t generation = 0;
+    };
+
+    std::vector<Entry> heap_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_;
+    uint32_t sequence_ = 0;
+
+    static bool before(const Entry& a, const Entry& b) noexcept {
+      if (a.priority != b.priority) {
+        return a.priority < b.priority;
+      }
+
+      // Wrapping difference, so insertion order survives the sequence counter overflowing
+      return static_cast<int32_t>(a.sequence - b.sequence) < 0;
+    }
+
+    void place(const size_t position, const Entry& entry) noexcept {
+      heap_[position] = entry;
+      slots_[entry.slot].position = static_cast<uint32_t>(position);
+    }
+
+    void sift_up(size_t position) noexcept {
+      const Entry entry = heap_[position];
+
+      while (position > 0) {
+        const size_t parent = (position - 1) / ARITY;
+        if (!before(entry, heap_[parent])) {
+          break;
+        }
+
+        place(position, heap_[parent]);
+        position = parent;
+      }
+
+      place(position, entry);
+    }
+
+    void sift_down(size_t position) noexcept {
+      const Entry entry = heap_[position];
+      const size_t count = heap_.size();
+
+      while (true) {
+        const size_t first = position * ARITY + 1;
+        if (first >= count) {
+          break;
+        }
+
+        size_t best = first;
+        const size_t last = std::min(first + ARITY, count);
+        for (size_t child = first + 1; child < last; ++child) {
+          if (before(heap_[child], heap_[best])) {
+            best = child;
+          }
+        }
+
+        if (!before(heap_[best], entry)) {
+          break;
+        }
+
+        place(position, heap_[best]);
+        position = best;
+      }
+
+      place(position, entry);
+    }
+
+    uint32_t acquire_slot(LuaCell value) {
+      uint32_t slot;
+      if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+      } else {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+      }
+
+      slots_[slot].value = std::move(value);
+      return slot;
+    }
+
+    LuaCell release_slot(const uint32_t slot) {
+      LuaCell value = std::move(slots_[slot].value);
+      slots_[slot].position = NONE;
+      slots_[slot].generation++;
+      free_.push_back(slot);
+      return value;
+    }
+
+    // Removes the entry at `position` from the heap and returns its slot
+    uint32_t remove_at(const size_t position) noexcept {
+      const uint32_t slot = heap_[position].slot;
+      const Entry last = heap_.back();
+      heap_.pop_back();
+
+      if (position < heap_.size()) {
+        place(position, last);
+        sift_down(position);
+        sift_up(slots_[last.slot].position);
+      }
+
+      return slot;
+    }
+
+    static int64_t make_handle(const uint32_t slot, const uint32_t generation) noexcept {
+      return static_cast<int64_t>((static_cast<uint64_t>(generation) << 32) | slot);
+    }
+
+    // Slot for a live handle, or NONE
+    uint32_t resolve(const int64_t handle) const noexcept {
+      const auto slot = static_cast<uint32_t>(static_cast<uint64_t>(handle) & 0xFFFFFFFFu);
+      const auto generation = static_cast<uint32_t>(static_cast<uint64_t>(handle) >> 32);
+
+      if (slot >= slots_.size() || slots_[slot].generation != generation || slots_[slot].position == NONE) {
+        return NONE;
+      }
+
+      return slot;
+    }
+
+    void heapify() noexcept {
+      for (size_t position = heap_.size() / ARITY + 1; position-- > 0;) {
+        if (position < heap_.size()) {
+          sift_down(position);
+        }
+      }
+    }
+
+  public:
+    const char* name() override { return "PriorityQueue"; }
+
+    PriorityQueue() noexcept = default;
+
+    int size() const noexcept { return static_cast<int>(heap_.size()); }
+    bool empty() const noexcept { return heap_.empty(); }
+
+    void clear() {
+      while (!heap_.empty()) {
+        release_slot(heap_.back().slot);
+        heap_.pop_back();
+      }
+    }
+
+    void reserve(const int count) {
+      heap_.reserve(std::abs(count));
+      slots_.reserve(std::abs(count));
+    }
+
+    // Returns a handle for contains, get_priority, decrease_key and remove
+    int64_t push(const sol::stack_object value, const double priority) {
+      if (priority != priority) {
+        umbra_fail("PriorityQueue: priority cannot be NaN");
+      }
+
+      const uint32_t slot = acquire_slot(LuaCell::from_stack(value));
+      heap_.push_back({ priority, sequence_++, slot });
+      sift_up(heap_.size() - 1);
+
+      return make_handle(slot, slots_[slot].generation);
+    }
+
+    // Removes the entry with the lowest priority and returns its value and priority, nil when empty
+    std::tuple<LuaCell, std::optional<double>> pop() {
+      if (heap_.empty()) {
+        return { LuaCell(), std::nullopt };
+      }
+
+      const double priority = heap_.front().priority;
+      const uint32_t slot = remove_at(0);
+      return { release_slot(slot), priority };
+    }
+
+    std::tuple<LuaCellView, std::optional<double>> peek() const {
+      if (heap_.empty()) {
+        return { LuaCellView(), std::nullopt };
+      }
+
+      return { LuaCellView{ &slots_[heap_.front().slot].value }, heap_.front().priority };
+    }
+
+    bool contains(const int64_t handle) const noexcept {
+      return resolve(handle) != NONE;
+    }
+
+    std::optional<double> get_priority(const int64_t handle) const noexcept {
+      const uint32_t slot = resolve(handle);
+      if (slot == NONE) {
+        return std::nullopt;
+      }
+
+      return heap_[slots_[slot].position].priority;
+    }
+
+    // Moves the entry to a new priority in O(log n) and returns whether the handle was live. A higher
+    // priority is accepted too and sifts the entry down. The entry keeps its place among equal
+    // priorities.
+    bool decrease_key(const int64_t handle, const double priority) {
+      if (priority != priority) {
+        umbra_fail("PriorityQueue: priority cannot be NaN");
+      }
+
+      const uint32_t slot = resolve(handle);
+      if (slot == NONE) {
+        return false;
+      }
+
+      const size_t position = slots_[slot].position;
+      const double previous = heap_[position].priority;
+      heap_[position].priority = priority;
+
+      if (priority < previous) {
+        sift_up(position);
+      } else {
+        sift_down(position);
+      }
+
+      return true;
+    }
+
+    // Removes the entry and returns its value, nil for a stale handle
+    LuaCell remove(const int64_t handle) {
+      const uint32_t slot = resolve(handle);
+      if (slot == NONE) {
+        return {};
+      }
+
+      remove_at(slots_[slot].position);
+      return release_slot(slot);
+    }
+
+    // Builds the heap in O(n). `values` and `priorities` are ordered tables of the same length; without
+    // `priorities`, the values must be numbers and are their own priorities.
+    static PriorityQueue from_table(const sol::table& values, const sol::optional<sol::table>& priorities) {
+      PriorityQueue out;
+      const size_t count = values.size();
+
+      if (priorities && priorities->size() != count) {
+        umbra_fail("PriorityQueue: from_table expects as many priorities as values");
+      }
+
+      out.reserve(static_cast<int>(count));
+
+      lua_State* L = values.lua_state();
+      values.push(L);
+      for (size_t i = 1; i <= count; ++i) {
+        const sol::optional<double> priority = priorities ? priorities->get<sol::optional<double>>(i) : values.get<sol::optional<double>>(i);
+
+        if (!priority || *priority != *priority) {
+          umbra_fail("PriorityQueue: from_table priority " + std::to_string(i) + " is not a number");
+        }
+
+        lua_geti(L, -1, static_cast<lua_Integer>(i));
+        const uint32_t slot = out.acquire_slot(LuaCell::from_stack(L, -1));
+        lua_pop(L, 1);
+
+        out.slots_[slot].position = static_cast<uint32_t>(out.heap_.size());
+        out.heap_.push_back({ *priority, out.sequence_++, slot });
+      }
+      lua_pop(L, 1);
+
+      out.heapify();
+      return out;
+    }
+
+    std::string to_string() const {
+      return "PriorityQueue(" + std::to_string(heap_.size()) + ")";
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<PriorityQueue> user_type = lua_state.new_usertype<PriorityQueue>(name(),
+        sol::constructors<PriorityQueue()>(),
+        "size", &PriorityQueue::size,
+        "empty", &PriorityQueue::empty,
+        "clear", &PriorityQueue::clear,
+        "reserve", &PriorityQueue::reserve,
+        "push", &PriorityQueue::push,
+        "pop", &PriorityQueue::pop,
+        "peek", &PriorityQueue::peek,
+        "contains", &PriorityQueue::contains,
+        "get_priority", &PriorityQueue::get_priority,
+        "decrease_key", &PriorityQueue::decrease_key,
+        "remove", &PriorityQueue::remove,
+        "from_table", &PriorityQueue::from_table
+      );
+
+      user_type[sol::meta_function::length] = [](const PriorityQueue& priority_queue) {
+        return priority_queue.size();
+      };
+
+      user_type[sol::meta_function::to_string] = [](const PriorityQueue& priority_queue) {
+        return priority_queue.to_string();
+      };
+    }
+  };
+
+}
@@ -1,201 +1,310 @@
 #pragma once
 
 #include "Umbra/types.hpp"
+#include "Umbra/types/lua_cell.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <sol/sol.hpp>
 
 namespace umbra {
 
+  struct SinglyLinkedListCursor;
+
+  // Nodes live in a per-list pool and link to each other by index. Removed nodes go on a free list
+  // and are reused by the next push, so a list that churns stops allocating once it reaches its
+  // high-water mark. Every node carries a generation that is bumped when it is freed, which lets a
+  // cursor detect that the node it points at has been removed.
+  //
+  // Index access remembers the last node it reached, so walking the list with get(i), get(i + 1), ...
+  // costs one step per call instead of a walk from the head.
+  //
+  // Node data is a LuaCell, so numbers and booleans are stored inline rather than in the registry.
   struct UMBRA_API SinglyLinkedList final : IType {
   private:
+    friend struct SinglyLinkedListCursor;
+
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
 
     struct SinglyLinkedListNode final {
-      sol::object data;
-      std::unique_ptr<SinglyLinkedListNode> next;
+      LuaCell data;
+      uint32_t next = NONE;
+      uint32_t generation = 0;
+    };
+
+    std::vector<SinglyLinkedListNode> nodes_;
+    uint32_t head_ = NONE;
+    uint32_t tail_ = NONE;
+    uint32_t free_ = NONE;
+    size_t size_ = 0;
+
+    mutable uint32_t finger_node_ = NONE;
+    mutable size_t finger_index_ = 0;
+
+    uint32_t allocate(LuaCell value) {
+      uint32_t node = free_;
+      if (node != NONE) {
+        free_ = nodes_[node].next;
+      } else {
+        node = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+      }
+
+      nodes_[node].data = std::move(value);
+      nodes_[node].next = NONE;
+      return node;
+    }
 
-      explicit SinglyLinkedListNode(sol::object data) : data(std::move(data)), next(nullptr) {}
+    LuaCell release(const uint32_t node) noexcept {
+      SinglyLinkedListNode& released = nodes_[node];
+      LuaCell out = std::move(released.data);
+
+      released.generation++;
+      released.next = free_;
+      free_ = node;
+
+      return out;
+    }
+
+    bool is_live(const uint32_t node, const uint32_t generation) const noexcept {
+      return node < nodes_.size() && nodes_[node].generation == generation;
+    }
+
+    // Where a pairs or ipairs loop is: the node it visited last and that node's generation
+    struct Iteration {
+      uint32_t node = NONE;
+      uint32_t generation = 0;
+      int i = 0;
     };
 
-    std::unique_ptr<SinglyLinkedListNode> head_;
-    SinglyLinkedListNode* tail_;
-    size_t size_;
+    // Moves the loop to the node after the one it visited last and returns it, or NONE at the end. The
+    // loop also ends when its last node has been removed, since that node's link may already lead into
+    // a reused node.
+    uint32_t step(Iteration& iteration) const noexcept {
+      uint32_t next = head_;
+      if (iteration.i > 0) {
+        if (!is_live(iteration.node, iteration.generation)) {
+          return NONE;
+        }
+
+        next = nodes_[iteration.node].next;
+      }
 
-    SinglyLinkedListNode* nth(size_t index) const noexcept {
-      SinglyLinkedListNode* current = head_.get();
-      while (current && index--) {
-        current = current->next.get();
+      if (next != NONE) {
+        iteration.node = next;
+        iteration.generation = nodes_[next].generation;
+        iteration.i++;
+      }
+
+      return next;
+    }
+
+    // Positions shift on anything other than push_back, so the remembered node is dropped
+    void forget_finger() const noexcept {
+      finger_node_ = NONE;
+    }
+
+    uint32_t nth(const size_t index) const noexcept {
+      uint32_t current = head_;
+      size_t position = 0;
+
+      if (finger_node_ != NONE && finger_index_ <= index) {
+        current = finger_node_;
+        position = finger_index_;
+      }
+
+      while (current != NONE && position < index) {
+        current = nodes_[current].next;
+        position++;
+      }
+
+      if (current != NONE) {
+        finger_node_ = current;
+        finger_index_ = index;
       }
 
       return current;
     }
 
-  public:
+    void insert_after(const uint32_t previous, LuaCell value) {
+      const uint32_t node = allocate(std::move(value));
 
-    const char* name() override { return "SinglyLinkedList"; }
+      nodes_[node].next = nodes_[previous].next;
+      nodes_[previous].next = node;
+      if (tail_ == previous) {
+        tail_ = node;
+      }
 
-    SinglyLinkedList() noexcept : head_(nullptr), tail_(nullptr), size_(0) {}
+      forget_finger();
+      size_++;
+    }
 
-    int size() const noexcept { return static_cast<int>(size_); }
-    bool empty() const noexcept { return size_ <= 0; }
+    LuaCell remove_after(const uint32_t previous) noexcept {
+      const uint32_t node = nodes_[previous].next;
+      if (node == NONE) {
+        return {};
+      }
 
-    void clear() noexcept {
-      head_.reset();
-      tail_ = nullptr;
-      size_ = 0;
+      nodes_[previous].next = nodes_[node].next;
+      if (tail_ == node) {
+        tail_ = previous;
+      }
+
+      forget_finger();
+      size_--;
+      return release(node);
     }
 
-    void push_front(sol::object value) {
-      auto node = std::make_unique<SinglyLinkedListNode>(std::move(value));
-      if (!head_) {
-        // ReSharper disable once CppDFALocalValueEscapesFunction
-        tail_ = node.get();
-        head_ = std::move(node);
-      } else {
-        node->next = std::move(head_);
-        head_ = std::move(node);
+    void prepend(LuaCell value) {
+      const uint32_t node = allocate(std::move(value));
+
+      nodes_[node].next = head_;
+      head_ = node;
+      if (tail_ == NONE) {
+        tail_ = node;
       }
 
+      forget_finger();
       size_++;
     }
 
-    void push_back(sol::object value) {
-      auto node = std::make_unique<SinglyLinkedListNode>(std::move(value));
-      SinglyLinkedListNode* raw = node.get();
-      if (!tail_) {
-        head_ = std::move(node);
-        // ReSharper disable once CppDFALocalValueEscapesFunction
-        tail_ = raw;
+    void append(LuaCell value) {
+      const uint32_t node = allocate(std::move(value));
+
+      if (tail_ == NONE) {
+        head_ = node;
       } else {
-        tail_->next = std::move(node);
-        // ReSharper disable once CppDFALocalValueEscapesFunction
-        tail_ = raw;
+        nodes_[tail_].next = node;
       }
 
+      tail_ = node;
       size_++;
     }
 
-    sol::object pop_front(const sol::this_state this_state) noexcept {
-      if (!head_) {
-        return make_object(this_state, sol::lua_nil);
-      }
+  public:
+
+    const char* name() override { return "SinglyLinkedList"; }
 
-      sol::object out = std::move(head_->data);
-      head_ = std::move(head_->next);
+    SinglyLinkedList() noexcept = default;
 
-      if (!head_) {
-        tail_ = nullptr;
+    int size() const noexcept { return static_cast<int>(size_); }
+    bool empty() const noexcept { return size_ <= 0; }
+
+    // Pre-sizes the node pool so the next `count` pushes do not allocate
+    void reserve(const int count) {
+      nodes_.reserve(std::abs(count));
+    }
+
+    void clear() noexcept {
+      for (uint32_t current = head_; current != NONE;) {
+        const uint32_t next = nodes_[current].next;
+        release(current);
+        current = next;
       }
 
-      size_--;
-      return out;
+      head_ = NONE;
+      tail_ = NONE;
+      size_ = 0;
+      forget_finger();
+    }
+
+    void push_front(const sol::stack_object value) {
+      prepend(LuaCell::from_stack(value));
     }
 
-    sol::object pop_back(const sol::this_state this_state) noexcept {
-      if (!head_) {
-        return make_object(this_state, sol::lua_nil);
+    void push_back(const sol::stack_object value) {
+      append(LuaCell::from_stack(value));
+    }
+
+    LuaCell pop_front() noexcept {
+      if (head_ == NONE) {
+        return {};
       }
 
-      if (head_.get() == tail_) {
-        sol::object out = std::move(head_->data);
-        clear();
-        return out;
+      const uint32_t node = head_;
+      head_ = nodes_[node].next;
+      if (head_ == NONE) {
+        tail_ = NONE;
       }
 
-      SinglyLinkedListNode* previous = head_.get();
-      while (previous->next.get() != tail_) {
-        previous = previous->next.get();
+      forget_finger();
+      size_--;
+      return release(node);
+    }
+
+    LuaCell pop_back() noexcept {
+      if (head_ == NONE) {
+        return {};
       }
 
-      sol::object out = std::move(tail_->data);
-      previous->next.reset();
-      tail_ = previous;
+      if (head_ == tail_) {
+        return pop_front();
+      }
 
-      size_--;
-      return out;
+      return remove_after(nth(size_ - 2));
     }
 
-    sol::object get(const int index, const sol::this_state this_state) const noexcept {
+    LuaCellView get(const int index) const noexcept {
       if (index < 1 || static_cast<size_t>(index) > size_) {
-        return make_object(this_state, sol::lua_nil);
+        return {};
       }
 
-      SinglyLinkedListNode* n = nth(index - 1);
-      return n ? n->data : make_object(this_state, sol::lua_nil);
+      const uint32_t node = nth(index - 1);
+      return node != NONE ? LuaCellView{ &nodes_[node].data } : LuaCellView();
     }
 
-    void set(const int index, sol::object value) const noexcept {
-      if (index < 1 || index > size_) {
+    void set(const int index, const sol::stack_object value) {
+      if (index < 1 || static_cast<size_t>(index) > size_) {
         return;
       }
 
-      if (SinglyLinkedListNode* n = nth(index - 1)) {
-        n->data = std::move(value);
+      if (const uint32_t node = nth(index - 1); node != NONE) {
+        nodes_[node].data = LuaCell::from_stack(value);
       }
     }
 
-    void insert(const int index, sol::object value) {
-      const size_t n = size_;
+    void insert(const int index, const sol::stack_object value) {
       if (index <= 1) {
-        push_front(std::move(value));
+        prepend(LuaCell::from_stack(value));
         return;
       }
 
-      if (index > n + 1) {
-        push_back(std::move(value));
+      if (static_cast<size_t>(index) > size_) {
+        append(LuaCell::from_stack(value));
         return;
       }
 
-      SinglyLinkedListNode* previous = nth(index - 2);
-
-      auto node = std::make_unique<SinglyLinkedListNode>(std::move(value));
-      SinglyLinkedListNode* raw = node.get();
-      node->next = std::move(previous->next);
-      previous->next = std::move(node);
-      if (!raw->next) {
-        // ReSharper disable once CppDFALocalValueEscapesFunction
-        tail_ = raw;
-      }
-
-      size_++;
+      insert_after(nth(index - 2), LuaCell::from_stack(value));
     }
 
     void erase(const int index) noexcept {
-      if (index < 1 || index > size_) {
+      if (index < 1 || static_cast<size_t>(index) > size_) {
         return;
       }
 
       if (index == 1) {
-        if (head_) {
-          head_ = std::move(head_->next);
-          if (!head_) {
-            tail_ = nullptr;
-          }
-          size_--;
-        }
-
-        return;
-      }
-
-      SinglyLinkedListNode* previous = nth(index - 2);
-      if (!previous || !previous->next) {
+        pop_front();
         return;
       }
 
-      if (previous->next.get() == tail_) {
-        tail_ = previous;
-      }
-
-      previous->next = std::move(previous->next->next);
-      size_--;
+      remove_after(nth(index - 2));
     }
 
     SinglyLinkedList concat(const SinglyLinkedList& other) const {
       SinglyLinkedList out;
+      out.nodes_.reserve(size_ + other.size_);
 
-      for (const SinglyLinkedListNode* current = head_.get(); current; current = current->next.get()) {
-        out.push_back(current->data);
+      for (uint32_t current = head_; current != NONE; current = nodes_[current].next) {
+        out.append(nodes_[current].data);
       }
 
-      for (const SinglyLinkedListNode* current = other.head_.get(); current; current = current->next.get()) {
-        out.push_back(current->data);
+      for (uint32_t current = other.head_; current != NONE; current = other.nodes_[current].next) {
+        out.append(other.nodes_[current].data);
       }
 
       return out;
@@ -205,22 +314,31 @@ namespace umbra {
       SinglyLinkedList out;
 
       const size_t length = table.size();
+      out.nodes_.reserve(length);
+
+      lua_State* L = table.lua_state();
+      table.push(L);
       for (size_t i = 1; i <= length; ++i) {
-        out.push_back(table.get<sol::object>(i));
+        lua_geti(L, -1, static_cast<lua_Integer>(i));
+        out.append(LuaCell::from_stack(L, -1));
+        lua_pop(L, 1);
       }
+      lua_pop(L, 1);
 
       return out;
     }
 
-    sol::as_table_t<std::vector<sol::object>> to_table() const {
-      std::vector<sol::object> vector;
-      vector.reserve(size_);
+    sol::table to_table(const sol::this_state this_state) const {
+      lua_State* L = this_state;
+      lua_createtable(L, static_cast<int>(size_), 0);
 
-      for (SinglyLinkedListNode* current = head_.get(); current; current = current->next.get()) {
-        vector.emplace_back(current->data);
+      lua_Integer i = 1;
+      for (uint32_t current = head_; current != NONE; current = nodes_[current].next) {
+        nodes_[current].data.push(L);
+        lua_rawseti(L, -2, i++);
       }
 
-      return as_table(std::move(vector));
+      return sol::stack::pop<sol::table>(L);
     }
 
     bool equals(const SinglyLinkedList& other, const sol::this_state this_state) const {
@@ -228,25 +346,16 @@ namespace umbra {
         return false;
       }
 
-      sol::state_view state_view(this_state);
-      const sol::function raw_equal = state_view["rawequal"];
-
-      SinglyLinkedListNode* a = head_.get();
-      SinglyLinkedListNode* b = other.head_.get();
-
-      while (a && b) {
-        if (raw_equal.valid()) {
-          if (!raw_equal(a->data, b->data)) {
-            return false;
-          }
-        } else {
-          if (a->data != b->data) {
-            return false;
-          }
+      uint32_t a = head_;
+      uint32_t b = other.head_;
+
+      while (a != NONE && b != NONE) {
+        if (!nodes_[a].data.raw_equals(other.nodes_[b].data, this_state)) {
+          return false;
         }
 
-        a = a->next.get();
-        b = b->next.get();
+        a = nodes_[a].next;
+        b = other.nodes_[b].next;
       }
 
       return true;
@@ -259,131 +368,201 @@ namespace umbra {
 
       string_stream << "SinglyLinkedList(";
       size_t i = 0;
-      for (SinglyLinkedListNode* current = head_.get(); current; current = current->next.get(), ++i) {
+      for (uint32_t current = head_; current != NONE; current = nodes_[current].next, ++i) {
         if (i) {
           string_stream << ", ";
         }
 
-        if (current->data.is<std::string>()) {
-          string_stream << '\'' << current->data.as<std::string>() << '\'';
-          continue;
-        }
-
-        if (to_string.valid()) {
-          sol::object value = to_string(current->data);
-          if (value.is<std::string>()) {
-            string_stream << value.as<std::string>();
-          } else {
-            string_stream << "<obj>";
-          }
-        } else {
-          string_stream << "<obj>";
-        }
+        describe(string_stream, nodes_[current].data, to_string, this_state);
       }
       string_stream << ")";
 
       return string_stream.str();
     }
 
-    void bind(sol::state& lua_state) {
-      sol::usertype<SinglyLinkedList> user_type = lua_state.new_usertype<SinglyLinkedList>(name(),
-        sol::constructors<SinglyLinkedList()>(),
-        "size", &SinglyLinkedList::size,
-        "empty", &SinglyLinkedList::empty,
-        "clear", &SinglyLinkedList::clear,
-        "push_front", &SinglyLinkedList::push_front,
-        "push_back", &SinglyLinkedList::push_back,
-        "pop_front", &SinglyLinkedList::pop_front,
-        "pop_back", &SinglyLinkedList::pop_back,
-        "get", &SinglyLinkedList::get,
-        "set", &SinglyLinkedList::set,
-        "insert", &SinglyLinkedList::insert,
-        "erase", &SinglyLinkedList::erase,
-        "from_table", &SinglyLinkedList::from_table,
-        "to_table", &SinglyLinkedList::to_table
-      );
-
-      user_type[sol::meta_function::length] = [](const SinglyLinkedList& singly_linked_list) {
-        return singly_linked_list.size();
-      };
+    void bind(sol::state& lua_state);
 
-      user_type[sol::meta_function::addition] = [](const SinglyLinkedList& first, const SinglyLinkedList& second) {
-        return first.concat(second);
-      };
+  };
 
-      user_type[sol::meta_function::equal_to] = [](const SinglyLinkedList& first, const SinglyLinkedList& second, const sol::this_state this_state) {
-        return first.equals(second, this_state);
-      };
+  // A position in a SinglyLinkedList. Moving forward and inserting or removing after the current node
+  // are O(1). The cursor keeps its list alive, and fails loudly once the node it points at has been
+  // removed through any other path.
+  struct UMBRA_API SinglyLinkedListCursor final {
+  private:
+    sol::object owner_;
+    SinglyLinkedList* list_;
+    uint32_t node_;
+    uint32_t generation_;
+
+    // True when the cursor points at a live node; fails when that node has been removed
+    bool check() const {
+      if (node_ == SinglyLinkedList::NONE) {
+        return false;
+      }
 
-      user_type[sol::meta_function::to_string] = [](const SinglyLinkedList& singly_linked_list, const sol::this_state this_state) {
-        return singly_linked_list.to_string(this_state);
-      };
+      if (!list_->is_live(node_, generation_)) {
+        umbra_fail("SinglyLinkedList: cursor refers to a removed node");
+      }
 
-      user_type[sol::meta_function::index] = [](const SinglyLinkedList& singly_linked_list, const sol::stack_object key, const sol::this_state this_state) {
-        if (key.is<int>()) {
-          return singly_linked_list.get(key.as<int>(), this_state);
-        }
+      return true;
+    }
 
-        if (key.is<double>()) {
-          return singly_linked_list.get(static_cast<int>(key.as<double>()), this_state);
-        }
+    void move_to(const uint32_t node) noexcept {
+      node_ = node;
+      generation_ = node != SinglyLinkedList::NONE ? list_->nodes_[node].generation : 0;
+    }
 
-        return make_object(this_state, sol::lua_nil);
-      };
+  public:
 
-      user_type[sol::meta_function::ipairs] = [](const SinglyLinkedList& singly_linked_list, const sol::this_state this_state) {
-        struct State { SinglyLinkedListNode* current; int i; };
-        auto state = std::make_shared<State>(State{ singly_linked_list.head_.get(), 0 });
+    SinglyLinkedListCursor(sol::object owner, SinglyLinkedList* list, const uint32_t node) noexcept : owner_(std::move(owner)), list_(list), node_(SinglyLinkedList::NONE), generation_(0) {
+      move_to(node);
+    }
 
-        auto iter = [state, this_state](sol::object, sol::object) -> std::tuple<sol::object, sol::object> {
-          if (!state->current) {
-            sol::object nil = make_object(this_state, sol::lua_nil);
-            return { nil, nil };
-          }
+    bool valid() const noexcept {
+      return node_ != SinglyLinkedList::NONE && list_->is_live(node_, generation_);
+    }
 
-          state->i += 1;
-          sol::object index = make_object(this_state, sol::lua_nil);
-          sol::object value = state->current->data;
+    LuaCellView get() const {
+      if (!check()) {
+        return {};
+      }
 
-          state->current = state->current->next.get();
+      return { &list_->nodes_[node_].data };
+    }
 
-          if (value.is<sol::lua_nil_t>()) {
-            sol::object nil = make_object(this_state, sol::lua_nil);
-            return { nil, nil };
-          }
+    void set(const sol::stack_object value) const {
+      if (check()) {
+        list_->nodes_[node_].data = LuaCell::from_stack(value);
+      }
+    }
 
-          return { index, value };
-        };
+    // Advances to the following node and returns whether there was one
+    bool next() {
+      if (!check()) {
+        return false;
+      }
 
-        return std::make_tuple(iter, make_object(this_state, sol::lua_nil), 0);
-      };
+      move_to(list_->nodes_[node_].next);
+      return node_ != SinglyLinkedList::NONE;
+    }
+
+    void insert_after(const sol::stack_object value) const {
+      if (!check()) {
+        umbra_fail("SinglyLinkedList: cannot insert after a cursor past the end of the list");
+      }
+
+      list_->insert_after(node_, LuaCell::from_stack(value));
+    }
+
+    LuaCell remove_after() const {
+      if (!check()) {
+        return {};
+      }
+
+      return list_->remove_after(node_);
+    }
+
+    SinglyLinkedListCursor clone() const {
+      return *this;
+    }
+  };
+
+  inline void SinglyLinkedList::bind(sol::state& lua_state) {
+    lua_state.new_usertype<SinglyLinkedListCursor>("SinglyLinkedListCursor", sol::no_constructor,
+      "valid", &SinglyLinkedListCursor::valid,
+      "get", &SinglyLinkedListCursor::get,
+      "set", &SinglyLinkedListCursor::set,
+      "next", &SinglyLinkedListCursor::next,
+      "insert_after", &SinglyLinkedListCursor::insert_after,
+      "remove_after", &SinglyLinkedListCursor::remove_after,
+      "clone", &SinglyLinkedListCursor::clone
+    );
+
+    sol::usertype<SinglyLinkedList> user_type = lua_state.new_usertype<SinglyLinkedList>(name(),
+      sol::constructors<SinglyLinkedList()>(),
+      "size", &SinglyLinkedList::size,
+      "empty", &SinglyLinkedList::empty,
+      "reserve", &SinglyLinkedList::reserve,
+      "clear", &SinglyLinkedList::clear,
+      "push_front", &SinglyLinkedList::push_front,
+      "push_back", &SinglyLinkedList::push_back,
+      "pop_front", &SinglyLinkedList::pop_front,
+      "pop_back", &SinglyLinkedList::pop_back,
+      "get", &SinglyLinkedList::get,
+      "set", &SinglyLinkedList::set,
+      "insert", &SinglyLinkedList::insert,
+      "erase", &SinglyLinkedList::erase,
+      "from_table", &SinglyLinkedList::from_table,
+      "to_table", &SinglyLinkedList::to_table,
+      "cursor", [](const sol::object& self) {
+        auto& list = self.as<SinglyLinkedList&>();
+        return SinglyLinkedListCursor(self, &list, list.head_);
+      }
+    );
+
+    user_type[sol::meta_function::length] = [](const SinglyLinkedList& singly_linked_list) {
+      return singly_linked_list.size();
+    };
+
+    user_type[sol::meta_function::addition] = [](const SinglyLinkedList& first, const SinglyLinkedList& second) {
+      return first.concat(second);
+    };
 
-      user_type[sol::meta_function::pairs] = [](const SinglyLinkedList& singly_linked_list, const sol::this_state this_state) {
-        struct State { SinglyLinkedListNode* current; int i; };
-        auto state = std::make_shared<State>(State{ singly_linked_list.head_.get(), 0 });
+    user_type[sol::meta_function::equal_to] = [](const SinglyLinkedList& first, const SinglyLinkedList& second, const sol::this_state this_state) {
+      return first.equals(second, this_state);
+    };
+
+    user_type[sol::meta_function::to_string] = [](const SinglyLinkedList& singly_linked_list, const sol::this_state this_state) {
+      return singly_linked_list.to_string(this_state);
+    };
+
+    user_type[sol::meta_function::index] = [](const SinglyLinkedList& singly_linked_list, const sol::stack_object key) {
+      if (key.is<int>()) {
+        return singly_linked_list.get(key.as<int>());
+      }
 
-        auto iter = [state, this_state](sol::object, sol::object) -> std::tuple<sol::object, sol::object> {
-          if (!state->current) {
-            sol::object nil = make_object(this_state, sol::lua_nil);
-            return { nil, nil };
-          }
+      if (key.is<double>()) {
+        return singly_linked_list.get(static_cast<int>(key.as<double>()));
+      }
 
-          state->i += 1;
-          sol::object index = sol::make_object(this_state, state->i);
-          sol::object value = state->current->data;
-          state->current = state->current->next.get();
+      return LuaCellView();
+    };
 
-          return { index, value };
-        };
+    // Iterators hold node indices rather than pointers, since pushing during iteration may grow the pool.
+    // The list is the loop's invariant state, which keeps it alive while the loop runs.
+    user_type[sol::meta_function::ipairs] = [](const sol::stack_object self) {
+      auto iteration = std::make_shared<Iteration>();
 
-        return std::make_tuple(iter, make_object(this_state, sol::lua_nil), 0);
+      auto iter = [iteration](const SinglyLinkedList& singly_linked_list, sol::object, const sol::this_state iter_state) -> std::tuple<sol::object, LuaCellView> {
+        const uint32_t node = singly_linked_list.step(*iteration);
+        if (node == NONE || singly_linked_list.nodes_[node].data.is_nil()) {
+          return { make_object(iter_state, sol::lua_nil), LuaCellView() };
+        }
+
+        return { make_object(iter_state, iteration->i), LuaCellView{ &singly_linked_list.nodes_[node].data } };
       };
 
-      user_type[sol::meta_function::concatenation] = [](const SinglyLinkedList& first, const SinglyLinkedList& second) {
-        return first.concat(second);
+      return std::make_tuple(iter, sol::object(self.lua_state(), self.stack_index()), 0);
+    };
+
+    user_type[sol::meta_function::pairs] = [](const sol::stack_object self) {
+      auto iteration = std::make_shared<Iteration>();
+
+      auto iter = [iteration](const SinglyLinkedList& singly_linked_list, sol::object, const sol::this_state iter_state) -> std::tuple<sol::object, LuaCellView> {
+        const uint32_t node = singly_linked_list.step(*iteration);
+        if (node == NONE) {
+          return { make_object(iter_state, sol::lua_nil), LuaCellView() };
+        }
+
+        return { make_object(iter_state, iteration->i), LuaCellView{ &singly_linked_list.nodes_[node].data } };
       };
-    }
 
-  };
+      return std::make_tuple(iter, sol::object(self.lua_state(), self.stack_index()), 0);
+    };
+
+    user_type[sol::meta_function::concatenation] = [](const SinglyLinkedList& first, const SinglyLinkedList& second) {
+      return first.concat(second);
+    };
+  }
 
-}
\ No newline at end of file
+}
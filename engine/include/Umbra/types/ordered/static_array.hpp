@@ -1,9 +1,13 @@
 #pragma once
 
 #include "Umbra/types.hpp"
+#include "Umbra/types/lua_cell.hpp"
+#include "Umbra/types/ordered/ordering.hpp"
 
 #include <algorithm>
 #include <cstddef>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -11,9 +15,10 @@
 
 namespace umbra {
 
+  // Elements are LuaCells, so numbers and booleans are stored inline rather than in the registry
   struct UMBRA_API StaticArray final : IType {
   private:
-    std::unique_ptr<sol::object[]> data_;
+    std::unique_ptr<LuaCell[]> data_;
     int size_ = 0;
 
   public:
@@ -25,64 +30,70 @@ namespace umbra {
     StaticArray(StaticArray&&) noexcept = default;
     StaticArray& operator=(StaticArray&&) noexcept = default;
 
-    StaticArray(const int count, const sol::this_state this_state) {
+    // Every element starts as nil
+    explicit StaticArray(const int count) {
       size_ = std::max(0, count);
       if (size_ == 0) {
         data_.reset();
         return;
       }
 
-      data_ = std::unique_ptr<sol::object[]>(new sol::object[static_cast<size_t>(size_)]);
-      for (int i = 0; i < size_; ++i) {
-        data_[i] = make_object(this_state, sol::lua_nil);
-      }
+      data_ = std::make_unique<LuaCell[]>(static_cast<size_t>(size_));
     }
 
     int size() const noexcept { return size_; }
     bool empty() const noexcept { return size() == 0; }
 
-    sol::object get(const int index, const sol::this_state this_state) const noexcept {
+    LuaCellView get(const int index) const noexcept {
       if (index < 1 || index > size_) {
-        return make_object(this_state, sol::lua_nil);
+        return {};
       }
 
-      return data_[index - 1];
+      return { &data_[index - 1] };
     }
 
-    void set(const int index, const sol::object& value) noexcept {
+    void set(const int index, const sol::stack_object value) {
       if (index < 1 || index > size_) {
         return;
       }
 
-      data_[index - 1] = value;
+      data_[index - 1] = LuaCell::from_stack(value);
     }
 
-    void fill(const sol::object &value) {
+    void fill(const sol::stack_object value) {
+      const LuaCell cell = LuaCell::from_stack(value);
       for (int i = 0; i < size_; ++i) {
-        data_[i] = value;
+        data_[i] = cell;
       }
     }
 
     static StaticArray from_table(const sol::table& table) {
       const int len = static_cast<int>(table.size());
 
-      StaticArray out(len, sol::this_state{ table.lua_state() });
+      StaticArray out(len);
+
+      lua_State* L = table.lua_state();
+      table.push(L);
       for (int i = 1; i <= len; ++i) {
-        out.data_[i - 1] = table.get<sol::object>(i);
+        lua_geti(L, -1, i);
+        out.data_[i - 1] = LuaCell::from_stack(L, -1);
+        lua_pop(L, 1);
       }
+      lua_pop(L, 1);
 
       return std::move(out);
     }
 
-    sol::as_table_t<std::vector<sol::object>> to_table() const {
-      std::vector<sol::object> vector;
-      vector.reserve(size_);
+    sol::table to_table(const sol::this_state this_state) const {
+      lua_State* L = this_state;
+      lua_createtable(L, size_, 0);
 
       for (int i = 0; i < size_; ++i) {
-        vector.emplace_back(data_[i]);
+        data_[i].push(L);
+        lua_rawseti(L, -2, i + 1);
       }
 
-      return as_table(std::move(vector));
+      return sol::stack::pop<sol::table>(L);
     }
 
     bool equals(const StaticArray& other, const sol::this_state this_state) const {
@@ -90,24 +101,43 @@ namespace umbra {
         return false;
       }
 
-      sol::state_view state_view(this_state);
-      const sol::function raw_equal = state_view["rawequal"];
-
       for (int i = 0; i < size_; ++i) {
-        if (raw_equal.valid()) {
-          if (!raw_equal(data_[i], other.data_[i])) {
-            return false;
-          }
-        } else {
-          if (data_[i] != other.data_[i]) {
-            return false;
-          }
+        if (!data_[i].raw_equals(other.data_[i], this_state)) {
+          return false;
         }
       }
 
       return true;
     }
 
+    void sort(const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      ordering::sort_cells(std::span(data_.get(), static_cast<size_t>(size_)), comparator, this_state, name());
+    }
+
+    void stable_sort(const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      ordering::sort_cells(std::span(data_.get(), static_cast<size_t>(size_)), comparator, this_state, name());
+    }
+
+    int lower_bound(const sol::stack_object value, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      return ordering::lower_bound(std::span<const LuaCell>(data_.get(), static_cast<size_t>(size_)), value, comparator, this_state, name());
+    }
+
+    int upper_bound(const sol::stack_object value, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      return ordering::upper_bound(std::span<const LuaCell>(data_.get(), static_cast<size_t>(size_)), value, comparator, this_state, name());
+    }
+
+    bool binary_search(const sol::stack_object value, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      return ordering::binary_search(std::span<const LuaCell>(data_.get(), static_cast<size_t>(size_)), value, comparator, this_state, name());
+    }
+
+    int partition(const sol::protected_function& predicate) {
+      return ordering::partition(std::span(data_.get(), static_cast<size_t>(size_)), predicate, name());
+    }
+
+    void nth_element(const int n, const sol::optional<sol::protected_function>& comparator, const sol::this_state this_state) {
+      ordering::nth_element(std::span(data_.get(), static_cast<size_t>(size_)), n, comparator, this_state, name());
+    }
+
     std::string to_string(const sol::this_state this_state) const {
       sol::state_view state_view(this_state);
       const sol::function to_string = state_view["tostring"];
@@ -119,21 +149,7 @@ namespace umbra {
           string_stream << ", ";
         }
 
-        if (data_[i].is<std::string>()) {
-          string_stream << '\'' << data_[i].as<std::string>() << '\'';
-          continue;
-        }
-
-        if (to_string.valid()) {
-          sol::object value = to_string(data_[i]);
-          if (value.is<std::string>()) {
-            string_stream << value.as<std::string>();
-          } else {
-            string_stream << "<obj>";
-          }
-        } else {
-          string_stream << "<obj>";
-        }
+        describe(string_stream, data_[i], to_string, this_state);
       }
       string_stream << ")";
 
@@ -142,7 +158,7 @@ namespace umbra {
 
     void bind(sol::state& lua_state) {
       sol::usertype<StaticArray> user_type = lua_state.new_usertype<StaticArray>(name(),
-        sol::constructors<StaticArray(), StaticArray(int, sol::this_state)>(),
+        sol::constructors<StaticArray(), StaticArray(int)>(),
 
         "size", &StaticArray::size,
         "empty", &StaticArray::empty,
@@ -150,7 +166,14 @@ namespace umbra {
         "set", &StaticArray::set,
         "fill", &StaticArray::fill,
         "from_table", &StaticArray::from_table,
-        "to_table", &StaticArray::to_table
+        "to_table", &StaticArray::to_table,
+        "sort", &StaticArray::sort,
+        "stable_sort", &StaticArray::stable_sort,
+        "lower_bound", &StaticArray::lower_bound,
+        "upper_bound", &StaticArray::upper_bound,
+        "binary_search", &StaticArray::binary_search,
+        "partition", &StaticArray::partition,
+        "nth_element", &StaticArray::nth_element
       );
 
       user_type[sol::meta_function::length] = [](const StaticArray& static_array) { return static_array.size(); };
@@ -163,18 +186,18 @@ namespace umbra {
         return static_array.to_string(this_state);
       };
 
-      user_type[sol::meta_function::index] = [](const StaticArray& static_array, const sol::stack_object key, const sol::this_state this_state) {
+      user_type[sol::meta_function::index] = [](const StaticArray& static_array, const sol::stack_object key) {
         if (key.is<int>()) {
           const int index = key.as<int>();
-          return static_array.get(index, this_state);
+          return static_array.get(index);
         }
 
         if (key.is<double>()) {
           const int index = static_cast<int>(key.as<double>());
-          return static_array.get(index, this_state);
+          return static_array.get(index);
         }
 
-        return make_object(this_state, sol::lua_nil);
+        return LuaCellView();
       };
 
       user_type[sol::meta_function::new_index] = [](StaticArray& static_array, const sol::stack_object key, const sol::stack_object value) {
@@ -189,43 +212,40 @@ namespace umbra {
         };
 
         if (const std::optional<int> optional_index = to_int(key)) {
-          static_array.set(*optional_index, sol::object(value));
+          static_array.set(*optional_index, value);
         }
       };
 
-      user_type[sol::meta_function::ipairs] = [](StaticArray& static_array, sol::this_state this_state) {
-        auto iter = [this_state](void* static_array_anonymous, const int i) -> std::tuple<sol::object, sol::object> {
+      user_type[sol::meta_function::ipairs] = [](StaticArray& static_array) {
+        auto iter = [](void* static_array_anonymous, const int i) -> std::tuple<std::optional<int>, LuaCellView> {
           const auto* static_array_to_iter = static_cast<StaticArray*>(static_array_anonymous);
 
           const int next = i + 1;
           if (next > static_array_to_iter->size()) {
-            sol::object nil = make_object(this_state, sol::lua_nil);
-            return { nil, nil };
+            return { std::nullopt, LuaCellView() };
           }
 
-          sol::object value = static_array_to_iter->get(next, this_state);
-          if (value.is<sol::lua_nil_t>()) {
-            sol::object nil = make_object(this_state, sol::lua_nil);
-            return { nil, nil };
+          const LuaCellView value = static_array_to_iter->get(next);
+          if (value.cell->is_nil()) {
+            return { std::nullopt, LuaCellView() };
           }
 
-          return { make_object(this_state, next), value };
+          return { next, value };
         };
 
         return std::make_tuple(iter, sol::light(&static_array), 0);
       };
 
-      user_type[sol::meta_function::pairs] = [](StaticArray& static_array, sol::this_state this_state) {
-        auto iter = [this_state](void* static_array_anonymous, const int i) -> std::tuple<sol::object, sol::object> {
+      user_type[sol::meta_function::pairs] = [](StaticArray& static_array) {
+        auto iter = [](void* static_array_anonymous, const int i) -> std::tuple<std::optional<int>, LuaCellView> {
           const auto* static_array_to_iter = static_cast<StaticArray*>(static_array_anonymous);
 
           const int next = i + 1;
           if (next > static_array_to_iter->size()) {
-            sol::object nil = make_object(this_state, sol::lua_nil);
-            return { nil, nil };
+            return { std::nullopt, LuaCellView() };
           }
 
-          return { make_object(this_state, next), static_array_to_iter->get(next, this_state) };
+          return { next, static_array_to_iter->get(next) };
         };
 
         return std::make_tuple(iter, sol::light(&static_array), 0);
@@ -0,0 +1,483 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/ordered/ordering.hpp"
+#include "Umbra/types/simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  struct File;
+
+  template<class T>
+  struct typed_array_name;
+
+  template<> struct typed_array_name<float> { static constexpr const char* value = "Float32Array"; };
+  template<> struct typed_array_name<double> { static constexpr const char* value = "Float64Array"; };
+  template<> struct typed_array_name<int32_t> { static constexpr const char* value = "Int32Array"; };
+  template<> struct typed_array_name<uint8_t> { static constexpr const char* value = "UInt8Array"; };
+
+  // Fixed-size array of one numeric type in contiguous memory. Unlike DynamicArray, elements are plain
+  // values rather than registry references. The bulk kernels are flat loops over the buffer; integer
+  // add and sub also have SSE2 and NEON kernels for the saturating arithmetic compilers do not emit.
+  //
+  // An array either owns a 64-byte aligned buffer or is a view over the bytes of a File. A view keeps
+  // its File alive and reads the bytes in native byte order. File contents are never resized after
+  // creation, so the pointer stays valid.
+  //
+  // Integer arrays compute in an integer twice as wide as the element and saturate when storing, so out
+  // of range results clamp to the element type instead of wrapping. Number operands that are fractional
+  // or too large for that width go through double instead.
+  template<class T>
+  struct UMBRA_API TypedArray final : IType {
+    static_assert(std::is_arithmetic_v<T>, "TypedArray elements must be numeric");
+
+    using value_type = T;
+    using compute_t = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+    using wide_t = std::conditional_t<(sizeof(T) < sizeof(int32_t)), int32_t, int64_t>;
+
+    static constexpr size_t ALIGNMENT = 64;
+
+  private:
+    struct AlignedDelete {
+      void operator()(T* pointer) const noexcept {
+        ::operator delete(pointer, std::align_val_t{ ALIGNMENT });
+      }
+    };
+
+    std::unique_ptr<T, AlignedDelete> storage_;
+    T* data_ = nullptr;
+    size_t size_ = 0;
+
+    // The File a view reads from, nil for arrays that own their buffer
+    sol::object owner_;
+
+    static std::string type_name() {
+      return typed_array_name<T>::value;
+    }
+
+    // Resolves a bulk operand to another array of the same size, or nullptr for a number
+    const TypedArray* operand(const sol::object& value, const char* operation) const {
+      if (value.is<TypedArray>()) {
+        const TypedArray& other = value.as<const TypedArray&>();
+        if (other.size_ != size_) {
+          umbra_fail(type_name() + ": " + operation + " size mismatch (" + std::to_string(size_) + " and " + std::to_string(other.size_) + ")");
+        }
+
+        return &other;
+      }
+
+      if (value.get_type() != sol::type::number) {
+        umbra_fail(type_name() + ": " + operation + " expects a number or " + type_name());
+      }
+
+      return nullptr;
+    }
+
+    // Whether a number operand can take the integer path: products and sums with any element then fit
+    // wide_t, and saturating them gives the same result as computing in double
+    static bool integral_operand(const double value) noexcept {
+      return std::trunc(value) == value && std::abs(value) <= static_cast<double>(std::numeric_limits<T>::max()) + 1.0;
+    }
+
+    static bool fits(const wide_t value) noexcept requires std::is_integral_v<T> {
+      return value >= std::numeric_limits<T>::min() && value <= std::numeric_limits<T>::max();
+    }
+
+    // `op` combines two elements, `kernel` is the matching simd:: bulk kernel or returns 0 when there is none
+    template<class Op, class Kernel>
+    void apply(const sol::object& value, const char* operation, Op op, Kernel kernel) {
+      const TypedArray* other = operand(value, operation);
+
+      if constexpr (std::is_integral_v<T>) {
+        if (other) {
+          const T* in = other->data_;
+          for (size_t i = kernel(data_, in, size_); i < size_; ++i) {
+            data_[i] = saturate(op(static_cast<wide_t>(data_[i]), static_cast<wide_t>(in[i])));
+          }
+          return;
+        }
+
+        const double number = value.as<double>();
+        if (integral_operand(number)) {
+          const auto scalar = static_cast<wide_t>(number);
+          for (size_t i = fits(scalar) ? kernel(data_, static_cast<T>(scalar), size_) : 0; i < size_; ++i) {
+            data_[i] = saturate(op(static_cast<wide_t>(data_[i]), scalar));
+          }
+          return;
+        }
+      }
+
+      if (other) {
+        const T* in = other->data_;
+        for (size_t i = 0; i < size_; ++i) {
+          data_[i] = store(op(static_cast<compute_t>(data_[i]), static_cast<compute_t>(in[i])));
+        }
+      } else {
+        const auto scalar = static_cast<compute_t>(value.as<double>());
+        for (size_t i = 0; i < size_; ++i) {
+          data_[i] = store(op(static_cast<compute_t>(data_[i]), scalar));
+        }
+      }
+    }
+
+  public:
+    const char* name() override { return typed_array_name<T>::value; }
+
+    TypedArray() noexcept = default;
+    TypedArray(const TypedArray&) = delete;
+    TypedArray& operator=(const TypedArray&) = delete;
+    TypedArray(TypedArray&&) noexcept = default;
+    TypedArray& operator=(TypedArray&&) noexcept = default;
+
+    // Zero-filled
+    explicit TypedArray(const int count) {
+      resize(static_cast<size_t>(std::max(0, count)));
+    }
+
+    // Converts a Lua number to the element type; integers saturate and NaN becomes 0
+    static T store(const compute_t value) noexcept {
+      if constexpr (std::is_floating_point_v<T>) {
+        return value;
+      } else {
+        if (value != value) {
+          return 0;
+        }
+
+        return static_cast<T>(std::clamp(value, static_cast<double>(std::numeric_limits<T>::min()), static_cast<double>(std::numeric_limits<T>::max())));
+      }
+    }
+
+    // Clamps an integer result to the element type
+    static T saturate(const wide_t value) noexcept requires std::is_integral_v<T> {
+      return static_cast<T>(std::clamp<wide_t>(value, std::numeric_limits<T>::min(), std::numeric_limits<T>::max()));
+    }
+
+    // Discards the contents and allocates a zero-filled owned buffer of `count` elements
+    void resize(const size_t count) {
+      owner_ = sol::object();
+      storage_.reset();
+      data_ = nullptr;
+      size_ = count;
+
+      if (count == 0) {
+        return;
+      }
+
+      storage_.reset(static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ ALIGNMENT })));
+      data_ = storage_.get();
+      std::fill_n(data_, count, T{});
+    }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    int size() const noexcept { return static_cast<int>(size_); }
+    bool empty() const noexcept { return size_ == 0; }
+    bool is_view() const noexcept { return owner_.valid(); }
+
+    std::optional<T> get(const int index) const noexcept {
+      if (index < 1 || static_cast<size_t>(index) > size_) {
+        return std::nullopt;
+      }
+
+      return data_[index - 1];
+    }
+
+    void set(const int index, const double value) noexcept {
+      if (index < 1 || static_cast<size_t>(index) > size_) {
+        return;
+      }
+
+      data_[index - 1] = store(static_cast<compute_t>(value));
+    }
+
+    void fill(const double value) noexcept {
+      std::fill_n(data_, size_, store(static_cast<compute_t>(value)));
+    }
+
+    void add(const sol::object& value) {
+      apply(value, "add", [](const auto a, const auto b) { return a + b; }, [](T* out, const auto in, const size_t count) {
+        return simd::add_saturate(out, in, count);
+      });
+    }
+
+    void sub(const sol::object& value) {
+      apply(value, "sub", [](const auto a, const auto b) { return a - b; }, [](T* out, const auto in, const size_t count) {
+        return simd::sub_saturate(out, in, count);
+      });
+    }
+
+    void mul(const sol::object& value) {
+      apply(value, "mul", [](const auto a, const auto b) { return a * b; }, [](T*, const auto, size_t) -> size_t {
+        return 0;
+      });
+    }
+
+    // this += a * b, where b is an array or a number; `position:fma(velocity, dt)` integrates in one pass
+    void fma(const TypedArray& a, const sol::object& b) {
+      if (a.size_ != size_) {
+        umbra_fail(type_name() + ": fma size mismatch (" + std::to_string(size_) + " and " + std::to_string(a.size_) + ")");
+      }
+
+      const T* in = a.data_;
+      const TypedArray* other = operand(b, "fma");
+
+      if constexpr (std::is_integral_v<T>) {
+        if (other) {
+          const T* scale = other->data_;
+          for (size_t i = 0; i < size_; ++i) {
+            data_[i] = saturate(static_cast<wide_t>(data_[i]) + static_cast<wide_t>(in[i]) * static_cast<wide_t>(scale[i]));
+          }
+          return;
+        }
+
+        const double number = b.as<double>();
+        if (integral_operand(number)) {
+          const auto scalar = static_cast<wide_t>(number);
+          for (size_t i = 0; i < size_; ++i) {
+            data_[i] = saturate(static_cast<wide_t>(data_[i]) + static_cast<wide_t>(in[i]) * scalar);
+          }
+          return;
+        }
+      }
+
+      if (other) {
+        const T* scale = other->data_;
+        for (size_t i = 0; i < size_; ++i) {
+          data_[i] = store(static_cast<compute_t>(data_[i]) + static_cast<compute_t>(in[i]) * static_cast<compute_t>(scale[i]));
+        }
+      } else {
+        const auto scalar = static_cast<compute_t>(b.as<double>());
+        for (size_t i = 0; i < size_; ++i) {
+          data_[i] = store(static_cast<compute_t>(data_[i]) + static_cast<compute_t>(in[i]) * scalar);
+        }
+      }
+    }
+
+    void clamp(const double low, const double high) noexcept {
+      const T lo = store(static_cast<compute_t>(low));
+      const T hi = store(static_cast<compute_t>(high));
+
+      for (size_t i = 0; i < size_; ++i) {
+        data_[i] = std::min(std::max(data_[i], lo), hi);
+      }
+    }
+
+    // Sums across independent lanes, so the adds do not form one serial dependency chain and vectorise
+    // without reassociating float arithmetic. Integer elements sum exactly in int64.
+    double sum() const noexcept {
+      using sum_t = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+
+      constexpr size_t LANES = 8;
+      sum_t lanes[LANES] = {};
+
+      size_t i = 0;
+      for (; i + LANES <= size_; i += LANES) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+          lanes[lane] += static_cast<sum_t>(data_[i + lane]);
+        }
+      }
+
+      sum_t total = 0;
+      for (; i < size_; ++i) {
+        total += static_cast<sum_t>(data_[i]);
+      }
+
+      for (const sum_t lane : lanes) {
+        total += lane;
+      }
+
+      return static_cast<double>(total);
+    }
+
+    double dot(const TypedArray& other) const {
+      if (other.size_ != size_) {
+        umbra_fail(type_name() + ": dot size mismatch (" + std::to_string(size_) + " and " + std::to_string(other.size_) + ")");
+      }
+
+      constexpr size_t LANES = 8;
+      double lanes[LANES] = {};
+
+      size_t i = 0;
+      for (; i + LANES <= size_; i += LANES) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+          lanes[lane] += static_cast<double>(data_[i + lane]) * static_cast<double>(other.data_[i + lane]);
+        }
+      }
+
+      double total = 0.0;
+      for (; i < size_; ++i) {
+        total += static_cast<double>(data_[i]) * static_cast<double>(other.data_[i]);
+      }
+
+      for (const double lane : lanes) {
+        total += lane;
+      }
+
+      return total;
+    }
+
+    std::optional<T> min() const noexcept {
+      if (size_ == 0) {
+        return std::nullopt;
+      }
+
+      T out = data_[0];
+      for (size_t i = 1; i < size_; ++i) {
+        out = std::min(out, data_[i]);
+      }
+
+      return out;
+    }
+
+    std::optional<T> max() const noexcept {
+      if (size_ == 0) {
+        return std::nullopt;
+      }
+
+      T out = data_[0];
+      for (size_t i = 1; i < size_; ++i) {
+        out = std::max(out, data_[i]);
+      }
+
+      return out;
+    }
+
+    // Ascending with NaN last. Large arrays sort on several threads.
+    void sort() {
+      ordering::sort(std::span(data_, size_), ordering::number_less<T>);
+    }
+
+    // Searches compare in double, so fractional targets work on integer arrays
+    int lower_bound(const double value) const noexcept {
+      const T* it = std::lower_bound(data_, data_ + size_, value, [](const T element, const double target) {
+        return ordering::number_less<double>(element, target);
+      });
+      return static_cast<int>(it - data_) + 1;
+    }
+
+    int upper_bound(const double value) const noexcept {
+      const T* it = std::upper_bound(data_, data_ + size_, value, [](const double target, const T element) {
+        return ordering::number_less<double>(target, element);
+      });
+      return static_cast<int>(it - data_) + 1;
+    }
+
+    bool binary_search(const double value) const noexcept {
+      const int position = lower_bound(value);
+      return position <= size() && !ordering::number_less<double>(value, data_[position - 1]);
+    }
+
+    void nth_element(const int n) {
+      if (n < 1 || static_cast<size_t>(n) > size_) {
+        return;
+      }
+
+      std::nth_element(data_, data_ + (n - 1), data_ + size_, ordering::number_less<T>);
+    }
+
+    // Owned copy, also the way to detach a view from its File
+    TypedArray copy() const {
+      TypedArray out;
+      out.resize(size_);
+      std::copy_n(data_, size_, out.data_);
+      return out;
+    }
+
+    static TypedArray from_table(const sol::table& table) {
+      TypedArray out;
+      const size_t size = table.size();
+
+      out.resize(size);
+      for (size_t i = 1; i <= size; ++i) {
+        out.data_[i - 1] = store(static_cast<compute_t>(table.get<sol::optional<double>>(i).value_or(0.0)));
+      }
+
+      return out;
+    }
+
+    sol::as_table_t<std::vector<T>> to_table() const {
+      return sol::as_table(std::vector<T>(data_, data_ + size_));
+    }
+
+    // Views `count` elements of `file` starting at the 1-based byte `offset` without copying. Without
+    // `count`, the view covers the rest of the file. The offset has to be aligned to the element size;
+    // File:read_array decodes unaligned or byte-swapped data instead.
+    static TypedArray view(const sol::object& file, const int64_t offset, const sol::optional<int64_t> count);
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<TypedArray> user_type = lua_state.new_usertype<TypedArray>(name(),
+        sol::constructors<TypedArray(), TypedArray(int)>(),
+        "size", &TypedArray::size,
+        "empty", &TypedArray::empty,
+        "is_view", &TypedArray::is_view,
+        "get", &TypedArray::get,
+        "set", &TypedArray::set,
+        "fill", &TypedArray::fill,
+        "add", &TypedArray::add,
+        "sub", &TypedArray::sub,
+        "mul", &TypedArray::mul,
+        "fma", &TypedArray::fma,
+        "clamp", &TypedArray::clamp,
+        "sum", &TypedArray::sum,
+        "dot", &TypedArray::dot,
+        "min", &TypedArray::min,
+        "max", &TypedArray::max,
+        "sort", &TypedArray::sort,
+        "lower_bound", &TypedArray::lower_bound,
+        "upper_bound", &TypedArray::upper_bound,
+        "binary_search", &TypedArray::binary_search,
+        "nth_element", &TypedArray::nth_element,
+        "copy", &TypedArray::copy,
+        "from_table", &TypedArray::from_table,
+        "to_table", &TypedArray::to_table,
+        "view", &TypedArray::view
+      );
+
+      user_type[sol::meta_function::length] = [](const TypedArray& typed_array) {
+        return typed_array.size();
+      };
+
+      user_type[sol::meta_function::to_string] = [](const TypedArray& typed_array) {
+        return type_name() + "(" + std::to_string(typed_array.size_) + ")";
+      };
+
+      user_type[sol::meta_function::index] = [](const TypedArray& typed_array, const sol::stack_object key, const sol::this_state this_state) {
+        if (key.get_type() == sol::type::number) {
+          return make_object(this_state, typed_array.get(static_cast<int>(key.as<double>())));
+        }
+
+        return make_object(this_state, sol::lua_nil);
+      };
+
+      user_type[sol::meta_function::new_index] = [](TypedArray& typed_array, const sol::stack_object key, const double value) {
+        if (key.get_type() == sol::type::number) {
+          typed_array.set(static_cast<int>(key.as<double>()), value);
+        }
+      };
+    }
+  };
+
+  using Float32Array = TypedArray<float>;
+  using Float64Array = TypedArray<double>;
+  using Int32Array = TypedArray<int32_t>;
+  using UInt8Array = TypedArray<uint8_t>;
+
+}
+
+// File decodes into typed arrays and typed arrays view Files, so each header includes the other, and
+// TypedArray::view is defined after File
+#include "Umbra/types/data/file.hpp"
@@ -0,0 +1,619 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/aligned_allocator.hpp"
+#include "Umbra/types/data/matrix4.hpp"
+#include "Umbra/types/data/quaternion.hpp"
+#include "Umbra/types/data/vector2.hpp"
+#include "Umbra/types/data/vector3.hpp"
+#include "Umbra/types/ordered/typed_array.hpp"
+#include "Umbra/types/simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  template<class Vector>
+  struct vector_array_name;
+
+  template<> struct vector_array_name<Vector2> { static constexpr const char* value = "Vector2Array"; };
+  template<> struct vector_array_name<Vector3> { static constexpr const char* value = "Vector3Array"; };
+
+  // Growable array of vectors stored as structure-of-arrays: one aligned float buffer per component.
+  // Every kernel is a loop over whole component buffers, with no per-element userdata and no gather,
+  // so a particle or crowd update is one native call. The kernels that mix components per element
+  // (add_scaled, normalize, dot, transform) step four elements at a time with SSE2 or NEON.
+  //
+  // Mutating kernels work in place. Kernels that take another array require it to have the same size,
+  // and most of them also accept a single vector that is applied to every element.
+  template<class Vector>
+  struct UMBRA_API VectorArray final : IType {
+    static constexpr size_t N = std::size(type_traits<Vector>::components);
+
+    using component_t = std::vector<float, AlignedAllocator<float>>;
+
+  private:
+    std::array<component_t, N> components_;
+
+    static std::string type_name() {
+      return vector_array_name<Vector>::value;
+    }
+
+    void check_size(const VectorArray& other, const char* operation) const {
+      if (other.size() != size()) {
+        umbra_fail(type_name() + ": " + operation + " size mismatch (" + std::to_string(size()) + " and " + std::to_string(other.size()) + ")");
+      }
+    }
+
+    // Applies op(component_value, operand_value) per component, where the operand is another array of
+    // the same size or a single vector broadcast to every element
+    template<class Op>
+    void apply(const sol::object& value, const char* operation, Op op) {
+      if (value.is<VectorArray>()) {
+        const VectorArray& other = value.as<const VectorArray&>();
+        check_size(other, operation);
+
+        for (size_t c = 0; c < N; ++c) {
+          float* out = components_[c].data();
+          const float* in = other.components_[c].data();
+          for (size_t i = 0, count = components_[c].size(); i < count; ++i) {
+            out[i] = op(out[i], in[i]);
+          }
+        }
+
+        return;
+      }
+
+      if (!value.is<Vector>()) {
+        umbra_fail(type_name() + ": " + operation + " expects a " + type_traits<Vector>::name + " or " + type_name());
+      }
+
+      const Vector& vector = value.as<const Vector&>();
+      for (size_t c = 0; c < N; ++c) {
+        float* out = components_[c].data();
+        const auto in = static_cast<float>(vector.*type_traits<Vector>::components[c]);
+        for (size_t i = 0, count = components_[c].size(); i < count; ++i) {
+          out[i] = op(out[i], in);
+        }
+      }
+    }
+
+  public:
+    const char* name() override { return vector_array_name<Vector>::value; }
+
+    VectorArray() noexcept = default;
+
+    // Zero-filled
+    explicit VectorArray(const int count) {
+      resize(count);
+    }
+
+    int size() const noexcept { return static_cast<int>(components_[0].size()); }
+    int capacity() const noexcept { return static_cast<int>(components_[0].capacity()); }
+    bool empty() const noexcept { return components_[0].empty(); }
+
+    float* component(const size_t c) noexcept { return components_[c].data(); }
+    const float* component(const size_t c) const noexcept { return components_[c].data(); }
+
+    void clear() noexcept {
+      for (component_t& values : components_) {
+        values.clear();
+      }
+    }
+
+    void reserve(const int count) {
+      for (component_t& values : components_) {
+        values.reserve(std::abs(count));
+      }
+    }
+
+    // New elements are zero
+    void resize(const int count) {
+      for (component_t& values : components_) {
+        values.resize(static_cast<size_t>(std::max(0, count)));
+      }
+    }
+
+    void push(const Vector& vector) {
+      for (size_t c = 0; c < N; ++c) {
+        components_[c].push_back(static_cast<float>(vector.*type_traits<Vector>::components[c]));
+      }
+    }
+
+    std::optional<Vector> get(const int index) const noexcept {
+      if (index < 1 || index > size()) {
+        return std::nullopt;
+      }
+
+      Vector out;
+      for (size_t c = 0; c < N; ++c) {
+        out.*type_traits<Vector>::components[c] = components_[c][index - 1];
+      }
+
+      return out;
+    }
+
+    void set(const int index, const Vector& vector) noexcept {
+      if (index < 1 || index > size()) {
+        return;
+      }
+
+      for (size_t c = 0; c < N; ++c) {
+        components_[c][index - 1] = static_cast<float>(vector.*type_traits<Vector>::components[c]);
+      }
+    }
+
+    void add(const sol::object& value) {
+      apply(value, "add", [](const float a, const float b) { return a + b; });
+    }
+
+    void sub(const sol::object& value) {
+      apply(value, "sub", [](const float a, const float b) { return a - b; });
+    }
+
+    // Component-wise product with another array or a vector
+    void mul(const sol::object& value) {
+      apply(value, "mul", [](const float a, const float b) { return a * b; });
+    }
+
+    void scale(const double scalar) noexcept {
+      const auto factor = static_cast<float>(scalar);
+      for (component_t& values : components_) {
+        for (float& value : values) {
+          value *= factor;
+        }
+      }
+    }
+
+    // this += other * scalar, the usual `positions:add_scaled(velocities, dt)` integration step
+    void add_scaled(const VectorArray& other, const double scalar) {
+      check_size(other, "add_scaled");
+
+      const auto factor = static_cast<float>(scalar);
+      for (size_t c = 0; c < N; ++c) {
+        float* out = components_[c].data();
+        const float* in = other.components_[c].data();
+        const size_t count = components_[c].size();
+
+        size_t i = 0;
+#if UMBRA_SIMD_FLOAT4
+        const simd::float4 factors = simd::splat(factor);
+        for (; i + 4 <= count; i += 4) {
+          simd::store(out + i, simd::madd(simd::load(out + i), simd::load(in + i), factors));
+        }
+#endif
+        for (; i < count; ++i) {
+          out[i] += in[i] * factor;
+        }
+      }
+    }
+
+    void lerp(const sol::object& value, const double alpha) {
+      const auto t = static_cast<float>(alpha);
+      apply(value, "lerp", [t](const float a, const float b) { return a + (b - a) * t; });
+    }
+
+    // Zero-length vectors stay zero
+    void normalize() noexcept {
+      std::array<float*, N> v;
+      for (size_t c = 0; c < N; ++c) {
+        v[c] = components_[c].data();
+      }
+
+      const size_t count = components_[0].size();
+      size_t i = 0;
+#if UMBRA_SIMD_FLOAT4
+      for (; i + 4 <= count; i += 4) {
+        simd::float4 in[N];
+        for (size_t c = 0; c < N; ++c) {
+          in[c] = simd::load(v[c] + i);
+        }
+
+        simd::float4 length_squared = simd::mul(in[0], in[0]);
+        for (size_t c = 1; c < N; ++c) {
+          length_squared = simd::madd(length_squared, in[c], in[c]);
+        }
+
+        const simd::float4 inverse = simd::inverse_sqrt(length_squared);
+        for (size_t c = 0; c < N; ++c) {
+          simd::store(v[c] + i, simd::mul(in[c], inverse));
+        }
+      }
+#endif
+      for (; i < count; ++i) {
+        float length_squared = 0.0f;
+        for (size_t c = 0; c < N; ++c) {
+          length_squared += v[c][i] * v[c][i];
+        }
+
+        const float inverse = length_squared > 0.0f ? 1.0f / std::sqrt(length_squared) : 0.0f;
+        for (size_t c = 0; c < N; ++c) {
+          v[c][i] *= inverse;
+        }
+      }
+    }
+
+    Float32Array lengths() const {
+      Float32Array out(size());
+      float* lengths = out.data();
+
+      for (size_t c = 0; c < N; ++c) {
+        const float* in = components_[c].data();
+        for (size_t i = 0, count = components_[c].size(); i < count; ++i) {
+          lengths[i] += in[i] * in[i];
+        }
+      }
+
+      for (size_t i = 0, count = components_[0].size(); i < count; ++i) {
+        lengths[i] = std::sqrt(lengths[i]);
+      }
+
+      return out;
+    }
+
+    // Per-element dot products with another array or a single vector
+    Float32Array dot(const sol::object& value) const {
+      Float32Array out(size());
+      float* dots = out.data();
+      const size_t count = components_[0].size();
+
+      if (value.is<VectorArray>()) {
+        const VectorArray& other = value.as<const VectorArray&>();
+        check_size(other, "dot");
+
+        size_t i = 0;
+#if UMBRA_SIMD_FLOAT4
+        for (; i + 4 <= count; i += 4) {
+          simd::float4 sum = simd::splat(0.0f);
+          for (size_t c = 0; c < N; ++c) {
+            sum = simd::madd(sum, simd::load(components_[c].data() + i), simd::load(other.components_[c].data() + i));
+          }
+
+          simd::store(dots + i, sum);
+        }
+#endif
+        for (; i < count; ++i) {
+          for (size_t c = 0; c < N; ++c) {
+            dots[i] += components_[c][i] * other.components_[c][i];
+          }
+        }
+
+        return out;
+      }
+
+      if (!value.is<Vector>()) {
+        umbra_fail(type_name() + ": dot expects a " + type_traits<Vector>::name + " or " + type_name());
+      }
+
+      const Vector& vector = value.as<const Vector&>();
+      float b[N];
+      for (size_t c = 0; c < N; ++c) {
+        b[c] = static_cast<float>(vector.*type_traits<Vector>::components[c]);
+      }
+
+      size_t i = 0;
+#if UMBRA_SIMD_FLOAT4
+      simd::float4 splats[N];
+      for (size_t c = 0; c < N; ++c) {
+        splats[c] = simd::splat(b[c]);
+      }
+
+      for (; i + 4 <= count; i += 4) {
+        simd::float4 sum = simd::splat(0.0f);
+        for (size_t c = 0; c < N; ++c) {
+          sum = simd::madd(sum, simd::load(components_[c].data() + i), splats[c]);
+        }
+
+        simd::store(dots + i, sum);
+      }
+#endif
+      for (; i < count; ++i) {
+        for (size_t c = 0; c < N; ++c) {
+          dots[i] += components_[c][i] * b[c];
+        }
+      }
+
+      return out;
+    }
+
+    // this = this x other, with another array or a single vector
+    void cross(const sol::object& value) requires (N == 3) {
+      float* x = components_[0].data();
+      float* y = components_[1].data();
+      float* z = components_[2].data();
+      const size_t count = components_[0].size();
+
+      if (value.is<VectorArray>()) {
+        const VectorArray& other = value.as<const VectorArray&>();
+        check_size(other, "cross");
+
+        const float* ox = other.components_[0].data();
+        const float* oy = other.components_[1].data();
+        const float* oz = other.components_[2].data();
+        for (size_t i = 0; i < count; ++i) {
+          const float cx = y[i] * oz[i] - z[i] * oy[i];
+          const float cy = z[i] * ox[i] - x[i] * oz[i];
+          const float cz = x[i] * oy[i] - y[i] * ox[i];
+          x[i] = cx;
+          y[i] = cy;
+          z[i] = cz;
+        }
+
+        return;
+      }
+
+      if (!value.is<Vector3>()) {
+        umbra_fail(type_name() + ": cross expects a Vector3 or " + type_name());
+      }
+
+      const Vector3& vector = value.as<const Vector3&>();
+      const auto ox = static_cast<float>(vector.x);
+      const auto oy = static_cast<float>(vector.y);
+      const auto oz = static_cast<float>(vector.z);
+      for (size_t i = 0; i < count; ++i) {
+        const float cx = y[i] * oz - z[i] * oy;
+        const float cy = z[i] * ox - x[i] * oz;
+        const float cz = x[i] * oy - y[i] * ox;
+        x[i] = cx;
+        y[i] = cy;
+        z[i] = cz;
+      }
+    }
+
+    // Axis-aligned bounds as (min, max), nil when empty
+    std::tuple<std::optional<Vector>, std::optional<Vector>> bounds() const noexcept {
+      if (empty()) {
+        return { std::nullopt, std::nullopt };
+      }
+
+      Vector low;
+      Vector high;
+      for (size_t c = 0; c < N; ++c) {
+        const auto [min, max] = std::minmax_element(components_[c].begin(), components_[c].end());
+        low.*type_traits<Vector>::components[c] = *min;
+        high.*type_traits<Vector>::components[c] = *max;
+      }
+
+      return { low, high };
+    }
+
+    // Rotates every element by the unit quaternion (w, x, y, z), using v' = v + 2w(q x v) + 2q x (q x v)
+    void rotate(const double w, const double x, const double y, const double z) noexcept requires (N == 3) {
+      const auto qw = static_cast<float>(w);
+      const auto qx = static_cast<float>(x);
+      const auto qy = static_cast<float>(y);
+      const auto qz = static_cast<float>(z);
+
+      float* vx = components_[0].data();
+      float* vy = components_[1].data();
+      float* vz = components_[2].data();
+      for (size_t i = 0, count = components_[0].size(); i < count; ++i) {
+        const float tx = 2.0f * (qy * vz[i] - qz * vy[i]);
+        const float ty = 2.0f * (qz * vx[i] - qx * vz[i]);
+        const float tz = 2.0f * (qx * vy[i] - qy * vx[i]);
+
+        vx[i] += qw * tx + (qy * tz - qz * ty);
+        vy[i] += qw * ty + (qz * tx - qx * tz);
+        vz[i] += qw * tz + (qx * ty - qy * tx);
+      }
+    }
+
+    void rotate(const Quaternion& rotation) noexcept requires (N == 3) {
+      rotate(rotation.w, rotation.x, rotation.y, rotation.z);
+    }
+
+    // Rotates every element counter-clockwise by `angle` radians
+    void rotate(const double angle) noexcept requires (N == 2) {
+      const auto c = static_cast<float>(std::cos(angle));
+      const auto s = static_cast<float>(std::sin(angle));
+
+      float* vx = components_[0].data();
+      float* vy = components_[1].data();
+      for (size_t i = 0, count = components_[0].size(); i < count; ++i) {
+        const float x = vx[i];
+        vx[i] = c * x - s * vy[i];
+        vy[i] = s * x + c * vy[i];
+      }
+    }
+
+    // Applies a row-major affine matrix given as a table: the top N rows of an (N + 1) x (N + 1) matrix,
+    // or the whole matrix with its last row ignored. Translation is the last column, as in Ogre::Matrix4.
+    void transform(const sol::table& matrix) {
+      constexpr size_t COLUMNS = N + 1;
+
+      const size_t length = matrix.size();
+      if (length != N * COLUMNS && length != COLUMNS * COLUMNS) {
+        umbra_fail(type_name() + ": transform expects " + std::to_string(N * COLUMNS) + " or " + std::to_string(COLUMNS * COLUMNS) + " numbers");
+      }
+
+      float m[N][COLUMNS];
+      for (size_t row = 0; row < N; ++row) {
+        for (size_t column = 0; column < COLUMNS; ++column) {
+          m[row][column] = matrix.get<float>(row * COLUMNS + column + 1);
+        }
+      }
+
+      transform(m);
+    }
+
+    void transform(const float (&m)[N][N + 1]) noexcept {
+      std::array<float*, N> v;
+      for (size_t c = 0; c < N; ++c) {
+        v[c] = components_[c].data();
+      }
+
+      const size_t count = components_[0].size();
+      size_t i = 0;
+#if UMBRA_SIMD_FLOAT4
+      simd::float4 splats[N][N + 1];
+      for (size_t row = 0; row < N; ++row) {
+        for (size_t column = 0; column <= N; ++column) {
+          splats[row][column] = simd::splat(m[row][column]);
+        }
+      }
+
+      for (; i + 4 <= count; i += 4) {
+        simd::float4 in[N];
+        for (size_t c = 0; c < N; ++c) {
+          in[c] = simd::load(v[c] + i);
+        }
+
+        for (size_t row = 0; row < N; ++row) {
+          simd::float4 out = splats[row][N];
+          for (size_t column = 0; column < N; ++column) {
+            out = simd::madd(out, splats[row][column], in[column]);
+          }
+
+          simd::store(v[row] + i, out);
+        }
+      }
+#endif
+      for (; i < count; ++i) {
+        float in[N];
+        for (size_t c = 0; c < N; ++c) {
+          in[c] = v[c][i];
+        }
+
+        for (size_t row = 0; row < N; ++row) {
+          float out = m[row][N];
+          for (size_t column = 0; column < N; ++column) {
+            out += m[row][column] * in[column];
+          }
+
+          v[row][i] = out;
+        }
+      }
+    }
+
+    // Transforms every element as a point by the affine part of the matrix
+    void transform(const Matrix4& matrix) noexcept requires (N == 3) {
+      float m[N][N + 1];
+      for (size_t row = 0; row < N; ++row) {
+        for (size_t column = 0; column <= N; ++column) {
+          m[row][column] = static_cast<float>(matrix.m[row][column]);
+        }
+      }
+
+      transform(m);
+    }
+
+    // Bulk conversion from and to any vector with float x/y(/z) members, such as Ogre::Vector3 vertex or
+    // instance buffers
+    template<class Source>
+    void read_from(const Source* source, const size_t count) {
+      for (component_t& values : components_) {
+        values.resize(count);
+      }
+
+      for (size_t i = 0; i < count; ++i) {
+        components_[0][i] = source[i].x;
+        components_[1][i] = source[i].y;
+        if constexpr (N == 3) {
+          components_[2][i] = source[i].z;
+        }
+      }
+    }
+
+    template<class Target>
+    void write_to(Target* target) const {
+      for (size_t i = 0, count = components_[0].size(); i < count; ++i) {
+        target[i].x = components_[0][i];
+        target[i].y = components_[1][i];
+        if constexpr (N == 3) {
+          target[i].z = components_[2][i];
+        }
+      }
+    }
+
+    VectorArray copy() const {
+      VectorArray out;
+      out.components_ = components_;
+      return out;
+    }
+
+    static VectorArray from_table(const sol::table& table) {
+      VectorArray out;
+      const size_t size = table.size();
+
+      out.reserve(static_cast<int>(size));
+      for (size_t i = 1; i <= size; ++i) {
+        out.push(table.get<Vector>(i));
+      }
+
+      return out;
+    }
+
+    sol::as_table_t<std::vector<Vector>> to_table() const {
+      std::vector<Vector> out;
+      out.reserve(components_[0].size());
+
+      for (int i = 1; i <= size(); ++i) {
+        out.push_back(*get(i));
+      }
+
+      return sol::as_table(std::move(out));
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<VectorArray> user_type = lua_state.new_usertype<VectorArray>(name(),
+        sol::constructors<VectorArray(), VectorArray(int)>(),
+        "size", &VectorArray::size,
+        "capacity", &VectorArray::capacity,
+        "empty", &VectorArray::empty,
+        "clear", &VectorArray::clear,
+        "reserve", &VectorArray::reserve,
+        "resize", &VectorArray::resize,
+        "push", &VectorArray::push,
+        "get", &VectorArray::get,
+        "set", &VectorArray::set,
+        "add", &VectorArray::add,
+        "sub", &VectorArray::sub,
+        "mul", &VectorArray::mul,
+        "scale", &VectorArray::scale,
+        "add_scaled", &VectorArray::add_scaled,
+        "lerp", &VectorArray::lerp,
+        "normalize", &VectorArray::normalize,
+        "lengths", &VectorArray::lengths,
+        "dot", &VectorArray::dot,
+        "bounds", &VectorArray::bounds,
+        "copy", &VectorArray::copy,
+        "from_table", &VectorArray::from_table,
+        "to_table", &VectorArray::to_table
+      );
+
+      if constexpr (N == 3) {
+        user_type["cross"] = &VectorArray::cross;
+        user_type["rotate"] = sol::overload(
+          static_cast<void (VectorArray::*)(const Quaternion&) noexcept>(&VectorArray::rotate),
+          static_cast<void (VectorArray::*)(double, double, double, double) noexcept>(&VectorArray::rotate)
+        );
+        user_type["transform"] = sol::overload(
+          static_cast<void (VectorArray::*)(const Matrix4&) noexcept>(&VectorArray::transform),
+          static_cast<void (VectorArray::*)(const sol::table&)>(&VectorArray::transform)
+        );
+      } else {
+        user_type["rotate"] = static_cast<void (VectorArray::*)(double) noexcept>(&VectorArray::rotate);
+        user_type["transform"] = static_cast<void (VectorArray::*)(const sol::table&)>(&VectorArray::transform);
+      }
+
+      user_type[sol::meta_function::length] = [](const VectorArray& vector_array) {
+        return vector_array.size();
+      };
+
+      user_type[sol::meta_function::to_string] = [](const VectorArray& vector_array) {
+        return type_name() + "(" + std::to_string(vector_array.size()) + ")";
+      };
+    }
+  };
+
+  using Vector2Array = VectorArray<Vector2>;
+  using Vector3Array = VectorArray<Vector3>;
+
+}
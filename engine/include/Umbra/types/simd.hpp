@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// SSE2 is part of every x86-64 target and NEON, with the float divide and square root used here, of every
+// AArch64 one, so these paths are always on there. Other targets use the scalar loops only.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UMBRA_SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#define UMBRA_SIMD_SSE2 0
+#endif
+
+#if !UMBRA_SIMD_SSE2 && defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define UMBRA_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define UMBRA_SIMD_NEON 0
+#endif
+
+// 4-wide float operations below are available
+#define UMBRA_SIMD_FLOAT4 (UMBRA_SIMD_SSE2 || UMBRA_SIMD_NEON)
+
+namespace umbra::simd {
+
+  // Bulk kernels for the typed containers. Each one handles a prefix of the buffers a whole vector
+  // register at a time and returns its length, leaving the remaining elements to the caller's scalar
+  // loop. Without a vector instruction set, or for element types they do not cover, they return 0.
+
+  // data[i] = saturate(data[i] + in[i])
+  template<class T>
+  size_t add_saturate(T*, const T*, size_t) noexcept { return 0; }
+
+  // data[i] = saturate(data[i] + scalar)
+  template<class T>
+  size_t add_saturate(T*, T, size_t) noexcept { return 0; }
+
+  // data[i] = saturate(data[i] - in[i])
+  template<class T>
+  size_t sub_saturate(T*, const T*, size_t) noexcept { return 0; }
+
+  // data[i] = saturate(data[i] - scalar)
+  template<class T>
+  size_t sub_saturate(T*, T, size_t) noexcept { return 0; }
+
+#if UMBRA_SIMD_SSE2
+
+  namespace detail {
+    // SSE2 only saturates 8 and 16 bit lanes. An int32 lane overflows when the result's sign differs from
+    // the sign the operands imply, and then saturates towards the sign of `a`.
+    inline __m128i select_saturated(const __m128i a, const __m128i result, const __m128i overflow_sign) noexcept {
+      const __m128i overflow = _mm_srai_epi32(overflow_sign, 31);
+      const __m128i saturated = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(INT32_MAX));
+      return _mm_or_si128(_mm_and_si128(overflow, saturated), _mm_andnot_si128(overflow, result));
+    }
+
+    inline __m128i add_saturate(const __m128i a, const __m128i b) noexcept {
+      const __m128i sum = _mm_add_epi32(a, b);
+      return select_saturated(a, sum, _mm_andnot_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, sum)));
+    }
+
+    inline __m128i sub_saturate(const __m128i a, const __m128i b) noexcept {
+      const __m128i difference = _mm_sub_epi32(a, b);
+      return select_saturated(a, difference, _mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, difference)));
+    }
+
+    inline __m128i load(const void* source) noexcept { return _mm_loadu_si128(static_cast<const __m128i*>(source)); }
+    inline void store(void* target, const __m128i value) noexcept { _mm_storeu_si128(static_cast<__m128i*>(target), value); }
+  }
+
+  inline size_t add_saturate(int32_t* data, const int32_t* in, const size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      detail::store(data + i, detail::add_saturate(detail::load(data + i), detail::load(in + i)));
+    }
+    return i;
+  }
+
+  inline size_t add_saturate(int32_t* data, const int32_t scalar, const size_t count) noexcept {
+    const __m128i operand = _mm_set1_epi32(scalar);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      detail::store(data + i, detail::add_saturate(detail::load(data + i), operand));
+    }
+    return i;
+  }
+
+  inline size_t sub_saturate(int32_t* data, const int32_t* in, const size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      detail::store(data + i, detail::sub_saturate(detail::load(data + i), detail::load(in + i)));
+    }
+    return i;
+  }
+
+  inline size_t sub_saturate(int32_t* data, const int32_t scalar, const size_t count) noexcept {
+    const __m128i operand = _mm_set1_epi32(scalar);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      detail::store(data + i, detail::sub_saturate(detail::load(data + i), operand));
+    }
+    return i;
+  }
+
+  inline size_t add_saturate(uint8_t* data, const uint8_t* in, const size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      detail::store(data + i, _mm_adds_epu8(detail::load(data + i), detail::load(in + i)));
+    }
+    return i;
+  }
+
+  inline size_t add_saturate(uint8_t* data, const uint8_t scalar, const size_t count) noexcept {
+    const __m128i operand = _mm_set1_epi8(static_cast<char>(scalar));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      detail::store(data + i, _mm_adds_epu8(detail::load(data + i), operand));
+    }
+    return i;
+  }
+
+  inline size_t sub_saturate(uint8_t* data, const uint8_t* in, const size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      detail::store(data + i, _mm_subs_epu8(detail::load(data + i), detail::load(in + i)));
+    }
+    return i;
+  }
+
+  inline size_t sub_saturate(uint8_t* data, const uint8_t scalar, const size_t count) noexcept {
+    const __m128i operand = _mm_set1_epi8(static_cast<char>(scalar));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      detail::store(data + i, _mm_subs_epu8(detail::load(data + i), operand));
+    }
+    return i;
+  }
+
+#elif UMBRA_SIMD_NEON
+
+  inline size_t add_saturate(int32_t* data, const int32_t* in, const size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      vst1q_s32(data + i, vqaddq_s32(vld1q_s32(data + i), vld1q_s32(in + i)));
+    }
+    return i;
+  }
+
+  inline size_t add_saturate(int32_t* data, const int32_t scalar, const size_t count) noexcept {
+    const int32x4_t operand = vdupq_n_s32(scalar);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      vst1q_s32(data + i, vqaddq_s32(vld1q_s32(data + i), operand));
+    }
+    return i;
+  }
+
+  inline size_t sub_saturate(int32_t* data, const int32_t* in, const size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      vst1q_s32(data + i, vqsubq_s32(vld1q_s32(data + i), vld1q_s32(in + i)));
+    }
+    return i;
+  }
+
+  inline size_t sub_saturate(int32_t* data, const int32_t scalar, const size_t count) noexcept {
+    const int32x4_t operand = vdupq_n_s32(scalar);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      vst1q_s32(data + i, vqsubq_s32(vld1q_s32(data + i), operand));
+    }
+    return i;
+  }
+
+  inline size_t add_saturate(uint8_t* data, const uint8_t* in, const size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      vst1q_u8(data + i, vqaddq_u8(vld1q_u8(data + i), vld1q_u8(in + i)));
+    }
+    return i;
+  }
+
+  inline size_t add_saturate(uint8_t* data, const uint8_t scalar, const size_t count) noexcept {
+    const uint8x16_t operand = vdupq_n_u8(scalar);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      vst1q_u8(data + i, vqaddq_u8(vld1q_u8(data + i), operand));
+    }
+    return i;
+  }
+
+  inline size_t sub_saturate(uint8_t* data, const uint8_t* in, const size_t count) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      vst1q_u8(data + i, vqsubq_u8(vld1q_u8(data + i), vld1q_u8(in + i)));
+    }
+    return i;
+  }
+
+  inline size_t sub_saturate(uint8_t* data, const uint8_t scalar, const size_t count) noexcept {
+    const uint8x16_t operand = vdupq_n_u8(scalar);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      vst1q_u8(data + i, vqsubq_u8(vld1q_u8(data + i), operand));
+    }
+    return i;
+  }
+
+#endif
+
+#if UMBRA_SIMD_SSE2
+
+  using float4 = __m128;
+
+  inline float4 load(const float* source) noexcept { return _mm_loadu_ps(source); }
+  inline void store(float* target, const float4 value) noexcept { _mm_storeu_ps(target, value); }
+  inline float4 splat(const float value) noexcept { return _mm_set1_ps(value); }
+  inline float4 add(const float4 a, const float4 b) noexcept { return _mm_add_ps(a, b); }
+  inline float4 sub(const float4 a, const float4 b) noexcept { return _mm_sub_ps(a, b); }
+  inline float4 mul(const float4 a, const float4 b) noexcept { return _mm_mul_ps(a, b); }
+  inline float4 set(const float a, const float b, const float c, const float d) noexcept { return _mm_setr_ps(a, b, c, d); }
+
+  // Lanes (v[A], v[B], v[C], v[D])
+  template<int A, int B, int C, int D>
+  float4 shuffle(const float4 v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(D, C, B, A)); }
+
+  // Rows become columns
+  inline void transpose(float4& a, float4& b, float4& c, float4& d) noexcept { _MM_TRANSPOSE4_PS(a, b, c, d); }
+
+  // 1 / sqrt(x), or 0 where x is not positive
+  inline float4 inverse_sqrt(const float4 x) noexcept {
+    const float4 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x));
+    return _mm_and_ps(_mm_cmpgt_ps(x, _mm_setzero_ps()), inverse);
+  }
+
+#elif UMBRA_SIMD_NEON
+
+  using float4 = float32x4_t;
+
+  inline float4 load(const float* source) noexcept { return vld1q_f32(source); }
+  inline void store(float* target, const float4 value) noexcept { vst1q_f32(target, value); }
+  inline float4 splat(const float value) noexcept { return vdupq_n_f32(value); }
+  inline float4 add(const float4 a, const float4 b) noexcept { return vaddq_f32(a, b); }
+  inline float4 sub(const float4 a, const float4 b) noexcept { return vsubq_f32(a, b); }
+  inline float4 mul(const float4 a, const float4 b) noexcept { return vmulq_f32(a, b); }
+
+  inline float4 set(const float a, const float b, const float c, const float d) noexcept {
+    const float lanes[4] = { a, b, c, d };
+    return vld1q_f32(lanes);
+  }
+
+  template<int A, int B, int C, int D>
+  float4 shuffle(const float4 v) noexcept {
+#if defined(__clang__) || defined(__GNUC__)
+    return __builtin_shufflevector(v, v, A, B, C, D);
+#else
+    return set(vgetq_lane_f32(v, A), vgetq_lane_f32(v, B), vgetq_lane_f32(v, C), vgetq_lane_f32(v, D));
+#endif
+  }
+
+  inline void transpose(float4& a, float4& b, float4& c, float4& d) noexcept {
+    const float32x4x2_t ac = vzipq_f32(a, c);
+    const float32x4x2_t bd = vzipq_f32(b, d);
+    const float32x4x2_t low = vzipq_f32(ac.val[0], bd.val[0]);
+    const float32x4x2_t high = vzipq_f32(ac.val[1], bd.val[1]);
+    a = low.val[0];
+    b = low.val[1];
+    c = high.val[0];
+    d = high.val[1];
+  }
+
+  inline float4 inverse_sqrt(const float4 x) noexcept {
+    const float4 inverse = vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(x));
+    return vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(x, vdupq_n_f32(0.0f)), vreinterpretq_u32_f32(inverse)));
+  }
+
+#endif
+
+#if UMBRA_SIMD_FLOAT4
+
+  // a + b * c, rounded after the product like the scalar loops rather than fused
+  inline float4 madd(const float4 a, const float4 b, const float4 c) noexcept { return add(a, mul(b, c)); }
+
+#endif
+
+}
@@ -0,0 +1,417 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/data/vector3.hpp"
+#include "Umbra/types/spatial/spatial.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  // Dynamic bounding volume hierarchy over 3D boxes. Leaves hold a fattened copy of each box, grown by
+  // the margin, so an object that moves a little updates only its own record; the tree changes only
+  // once it leaves its fat box. Insertion picks the sibling by the surface area heuristic and AVL
+  // rotations keep the tree balanced, so queries stay logarithmic under constant churn.
+  //
+  // Handles are positive integers that go stale on remove, and queries return them in an Int32Array.
+  struct UMBRA_API Bvh final : IType {
+  private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    static constexpr double DEFAULT_MARGIN = 0.1;
+
+    struct Node {
+      spatial::Box<3> box;
+      uint32_t parent = NONE;
+      uint32_t left = NONE;
+      uint32_t right = NONE;
+      int32_t height = 0;
+      int32_t handle = 0;
+
+      bool leaf() const noexcept { return left == NONE; }
+    };
+
+    struct Object {
+      spatial::Box<3> box;
+      uint32_t leaf = NONE;
+    };
+
+    float margin_ = static_cast<float>(DEFAULT_MARGIN);
+    uint32_t root_ = NONE;
+
+    spatial::HandlePool handles_;
+    std::vector<Object> objects_;
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> free_;
+
+    Object& object(const int32_t handle) noexcept {
+      return objects_[spatial::HandlePool::index(handle)];
+    }
+
+    const Object& object(const int32_t handle) const noexcept {
+      return objects_[spatial::HandlePool::index(handle)];
+    }
+
+    uint32_t allocate() {
+      if (!free_.empty()) {
+        const uint32_t node = free_.back();
+        free_.pop_back();
+        nodes_[node] = Node();
+        return node;
+      }
+
+      nodes_.emplace_back();
+      return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+    void release(const uint32_t node) {
+      free_.push_back(node);
+    }
+
+    void refit(const uint32_t node) noexcept {
+      Node& target = nodes_[node];
+      target.box = nodes_[target.left].box.merged(nodes_[target.right].box);
+      target.height = 1 + std::max(nodes_[target.left].height, nodes_[target.right].height);
+    }
+
+    // Replaces `from` with `to` among the children of `parent`, or as the root
+    void relink(const uint32_t parent, const uint32_t from, const uint32_t to) noexcept {
+      if (parent == NONE) {
+        root_ = to;
+      } else if (nodes_[parent].left == from) {
+        nodes_[parent].left = to;
+      } else {
+        nodes_[parent].right = to;
+      }
+    }
+
+    // Promotes the taller grandchild when the subtree at `a` leans by more than one level, and returns
+    // the subtree's new root
+    uint32_t balance(const uint32_t a) noexcept {
+      if (nodes_[a].leaf() || nodes_[a].height < 2) {
+        return a;
+      }
+
+      const uint32_t b = nodes_[a].left;
+      const uint32_t c = nodes_[a].right;
+      const int32_t lean = nodes_[c].height - nodes_[b].height;
+
+      if (lean > 1) {
+        return rotate(a, c, true);
+      }
+
+      if (lean < -1) {
+        return rotate(a, b, false);
+      }
+
+      return a;
+    }
+
+    // Rotates the tall child `up` above `a`; `up_was_right` tells which side of `a` held it
+    uint32_t rotate(const uint32_t a, const uint32_t up, const bool up_was_right) noexcept {
+      const uint32_t f = nodes_[up].left;
+      const uint32_t g = nodes_[up].right;
+
+      nodes_[up].left = a;
+      nodes_[up].parent = nodes_[a].parent;
+      nodes_[a].parent = up;
+      relink(nodes_[up].parent, a, up);
+
+      // The taller grandchild stays under `up`, the shorter one takes up's old place under `a`
+      const bool keep_f = nodes_[f].height > nodes_[g].height;
+      const uint32_t kept = keep_f ? f : g;
+      const uint32_t moved = keep_f ? g : f;
+
+      nodes_[up].right = kept;
+      if (up_was_right) {
+        nodes_[a].right = moved;
+      } else {
+        nodes_[a].left = moved;
+      }
+
+      nodes_[moved].parent = a;
+
+      refit(a);
+      refit(up);
+
+      return up;
+    }
+
+    void insert_leaf(const uint32_t leaf) {
+      if (root_ == NONE) {
+        root_ = leaf;
+        nodes_[leaf].parent = NONE;
+        return;
+      }
+
+      const spatial::Box<3> box = nodes_[leaf].box;
+
+      // Descend toward the sibling with the lowest total cost
+      uint32_t index = root_;
+      while (!nodes_[index].leaf()) {
+        const uint32_t left = nodes_[index].left;
+        const uint32_t right = nodes_[index].right;
+
+        const float area = nodes_[index].box.cost();
+        const float combined = nodes_[index].box.merged(box).cost();
+
+        const float here = 2.0f * combined;
+        const float inherited = 2.0f * (combined - area);
+
+        const auto descend = [&](const uint32_t child) {
+          const float merged = nodes_[child].box.merged(box).cost();
+          return nodes_[child].leaf() ? merged + inherited : merged - nodes_[child].box.cost() + inherited;
+        };
+
+        const float cost_left = descend(left);
+        const float cost_right = descend(right);
+
+        if (here < cost_left && here < cost_right) {
+          break;
+        }
+
+        index = cost_left < cost_right ? left : right;
+      }
+
+      const uint32_t sibling = index;
+      const uint32_t old_parent = nodes_[sibling].parent;
+      const uint32_t new_parent = allocate();
+
+      nodes_[new_parent].parent = old_parent;
+      nodes_[new_parent].left = sibling;
+      nodes_[new_parent].right = leaf;
+      relink(old_parent, sibling, new_parent);
+
+      nodes_[sibling].parent = new_parent;
+      nodes_[leaf].parent = new_parent;
+      refit(new_parent);
+
+      for (uint32_t node = old_parent; node != NONE; node = nodes_[node].parent) {
+        node = balance(node);
+        refit(node);
+      }
+    }
+
+    void remove_leaf(const uint32_t leaf) {
+      if (leaf == root_) {
+        root_ = NONE;
+        return;
+      }
+
+      const uint32_t parent = nodes_[leaf].parent;
+      const uint32_t grandparent = nodes_[parent].parent;
+      const uint32_t sibling = nodes_[parent].left == leaf ? nodes_[parent].right : nodes_[parent].left;
+
+      relink(grandparent, parent, sibling);
+      nodes_[sibling].parent = grandparent;
+      release(parent);
+
+      for (uint32_t node = grandparent; node != NONE; node = nodes_[node].parent) {
+        node = balance(node);
+        refit(node);
+      }
+    }
+
+    // Depth-first walk over the leaves whose fat box passes `enter`
+    void walk(const auto& enter, const auto& visitor) const {
+      if (root_ == NONE) {
+        return;
+      }
+
+      std::vector<uint32_t> stack = { root_ };
+
+      while (!stack.empty()) {
+        const Node& node = nodes_[stack.back()];
+        stack.pop_back();
+
+        if (!enter(node.box)) {
+          continue;
+        }
+
+        if (node.leaf()) {
+          visitor(node.handle, object(node.handle));
+          continue;
+        }
+
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+      }
+    }
+
+  public:
+    const char* name() override { return "Bvh"; }
+
+    Bvh() = default;
+
+    explicit Bvh(const double margin) {
+      if (!(margin >= 0.0) || !std::isfinite(margin)) {
+        umbra_fail("Bvh: margin must be a non-negative number");
+      }
+
+      margin_ = static_cast<float>(margin);
+    }
+
+    int size() const noexcept { return static_cast<int>(handles_.size()); }
+    bool empty() const noexcept { return handles_.size() == 0; }
+    double margin() const noexcept { return margin_; }
+
+    // Levels below the root, 0 when empty
+    int height() const noexcept { return root_ == NONE ? 0 : nodes_[root_].height; }
+
+    bool contains(const int32_t handle) const noexcept { return handles_.live(handle); }
+
+    void clear() {
+      handles_.clear();
+      objects_.clear();
+      nodes_.clear();
+      free_.clear();
+      root_ = NONE;
+    }
+
+    // Returns the handle of the new object
+    int32_t insert(const Vector3& min, const Vector3& max) {
+      const int32_t handle = handles_.acquire(name());
+
+      if (spatial::HandlePool::index(handle) == objects_.size()) {
+        objects_.emplace_back();
+      }
+
+      const spatial::Box<3> box = spatial::Box<3>::from(min, max);
+      const uint32_t leaf = allocate();
+      nodes_[leaf].box = box.expanded(margin_);
+      nodes_[leaf].handle = handle;
+
+      object(handle) = { box, leaf };
+      insert_leaf(leaf);
+
+      return handle;
+    }
+
+    // Restructures the tree only when the box leaves its fat box. Returns whether the handle was live.
+    bool move(const int32_t handle, const Vector3& min, const Vector3& max) {
+      if (!handles_.live(handle)) {
+        return false;
+      }
+
+      const spatial::Box<3> box = spatial::Box<3>::from(min, max);
+      const uint32_t leaf = object(handle).leaf;
+      object(handle).box = box;
+
+      if (nodes_[leaf].box.contains(box)) {
+        return true;
+      }
+
+      remove_leaf(leaf);
+      nodes_[leaf].box = box.expanded(margin_);
+      insert_leaf(leaf);
+
+      return true;
+    }
+
+    bool remove(const int32_t handle) {
+      if (!handles_.live(handle)) {
+        return false;
+      }
+
+      const uint32_t leaf = object(handle).leaf;
+      remove_leaf(leaf);
+      release(leaf);
+      handles_.release(handle);
+
+      return true;
+    }
+
+    // Handles of every object overlapping the box
+    Int32Array query_box(const Vector3& min, const Vector3& max) const {
+      const spatial::Box<3> box = spatial::Box<3>::from(min, max);
+      std::vector<int32_t> out;
+
+      walk([&](const spatial::Box<3>& node) { return node.overlaps(box); }, [&](const int32_t handle, const Object& target) {
+        if (target.box.overlaps(box)) {
+          out.push_back(handle);
+        }
+      });
+
+      return spatial::to_array(out);
+    }
+
+    // Handles of every object within `radius` of `center`
+    Int32Array query_radius(const Vector3& center, const double radius) const {
+      const spatial::Point<3> origin = spatial::point(center);
+      const auto reach = static_cast<float>(std::abs(radius));
+      const float reach_squared = reach * reach;
+      std::vector<int32_t> out;
+
+      walk([&](const spatial::Box<3>& node) { return node.distance_squared(origin) <= reach_squared; }, [&](const int32_t handle, const Object& target) {
+        if (target.box.distance_squared(origin) <= reach_squared) {
+          out.push_back(handle);
+        }
+      });
+
+      return spatial::to_array(out);
+    }
+
+    // Nearest object hit by the ray and its distance, or nil. Subtrees the ray enters beyond the
+    // closest hit so far are skipped.
+    std::tuple<std::optional<int32_t>, std::optional<double>> raycast(const Vector3& origin, const Vector3& direction, const sol::optional<double> max_distance) const {
+      const auto ray = spatial::Ray<3>::from(origin, direction, max_distance, "Bvh");
+
+      std::optional<int32_t> best_handle;
+      float best = ray.max_distance;
+
+      walk([&](const spatial::Box<3>& node) {
+        return node.ray_entry(ray.origin, ray.inverse_direction, best).has_value();
+      }, [&](const int32_t handle, const Object& target) {
+        const auto hit = target.box.ray_entry(ray.origin, ray.inverse_direction, best);
+        if (hit && (!best_handle || *hit < best)) {
+          best = *hit;
+          best_handle = handle;
+        }
+      });
+
+      if (!best_handle) {
+        return { std::nullopt, std::nullopt };
+      }
+
+      return { best_handle, static_cast<double>(best) };
+    }
+
+    std::string to_string() const {
+      return "Bvh(" + std::to_string(handles_.size()) + ")";
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<Bvh> user_type = lua_state.new_usertype<Bvh>(name(),
+        sol::constructors<Bvh(), Bvh(double)>(),
+        "size", &Bvh::size,
+        "empty", &Bvh::empty,
+        "margin", &Bvh::margin,
+        "height", &Bvh::height,
+        "contains", &Bvh::contains,
+        "clear", &Bvh::clear,
+        "insert", &Bvh::insert,
+        "move", &Bvh::move,
+        "remove", &Bvh::remove,
+        "query_box", &Bvh::query_box,
+        "query_radius", &Bvh::query_radius,
+        "raycast", &Bvh::raycast
+      );
+
+      user_type[sol::meta_function::length] = [](const Bvh& bvh) {
+        return bvh.size();
+      };
+
+      user_type[sol::meta_function::to_string] = [](const Bvh& bvh) {
+        return bvh.to_string();
+      };
+    }
+  };
+
+}
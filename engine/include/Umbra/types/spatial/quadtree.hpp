@@ -0,0 +1,349 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/data/vector2.hpp"
+#include "Umbra/types/spatial/spatial.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  // Region quadtree over 2D boxes within fixed world bounds. Each object is stored in the deepest node
+  // that fully contains it, so objects of very different sizes mix well; boxes outside the world
+  // bounds are kept at the root and still found by every query. A leaf splits once it holds more than
+  // SPLIT_THRESHOLD objects, down to the maximum depth. Nodes are kept once created; clear resets the
+  // tree.
+  //
+  // Handles are positive integers that go stale on remove, and queries return them in an Int32Array.
+  struct UMBRA_API Quadtree final : IType {
+  private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t SPLIT_THRESHOLD = 8;
+    static constexpr int DEFAULT_MAX_DEPTH = 8;
+
+    struct Node {
+      spatial::Box<2> box;
+      uint32_t first_child = NONE;
+      int depth = 0;
+      std::vector<int32_t> objects;
+    };
+
+    struct Object {
+      spatial::Box<2> box;
+      uint32_t node = 0;
+      uint32_t position = 0;
+    };
+
+    int max_depth_ = DEFAULT_MAX_DEPTH;
+
+    spatial::HandlePool handles_;
+    std::vector<Object> objects_;
+    std::vector<Node> nodes_;
+
+    Object& object(const int32_t handle) noexcept {
+      return objects_[spatial::HandlePool::index(handle)];
+    }
+
+    const Object& object(const int32_t handle) const noexcept {
+      return objects_[spatial::HandlePool::index(handle)];
+    }
+
+    // Child of `node` that fully contains `box`, or NONE when it straddles the center
+    uint32_t child_for(const uint32_t node, const spatial::Box<2>& box) const noexcept {
+      const spatial::Point<2> center = nodes_[node].box.center();
+      uint32_t quadrant = 0;
+
+      for (size_t d = 0; d < 2; ++d) {
+        if (box.min[d] >= center[d]) {
+          quadrant |= 1u << d;
+        } else if (box.max[d] > center[d]) {
+          return NONE;
+        }
+      }
+
+      return nodes_[node].first_child + quadrant;
+    }
+
+    void attach(const int32_t handle, const uint32_t node) {
+      Object& target = object(handle);
+      target.node = node;
+      target.position = static_cast<uint32_t>(nodes_[node].objects.size());
+      nodes_[node].objects.push_back(handle);
+    }
+
+    void detach(const int32_t handle) {
+      const Object& target = object(handle);
+      std::vector<int32_t>& members = nodes_[target.node].objects;
+
+      const int32_t last = members.back();
+      members[target.position] = last;
+      object(last).position = target.position;
+      members.pop_back();
+    }
+
+    void split(const uint32_t node) {
+      const auto first = static_cast<uint32_t>(nodes_.size());
+      const spatial::Box<2> box = nodes_[node].box;
+      const spatial::Point<2> center = box.center();
+      const int depth = nodes_[node].depth + 1;
+
+      for (uint32_t quadrant = 0; quadrant < 4; ++quadrant) {
+        Node child;
+        child.depth = depth;
+
+        for (size_t d = 0; d < 2; ++d) {
+          const bool upper = (quadrant >> d) & 1u;
+          child.box.min[d] = upper ? center[d] : box.min[d];
+          child.box.max[d] = upper ? box.max[d] : center[d];
+        }
+
+        nodes_.push_back(std::move(child));
+      }
+
+      nodes_[node].first_child = first;
+
+      // Push down everything that now fits a child. child_for only looks at the center, so a root member
+      // outside the world bounds has to be checked against the child's box or it lands in a quadrant
+      // that queries never enter for it.
+      std::vector<int32_t> members = std::move(nodes_[node].objects);
+      nodes_[node].objects.clear();
+
+      for (const int32_t handle : members) {
+        const spatial::Box<2>& member = object(handle).box;
+        const uint32_t child = child_for(node, member);
+        attach(handle, child != NONE && nodes_[child].box.contains(member) ? child : node);
+      }
+    }
+
+    void place(const int32_t handle) {
+      const spatial::Box<2>& box = object(handle).box;
+      uint32_t node = 0;
+
+      if (nodes_[0].box.contains(box)) {
+        while (true) {
+          if (nodes_[node].first_child == NONE) {
+            if (nodes_[node].objects.size() < SPLIT_THRESHOLD || nodes_[node].depth >= max_depth_) {
+              break;
+            }
+
+            split(node);
+          }
+
+          const uint32_t child = child_for(node, box);
+          if (child == NONE) {
+            break;
+          }
+
+          node = child;
+        }
+      }
+
+      attach(handle, node);
+    }
+
+    // Whether `box` still belongs in `node` without any restructuring
+    bool fits(const uint32_t node, const spatial::Box<2>& box) const noexcept {
+      if (!nodes_[node].box.contains(box)) {
+        return node == 0;
+      }
+
+      return nodes_[node].first_child == NONE || child_for(node, box) == NONE;
+    }
+
+    // Depth-first walk. `enter` decides whether to descend into a child node; the root is always
+    // visited since it also holds the objects outside the world bounds.
+    void walk(const auto& enter, const auto& visitor) const {
+      std::vector<uint32_t> stack = { 0 };
+
+      while (!stack.empty()) {
+        const Node& node = nodes_[stack.back()];
+        stack.pop_back();
+
+        for (const int32_t handle : node.objects) {
+          visitor(handle, object(handle));
+        }
+
+        if (node.first_child == NONE) {
+          continue;
+        }
+
+        for (uint32_t child = node.first_child; child < node.first_child + 4; ++child) {
+          if (enter(nodes_[child])) {
+            stack.push_back(child);
+          }
+        }
+      }
+    }
+
+    void reset(const spatial::Box<2>& bounds) {
+      handles_.clear();
+      objects_.clear();
+      nodes_.clear();
+      nodes_.emplace_back().box = bounds;
+    }
+
+  public:
+    const char* name() override { return "Quadtree"; }
+
+    Quadtree(const Vector2& min, const Vector2& max) : Quadtree(min, max, DEFAULT_MAX_DEPTH) {}
+
+    Quadtree(const Vector2& min, const Vector2& max, const int max_depth) {
+      if (max_depth < 0) {
+        umbra_fail("Quadtree: max depth cannot be negative");
+      }
+
+      max_depth_ = max_depth;
+      reset(spatial::Box<2>::from(min, max));
+    }
+
+    int size() const noexcept { return static_cast<int>(handles_.size()); }
+    bool empty() const noexcept { return handles_.size() == 0; }
+    int max_depth() const noexcept { return max_depth_; }
+
+    bool contains(const int32_t handle) const noexcept { return handles_.live(handle); }
+
+    void clear() {
+      const spatial::Box<2> bounds = nodes_[0].box;
+      reset(bounds);
+    }
+
+    // Returns the handle of the new object
+    int32_t insert(const Vector2& min, const Vector2& max) {
+      const int32_t handle = handles_.acquire(name());
+
+      if (spatial::HandlePool::index(handle) == objects_.size()) {
+        objects_.emplace_back();
+      }
+
+      object(handle).box = spatial::Box<2>::from(min, max);
+      place(handle);
+
+      return handle;
+    }
+
+    // Updates in place while the box stays within its node, otherwise reinserts. Returns whether the
+    // handle was live.
+    bool move(const int32_t handle, const Vector2& min, const Vector2& max) {
+      if (!handles_.live(handle)) {
+        return false;
+      }
+
+      const spatial::Box<2> box = spatial::Box<2>::from(min, max);
+      if (fits(object(handle).node, box)) {
+        object(handle).box = box;
+        return true;
+      }
+
+      detach(handle);
+      object(handle).box = box;
+      place(handle);
+
+      return true;
+    }
+
+    bool remove(const int32_t handle) {
+      if (!handles_.live(handle)) {
+        return false;
+      }
+
+      detach(handle);
+      handles_.release(handle);
+      return true;
+    }
+
+    // Handles of every object overlapping the box
+    Int32Array query_box(const Vector2& min, const Vector2& max) const {
+      const spatial::Box<2> box = spatial::Box<2>::from(min, max);
+      std::vector<int32_t> out;
+
+      walk([&](const Node& node) { return node.box.overlaps(box); }, [&](const int32_t handle, const Object& target) {
+        if (target.box.overlaps(box)) {
+          out.push_back(handle);
+        }
+      });
+
+      return spatial::to_array(out);
+    }
+
+    // Handles of every object within `radius` of `center`
+    Int32Array query_radius(const Vector2& center, const double radius) const {
+      const spatial::Point<2> origin = spatial::point(center);
+      const auto reach = static_cast<float>(std::abs(radius));
+      const float reach_squared = reach * reach;
+      std::vector<int32_t> out;
+
+      walk([&](const Node& node) { return node.box.distance_squared(origin) <= reach_squared; }, [&](const int32_t handle, const Object& target) {
+        if (target.box.distance_squared(origin) <= reach_squared) {
+          out.push_back(handle);
+        }
+      });
+
+      return spatial::to_array(out);
+    }
+
+    // Nearest object hit by the ray and its distance, or nil. Nodes the ray enters beyond the closest
+    // hit so far are skipped.
+    std::tuple<std::optional<int32_t>, std::optional<double>> raycast(const Vector2& origin, const Vector2& direction, const sol::optional<double> max_distance) const {
+      const auto ray = spatial::Ray<2>::from(origin, direction, max_distance, "Quadtree");
+
+      std::optional<int32_t> best_handle;
+      float best = ray.max_distance;
+
+      walk([&](const Node& node) {
+        const auto entry = node.box.ray_entry(ray.origin, ray.inverse_direction, best);
+        return entry.has_value();
+      }, [&](const int32_t handle, const Object& target) {
+        const auto hit = target.box.ray_entry(ray.origin, ray.inverse_direction, best);
+        if (hit && (!best_handle || *hit < best)) {
+          best = *hit;
+          best_handle = handle;
+        }
+      });
+
+      if (!best_handle) {
+        return { std::nullopt, std::nullopt };
+      }
+
+      return { best_handle, static_cast<double>(best) };
+    }
+
+    std::string to_string() const {
+      return "Quadtree(" + std::to_string(handles_.size()) + ")";
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<Quadtree> user_type = lua_state.new_usertype<Quadtree>(name(),
+        sol::constructors<Quadtree(const Vector2&, const Vector2&), Quadtree(const Vector2&, const Vector2&, int)>(),
+        "size", &Quadtree::size,
+        "empty", &Quadtree::empty,
+        "max_depth", &Quadtree::max_depth,
+        "contains", &Quadtree::contains,
+        "clear", &Quadtree::clear,
+        "insert", &Quadtree::insert,
+        "move", &Quadtree::move,
+        "remove", &Quadtree::remove,
+        "query_box", &Quadtree::query_box,
+        "query_radius", &Quadtree::query_radius,
+        "raycast", &Quadtree::raycast
+      );
+
+      user_type[sol::meta_function::length] = [](const Quadtree& quadtree) {
+        return quadtree.size();
+      };
+
+      user_type[sol::meta_function::to_string] = [](const Quadtree& quadtree) {
+        return quadtree.to_string();
+      };
+    }
+  };
+
+}
@@ -0,0 +1,288 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/ordered/typed_array.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra::spatial {
+
+  // Shared pieces of the spatial index types: float boxes and points built from Vector2/Vector3, ray
+  // and sphere tests, and the handle pool.
+
+  template<size_t N>
+  using Point = std::array<float, N>;
+
+  template<class Vector>
+  Point<std::size(type_traits<Vector>::components)> point(const Vector& vector) noexcept {
+    Point<std::size(type_traits<Vector>::components)> out;
+    for (size_t d = 0; d < out.size(); ++d) {
+      out[d] = static_cast<float>(vector.*type_traits<Vector>::components[d]);
+    }
+
+    return out;
+  }
+
+  template<size_t N>
+  struct Box {
+    Point<N> min;
+    Point<N> max;
+
+    // Accepts the corners in either order
+    template<class Vector>
+    static Box from(const Vector& a, const Vector& b) noexcept {
+      const Point<N> pa = point(a);
+      const Point<N> pb = point(b);
+
+      Box out;
+      for (size_t d = 0; d < N; ++d) {
+        out.min[d] = std::min(pa[d], pb[d]);
+        out.max[d] = std::max(pa[d], pb[d]);
+      }
+
+      return out;
+    }
+
+    static Box around(const Point<N>& center, const float radius) noexcept {
+      Box out;
+      for (size_t d = 0; d < N; ++d) {
+        out.min[d] = center[d] - radius;
+        out.max[d] = center[d] + radius;
+      }
+
+      return out;
+    }
+
+    bool overlaps(const Box& other) const noexcept {
+      for (size_t d = 0; d < N; ++d) {
+        if (min[d] > other.max[d] || other.min[d] > max[d]) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    bool contains(const Box& other) const noexcept {
+      for (size_t d = 0; d < N; ++d) {
+        if (other.min[d] < min[d] || other.max[d] > max[d]) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    Box merged(const Box& other) const noexcept {
+      Box out;
+      for (size_t d = 0; d < N; ++d) {
+        out.min[d] = std::min(min[d], other.min[d]);
+        out.max[d] = std::max(max[d], other.max[d]);
+      }
+
+      return out;
+    }
+
+    Box expanded(const float margin) const noexcept {
+      Box out;
+      for (size_t d = 0; d < N; ++d) {
+        out.min[d] = min[d] - margin;
+        out.max[d] = max[d] + margin;
+      }
+
+      return out;
+    }
+
+    Point<N> center() const noexcept {
+      Point<N> out;
+      for (size_t d = 0; d < N; ++d) {
+        out[d] = (min[d] + max[d]) * 0.5f;
+      }
+
+      return out;
+    }
+
+    float half_extent() const noexcept {
+      float out = 0.0f;
+      for (size_t d = 0; d < N; ++d) {
+        out = std::max(out, (max[d] - min[d]) * 0.5f);
+      }
+
+      return out;
+    }
+
+    // Perimeter in 2D, surface area in 3D; the cost measure for tree insertion
+    float cost() const noexcept {
+      if constexpr (N == 2) {
+        return 2.0f * ((max[0] - min[0]) + (max[1] - min[1]));
+      } else {
+        const float x = max[0] - min[0];
+        const float y = max[1] - min[1];
+        const float z = max[2] - min[2];
+        return 2.0f * (x * y + y * z + z * x);
+      }
+    }
+
+    float distance_squared(const Point<N>& target) const noexcept {
+      float out = 0.0f;
+      for (size_t d = 0; d < N; ++d) {
+        const float excess = std::max({ min[d] - target[d], 0.0f, target[d] - max[d] });
+        out += excess * excess;
+      }
+
+      return out;
+    }
+
+    // Slab test. Returns the distances along the ray at which it enters and leaves the box, clipped to
+    // [0, max_distance], or nothing when it misses.
+    std::optional<std::pair<float, float>> ray_span(const Point<N>& origin, const Point<N>& inverse_direction, const float max_distance) const noexcept {
+      float near = 0.0f;
+      float far = max_distance;
+
+      for (size_t d = 0; d < N; ++d) {
+        const float t1 = (min[d] - origin[d]) * inverse_direction[d];
+        const float t2 = (max[d] - origin[d]) * inverse_direction[d];
+
+        near = std::max(near, std::min(t1, t2));
+        far = std::min(far, std::max(t1, t2));
+      }
+
+      if (near > far) {
+        return std::nullopt;
+      }
+
+      return std::pair{ near, far };
+    }
+
+    // Entry distance only, 0 when the ray starts inside
+    std::optional<float> ray_entry(const Point<N>& origin, const Point<N>& inverse_direction, const float max_distance) const noexcept {
+      const auto span = ray_span(origin, inverse_direction, max_distance);
+      if (!span) {
+        return std::nullopt;
+      }
+
+      return span->first;
+    }
+  };
+
+  // A normalised ray with its reciprocal direction precomputed for the slab tests
+  template<size_t N>
+  struct Ray {
+    Point<N> origin;
+    Point<N> direction;
+    Point<N> inverse_direction;
+    float max_distance;
+
+    template<class Vector>
+    static Ray from(const Vector& origin, const Vector& direction, const sol::optional<double>& max_distance, const char* owner) {
+      Ray out;
+      out.origin = point(origin);
+      out.direction = point(direction);
+      out.max_distance = max_distance ? static_cast<float>(*max_distance) : std::numeric_limits<float>::infinity();
+
+      float length = 0.0f;
+      for (size_t d = 0; d < N; ++d) {
+        length += out.direction[d] * out.direction[d];
+      }
+
+      length = std::sqrt(length);
+      if (length == 0.0f || length != length) {
+        umbra_fail(std::string(owner) + ": ray direction cannot be zero");
+      }
+
+      for (size_t d = 0; d < N; ++d) {
+        out.direction[d] /= length;
+        out.inverse_direction[d] = 1.0f / out.direction[d];
+      }
+
+      return out;
+    }
+  };
+
+  // Hands out positive handles that pack a slot index into the low 20 bits and the slot's generation
+  // into the 11 bits above. Removing an object bumps its slot's generation before the slot is reused,
+  // so a handle kept past its remove is rejected instead of addressing the object that took its slot.
+  // The generation wraps after 2048 reuses of one slot.
+  class HandlePool {
+  public:
+    static constexpr int SLOT_BITS = 20;
+    static constexpr int32_t SLOT_MASK = (int32_t{ 1 } << SLOT_BITS) - 1;
+    static constexpr uint16_t GENERATION_MASK = 0x7FF;
+
+    int32_t acquire(const char* owner) {
+      uint32_t slot;
+      if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+      } else {
+        // Slot field 0 is never a handle, so the field holds slot + 1
+        if (slots_.size() >= static_cast<size_t>(SLOT_MASK)) {
+          umbra_fail(std::string(owner) + ": cannot hold more than " + std::to_string(SLOT_MASK) + " objects");
+        }
+
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+      }
+
+      slots_[slot].live = true;
+      return (static_cast<int32_t>(slots_[slot].generation) << SLOT_BITS) | static_cast<int32_t>(slot + 1);
+    }
+
+    void release(const int32_t handle) {
+      Slot& slot = slots_[index(handle)];
+      slot.live = false;
+      slot.generation = (slot.generation + 1) & GENERATION_MASK;
+      free_.push_back(static_cast<uint32_t>(index(handle)));
+    }
+
+    bool live(const int32_t handle) const noexcept {
+      if (handle < 1 || (handle & SLOT_MASK) == 0 || index(handle) >= slots_.size()) {
+        return false;
+      }
+
+      const Slot& slot = slots_[index(handle)];
+      return slot.live && slot.generation == (handle >> SLOT_BITS);
+    }
+
+    size_t size() const noexcept {
+      return slots_.size() - free_.size();
+    }
+
+    // Slot index for a live handle
+    static size_t index(const int32_t handle) noexcept {
+      return static_cast<size_t>((handle & SLOT_MASK) - 1);
+    }
+
+    // Generations restart too, so handles from before the clear may be accepted again
+    void clear() noexcept {
+      slots_.clear();
+      free_.clear();
+    }
+
+  private:
+    struct Slot {
+      uint16_t generation = 0;
+      bool live = false;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_;
+  };
+
+  inline Int32Array to_array(const std::vector<int32_t>& handles) {
+    Int32Array out(static_cast<int>(handles.size()));
+    std::copy(handles.begin(), handles.end(), out.data());
+    return out;
+  }
+
+}
@@ -0,0 +1,346 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/data/vector2.hpp"
+#include "Umbra/types/spatial/spatial.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  // Loose uniform grid over 2D boxes, suited to crowds and projectiles of roughly similar size. Each
+  // object lives in the one cell that holds its center, so insert and move are O(1). Queries widen
+  // their search by the largest half-extent seen so far, which keeps them exact; an object far larger
+  // than the rest widens every query and belongs in a Quadtree instead.
+  //
+  // Cells are hashed, so the grid is unbounded. Handles are positive integers
+  // that go stale on remove, and queries return them in an Int32Array.
+  struct UMBRA_API UniformGrid final : IType {
+  private:
+    struct Object {
+      spatial::Box<2> box;
+      uint64_t cell = 0;
+      uint32_t position = 0;
+      mutable uint32_t stamp = 0;
+    };
+
+    float cell_size_ = 1.0f;
+    float max_extent_ = 0.0f;
+    std::optional<spatial::Box<2>> bounds_;
+    mutable uint32_t stamp_ = 0;
+
+    spatial::HandlePool handles_;
+    std::vector<Object> objects_;
+    std::unordered_map<uint64_t, std::vector<int32_t>> cells_;
+
+    int32_t coordinate(const float value) const noexcept {
+      const float cell = std::floor(value / cell_size_);
+      return static_cast<int32_t>(std::clamp(cell, -2147483520.0f, 2147483520.0f));
+    }
+
+    static uint64_t key(const int32_t x, const int32_t y) noexcept {
+      return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+
+    uint64_t cell_of(const spatial::Box<2>& box) const noexcept {
+      const spatial::Point<2> center = box.center();
+      return key(coordinate(center[0]), coordinate(center[1]));
+    }
+
+    void attach(const int32_t handle, const uint64_t cell) {
+      std::vector<int32_t>& members = cells_[cell];
+      Object& object = objects_[spatial::HandlePool::index(handle)];
+
+      object.cell = cell;
+      object.position = static_cast<uint32_t>(members.size());
+      members.push_back(handle);
+    }
+
+    void detach(const int32_t handle) {
+      const Object& object = objects_[spatial::HandlePool::index(handle)];
+      const auto found = cells_.find(object.cell);
+      std::vector<int32_t>& members = found->second;
+
+      const int32_t last = members.back();
+      members[object.position] = last;
+      objects_[spatial::HandlePool::index(last)].position = object.position;
+      members.pop_back();
+
+      if (members.empty()) {
+        cells_.erase(found);
+      }
+    }
+
+    void grow(const spatial::Box<2>& box) noexcept {
+      max_extent_ = std::max(max_extent_, box.half_extent());
+      bounds_ = bounds_ ? bounds_->merged(box) : box;
+    }
+
+    void visit_cell(const uint64_t cell, const auto& visitor) const {
+      const auto found = cells_.find(cell);
+      if (found == cells_.end()) {
+        return;
+      }
+
+      for (const int32_t handle : found->second) {
+        visitor(handle, objects_[spatial::HandlePool::index(handle)]);
+      }
+    }
+
+    // Calls `visitor` for every object whose center cell could hold an object overlapping `box`
+    void visit_candidates(const spatial::Box<2>& box, const auto& visitor) const {
+      const spatial::Box<2> reach = box.expanded(max_extent_);
+      const int32_t x0 = coordinate(reach.min[0]);
+      const int32_t y0 = coordinate(reach.min[1]);
+      const int32_t x1 = coordinate(reach.max[0]);
+      const int32_t y1 = coordinate(reach.max[1]);
+
+      const double span = (static_cast<double>(x1) - x0 + 1.0) * (static_cast<double>(y1) - y0 + 1.0);
+
+      // A query covering more cells than are occupied walks the occupied cells instead
+      if (span > static_cast<double>(cells_.size())) {
+        for (const auto& [cell, members] : cells_) {
+          const auto x = static_cast<int32_t>(static_cast<uint32_t>(cell >> 32));
+          const auto y = static_cast<int32_t>(static_cast<uint32_t>(cell));
+
+          if (x < x0 || x > x1 || y < y0 || y > y1) {
+            continue;
+          }
+
+          for (const int32_t handle : members) {
+            visitor(handle, objects_[spatial::HandlePool::index(handle)]);
+          }
+        }
+
+        return;
+      }
+
+      for (int32_t x = x0; x <= x1; ++x) {
+        for (int32_t y = y0; y <= y1; ++y) {
+          visit_cell(key(x, y), visitor);
+        }
+      }
+    }
+
+    bool live(const int32_t handle) const noexcept {
+      return handles_.live(handle);
+    }
+
+  public:
+    const char* name() override { return "UniformGrid"; }
+
+    explicit UniformGrid(const double cell_size) {
+      if (!(cell_size > 0.0) || !std::isfinite(cell_size)) {
+        umbra_fail("UniformGrid: cell size must be a positive number");
+      }
+
+      cell_size_ = static_cast<float>(cell_size);
+    }
+
+    int size() const noexcept { return static_cast<int>(handles_.size()); }
+    bool empty() const noexcept { return handles_.size() == 0; }
+    double cell_size() const noexcept { return cell_size_; }
+
+    bool contains(const int32_t handle) const noexcept { return live(handle); }
+
+    void clear() {
+      handles_.clear();
+      objects_.clear();
+      cells_.clear();
+      max_extent_ = 0.0f;
+      bounds_.reset();
+    }
+
+    // Returns the handle of the new object
+    int32_t insert(const Vector2& min, const Vector2& max) {
+      const spatial::Box<2> box = spatial::Box<2>::from(min, max);
+      const int32_t handle = handles_.acquire(name());
+
+      if (spatial::HandlePool::index(handle) == objects_.size()) {
+        objects_.emplace_back();
+      }
+
+      objects_[spatial::HandlePool::index(handle)].box = box;
+      attach(handle, cell_of(box));
+      grow(box);
+
+      return handle;
+    }
+
+    // Returns whether the handle was live
+    bool move(const int32_t handle, const Vector2& min, const Vector2& max) {
+      if (!live(handle)) {
+        return false;
+      }
+
+      const spatial::Box<2> box = spatial::Box<2>::from(min, max);
+      const uint64_t cell = cell_of(box);
+
+      if (cell != objects_[spatial::HandlePool::index(handle)].cell) {
+        detach(handle);
+        attach(handle, cell);
+      }
+
+      objects_[spatial::HandlePool::index(handle)].box = box;
+      grow(box);
+
+      return true;
+    }
+
+    bool remove(const int32_t handle) {
+      if (!live(handle)) {
+        return false;
+      }
+
+      detach(handle);
+      handles_.release(handle);
+      return true;
+    }
+
+    // Handles of every object overlapping the box
+    Int32Array query_box(const Vector2& min, const Vector2& max) const {
+      const spatial::Box<2> box = spatial::Box<2>::from(min, max);
+      std::vector<int32_t> out;
+
+      visit_candidates(box, [&](const int32_t handle, const Object& object) {
+        if (object.box.overlaps(box)) {
+          out.push_back(handle);
+        }
+      });
+
+      return spatial::to_array(out);
+    }
+
+    // Handles of every object within `radius` of `center`
+    Int32Array query_radius(const Vector2& center, const double radius) const {
+      const spatial::Point<2> origin = spatial::point(center);
+      const auto reach = static_cast<float>(std::abs(radius));
+      const float reach_squared = reach * reach;
+      std::vector<int32_t> out;
+
+      visit_candidates(spatial::Box<2>::around(origin, reach), [&](const int32_t handle, const Object& object) {
+        if (object.box.distance_squared(origin) <= reach_squared) {
+          out.push_back(handle);
+        }
+      });
+
+      return spatial::to_array(out);
+    }
+
+    // Nearest object hit by the ray and its distance, or nil. Walks the cells along the ray and stops
+    // at the first cell that ends beyond the closest hit so far.
+    std::tuple<std::optional<int32_t>, std::optional<double>> raycast(const Vector2& origin, const Vector2& direction, const sol::optional<double> max_distance) const {
+      const auto ray = spatial::Ray<2>::from(origin, direction, max_distance, "UniformGrid");
+
+      if (!bounds_) {
+        return { std::nullopt, std::nullopt };
+      }
+
+      const auto span = bounds_->ray_span(ray.origin, ray.inverse_direction, ray.max_distance);
+      if (!span) {
+        return { std::nullopt, std::nullopt };
+      }
+
+      const auto [start, end] = *span;
+      const auto ring = static_cast<int32_t>(std::ceil(max_extent_ / cell_size_));
+      const uint32_t stamp = ++stamp_;
+
+      std::optional<int32_t> best_handle;
+      float best = std::numeric_limits<float>::infinity();
+
+      auto test = [&](const int32_t handle, const Object& object) {
+        if (object.stamp == stamp) {
+          return;
+        }
+
+        object.stamp = stamp;
+        const auto hit = object.box.ray_entry(ray.origin, ray.inverse_direction, ray.max_distance);
+        if (hit && *hit < best) {
+          best = *hit;
+          best_handle = handle;
+        }
+      };
+
+      int32_t cell[2];
+      int32_t last[2];
+      int32_t step[2];
+      float next[2];
+      float delta[2];
+
+      for (size_t d = 0; d < 2; ++d) {
+        cell[d] = coordinate(ray.origin[d] + ray.direction[d] * start);
+        last[d] = coordinate(ray.origin[d] + ray.direction[d] * end);
+        step[d] = ray.direction[d] > 0.0f ? 1 : -1;
+        delta[d] = std::abs(cell_size_ * ray.inverse_direction[d]);
+
+        const float boundary = static_cast<float>(cell[d] + (step[d] > 0 ? 1 : 0)) * cell_size_;
+        next[d] = ray.direction[d] != 0.0f ? (boundary - ray.origin[d]) * ray.inverse_direction[d] : std::numeric_limits<float>::infinity();
+      }
+
+      // Bounds the walk even if float error makes it overshoot the last cell
+      int64_t remaining = std::abs(static_cast<int64_t>(last[0]) - cell[0]) + std::abs(static_cast<int64_t>(last[1]) - cell[1]) + 1;
+
+      while (remaining-- > 0) {
+        for (int32_t x = cell[0] - ring; x <= cell[0] + ring; ++x) {
+          for (int32_t y = cell[1] - ring; y <= cell[1] + ring; ++y) {
+            visit_cell(key(x, y), test);
+          }
+        }
+
+        // Any object containing a ray point inside this cell has been tested by now
+        const size_t axis = next[0] < next[1] ? 0 : 1;
+        if (best <= next[axis] || next[axis] > end) {
+          break;
+        }
+
+        cell[axis] += step[axis];
+        next[axis] += delta[axis];
+      }
+
+      if (!best_handle) {
+        return { std::nullopt, std::nullopt };
+      }
+
+      return { best_handle, static_cast<double>(best) };
+    }
+
+    std::string to_string() const {
+      return "UniformGrid(" + std::to_string(handles_.size()) + ")";
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<UniformGrid> user_type = lua_state.new_usertype<UniformGrid>(name(),
+        sol::constructors<UniformGrid(double)>(),
+        "size", &UniformGrid::size,
+        "empty", &UniformGrid::empty,
+        "cell_size", &UniformGrid::cell_size,
+        "contains", &UniformGrid::contains,
+        "clear", &UniformGrid::clear,
+        "insert", &UniformGrid::insert,
+        "move", &UniformGrid::move,
+        "remove", &UniformGrid::remove,
+        "query_box", &UniformGrid::query_box,
+        "query_radius", &UniformGrid::query_radius,
+        "raycast", &UniformGrid::raycast
+      );
+
+      user_type[sol::meta_function::length] = [](const UniformGrid& uniform_grid) {
+        return uniform_grid.size();
+      };
+
+      user_type[sol::meta_function::to_string] = [](const UniformGrid& uniform_grid) {
+        return uniform_grid.to_string();
+      };
+    }
+  };
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/lua_cell.hpp"
+#include "Umbra/types/unordered/hash_table.hpp"
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  // Key-value map over HashTable. Keys follow Lua table semantics: integers, numbers, booleans and
+  // strings compare by value, while tables, userdata and functions compare by identity. Integer and
+  // string lookups go straight from the Lua stack to the table without creating a registry reference.
+  // Values are LuaCells, so numbers and booleans are stored inline.
+  struct UMBRA_API HashMap final : IType {
+  private:
+    struct Slot {
+      HashKey key;
+      LuaCell value;
+    };
+
+    HashTable<Slot> table_;
+
+    static HashKeyView key_view(const sol::stack_object& key) {
+      return HashKeyView::from_stack(key.lua_state(), key.stack_index(), "HashMap");
+    }
+
+  public:
+    const char* name() override { return "HashMap"; }
+
+    HashMap() noexcept = default;
+
+    int size() const noexcept { return static_cast<int>(table_.size()); }
+    int capacity() const noexcept { return static_cast<int>(table_.capacity()); }
+    bool empty() const noexcept { return table_.size() == 0; }
+
+    void clear() noexcept { table_.clear(); }
+    void reserve(const int count) { table_.reserve(static_cast<size_t>(std::abs(count))); }
+
+    LuaCellView get(const sol::stack_object key) const {
+      const HashKeyView view = key_view(key);
+      const size_t index = table_.find(view, view.hash());
+
+      if (index == HashTable<Slot>::NPOS) {
+        return {};
+      }
+
+      return { &table_.slot(index).value };
+    }
+
+    // Setting a key to nil removes it, as with Lua tables
+    void set(const sol::stack_object key, const sol::stack_object value) {
+      if (value.get_type() == sol::type::lua_nil || value.get_type() == sol::type::none) {
+        erase(key);
+        return;
+      }
+
+      const HashKeyView view = key_view(key);
+      const auto [index, inserted] = table_.insert(view, view.hash(), key.lua_state(), key.stack_index());
+      table_.slot(index).value = LuaCell::from_stack(value);
+    }
+
+    bool has(const sol::stack_object key) const {
+      const HashKeyView view = key_view(key);
+      return table_.find(view, view.hash()) != HashTable<Slot>::NPOS;
+    }
+
+    // Returns whether the key was present
+    bool erase(const sol::stack_object key) {
+      const HashKeyView view = key_view(key);
+      const size_t index = table_.find(view, view.hash());
+
+      if (index == HashTable<Slot>::NPOS) {
+        return false;
+      }
+
+      table_.erase_at(index);
+      return true;
+    }
+
+    static HashMap from_table(const sol::table& table) {
+      HashMap out;
+
+      lua_State* L = table.lua_state();
+      table.push(L);
+      const int table_index = lua_gettop(L);
+
+      lua_pushnil(L);
+      while (lua_next(L, table_index)) {
+        const HashKeyView view = HashKeyView::from_stack(L, -2, "HashMap");
+        const auto [index, inserted] = out.table_.insert(view, view.hash(), L, -2);
+        out.table_.slot(index).value = LuaCell::from_stack(L, -1);
+        lua_pop(L, 1);
+      }
+
+      lua_pop(L, 1);
+      return out;
+    }
+
+    sol::table to_table(const sol::this_state this_state) const {
+      lua_State* L = this_state;
+      lua_createtable(L, 0, static_cast<int>(table_.size()));
+
+      for (size_t i = table_.next(0); i != HashTable<Slot>::NPOS; i = table_.next(i + 1)) {
+        table_.slot(i).key.push(L);
+        table_.slot(i).value.push(L);
+        lua_rawset(L, -3);
+      }
+
+      return sol::stack::pop<sol::table>(L);
+    }
+
+    sol::table keys(const sol::this_state this_state) const {
+      lua_State* L = this_state;
+      lua_createtable(L, static_cast<int>(table_.size()), 0);
+
+      lua_Integer position = 1;
+      for (size_t i = table_.next(0); i != HashTable<Slot>::NPOS; i = table_.next(i + 1)) {
+        table_.slot(i).key.push(L);
+        lua_rawseti(L, -2, position++);
+      }
+
+      return sol::stack::pop<sol::table>(L);
+    }
+
+    sol::table values(const sol::this_state this_state) const {
+      lua_State* L = this_state;
+      lua_createtable(L, static_cast<int>(table_.size()), 0);
+
+      lua_Integer position = 1;
+      for (size_t i = table_.next(0); i != HashTable<Slot>::NPOS; i = table_.next(i + 1)) {
+        table_.slot(i).value.push(L);
+        lua_rawseti(L, -2, position++);
+      }
+
+      return sol::stack::pop<sol::table>(L);
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<HashMap> user_type = lua_state.new_usertype<HashMap>(name(),
+        sol::constructors<HashMap()>(),
+        "size", &HashMap::size,
+        "capacity", &HashMap::capacity,
+        "empty", &HashMap::empty,
+        "clear", &HashMap::clear,
+        "reserve", &HashMap::reserve,
+        "get", &HashMap::get,
+        "set", &HashMap::set,
+        "has", &HashMap::has,
+        "erase", &HashMap::erase,
+        "from_table", &HashMap::from_table,
+        "to_table", &HashMap::to_table,
+        "keys", &HashMap::keys,
+        "values", &HashMap::values
+      );
+
+      user_type[sol::meta_function::length] = [](const HashMap& hash_map) {
+        return hash_map.size();
+      };
+
+      user_type[sol::meta_function::to_string] = [](const HashMap& hash_map) {
+        return "HashMap(" + std::to_string(hash_map.size()) + ")";
+      };
+
+      // Iterates by slot position, so erasing during iteration is safe; inserting may rehash and skip or
+      // repeat entries, as with Lua's own next(). The map itself is the loop's invariant state, which
+      // keeps it alive for as long as the loop runs.
+      user_type[sol::meta_function::pairs] = [](const sol::stack_object self, const sol::this_state this_state) {
+        auto position = std::make_shared<size_t>(0);
+
+        auto iter = [position](const HashMap& hash_map, sol::object, const sol::this_state iter_state) -> std::tuple<sol::object, LuaCellView> {
+          const HashTable<Slot>& table = hash_map.table_;
+          const size_t index = table.next(*position);
+
+          if (index == HashTable<Slot>::NPOS) {
+            return { make_object(iter_state, sol::lua_nil), LuaCellView{} };
+          }
+
+          *position = index + 1;
+          return { table.slot(index).key.to_object(iter_state), LuaCellView{ &table.slot(index).value } };
+        };
+
+        return std::make_tuple(iter, sol::object(self.lua_state(), self.stack_index()), make_object(this_state, sol::lua_nil));
+      };
+    }
+  };
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/unordered/hash_table.hpp"
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  // Set of keys over HashTable, with the same key semantics as HashMap
+  struct UMBRA_API HashSet final : IType {
+  private:
+    struct Slot {
+      HashKey key;
+    };
+
+    HashTable<Slot> table_;
+
+    static HashKeyView key_view(const sol::stack_object& key) {
+      return HashKeyView::from_stack(key.lua_state(), key.stack_index(), "HashSet");
+    }
+
+  public:
+    const char* name() override { return "HashSet"; }
+
+    HashSet() noexcept = default;
+
+    int size() const noexcept { return static_cast<int>(table_.size()); }
+    int capacity() const noexcept { return static_cast<int>(table_.capacity()); }
+    bool empty() const noexcept { return table_.size() == 0; }
+
+    void clear() noexcept { table_.clear(); }
+    void reserve(const int count) { table_.reserve(static_cast<size_t>(std::abs(count))); }
+
+    // Returns whether the key was newly added
+    bool add(const sol::stack_object key) {
+      const HashKeyView view = key_view(key);
+      return table_.insert(view, view.hash(), key.lua_state(), key.stack_index()).second;
+    }
+
+    bool has(const sol::stack_object key) const {
+      const HashKeyView view = key_view(key);
+      return table_.find(view, view.hash()) != HashTable<Slot>::NPOS;
+    }
+
+    // Returns whether the key was present
+    bool erase(const sol::stack_object key) {
+      const HashKeyView view = key_view(key);
+      const size_t index = table_.find(view, view.hash());
+
+      if (index == HashTable<Slot>::NPOS) {
+        return false;
+      }
+
+      table_.erase_at(index);
+      return true;
+    }
+
+    // Adds every value of an ordered table
+    static HashSet from_table(const sol::table& table) {
+      HashSet out;
+
+      lua_State* L = table.lua_state();
+      table.push(L);
+      const int table_index = lua_gettop(L);
+
+      const auto length = static_cast<lua_Integer>(lua_rawlen(L, table_index));
+      out.table_.reserve(static_cast<size_t>(length));
+
+      for (lua_Integer i = 1; i <= length; ++i) {
+        lua_rawgeti(L, table_index, i);
+        if (!lua_isnil(L, -1)) {
+          const HashKeyView view = HashKeyView::from_stack(L, -1, "HashSet");
+          out.table_.insert(view, view.hash(), L, -1);
+        }
+        lua_pop(L, 1);
+      }
+
+      lua_pop(L, 1);
+      return out;
+    }
+
+    // Ordered table of the keys, in no particular order
+    sol::table to_table(const sol::this_state this_state) const {
+      lua_State* L = this_state;
+      lua_createtable(L, static_cast<int>(table_.size()), 0);
+
+      lua_Integer position = 1;
+      for (size_t i = table_.next(0); i != HashTable<Slot>::NPOS; i = table_.next(i + 1)) {
+        table_.slot(i).key.push(L);
+        lua_rawseti(L, -2, position++);
+      }
+
+      return sol::stack::pop<sol::table>(L);
+    }
+
+    void bind(sol::state& lua_state) {
+      sol::usertype<HashSet> user_type = lua_state.new_usertype<HashSet>(name(),
+        sol::constructors<HashSet()>(),
+        "size", &HashSet::size,
+        "capacity", &HashSet::capacity,
+        "empty", &HashSet::empty,
+        "clear", &HashSet::clear,
+        "reserve", &HashSet::reserve,
+        "add", &HashSet::add,
+        "has", &HashSet::has,
+        "erase", &HashSet::erase,
+        "from_table", &HashSet::from_table,
+        "to_table", &HashSet::to_table
+      );
+
+      user_type[sol::meta_function::length] = [](const HashSet& hash_set) {
+        return hash_set.size();
+      };
+
+      user_type[sol::meta_function::to_string] = [](const HashSet& hash_set) {
+        return "HashSet(" + std::to_string(hash_set.size()) + ")";
+      };
+
+      // Yields (key, true) for every key; same iteration and lifetime rules as HashMap
+      user_type[sol::meta_function::pairs] = [](const sol::stack_object self, const sol::this_state this_state) {
+        auto position = std::make_shared<size_t>(0);
+
+        auto iter = [position](const HashSet& hash_set, sol::object, const sol::this_state iter_state) -> std::tuple<sol::object, sol::object> {
+          const HashTable<Slot>& table = hash_set.table_;
+          const size_t index = table.next(*position);
+
+          if (index == HashTable<Slot>::NPOS) {
+            sol::object nil = make_object(iter_state, sol::lua_nil);
+            return { nil, nil };
+          }
+
+          *position = index + 1;
+          return { table.slot(index).key.to_object(iter_state), make_object(iter_state, true) };
+        };
+
+        return std::make_tuple(iter, sol::object(self.lua_state(), self.stack_index()), make_object(this_state, sol::lua_nil));
+      };
+    }
+  };
+
+}
@@ -0,0 +1,400 @@
+#pragma once
+
+#include "Umbra/types.hpp"
+#include "Umbra/types/lua_cell.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  enum class HashKind : uint8_t { INTEGER, NUMBER, BOOLEAN, STRING, REFERENCE };
+
+  // A key borrowed from the Lua stack. Lookups only ever build one of these, so finding a string key
+  // does not copy it. `bits` holds the integer, the double's bits, the boolean, or for tables, userdata
+  // and functions the object's address, which is their identity in Lua.
+  struct HashKeyView {
+    HashKind kind = HashKind::INTEGER;
+    uint64_t bits = 0;
+    std::string_view string;
+
+    // Lua key semantics: floats with an integral value are the same key as the integer, nil and NaN
+    // cannot be keys
+    static HashKeyView from_stack(lua_State* L, const int index, const char* owner) {
+      HashKeyView view;
+
+      switch (lua_type(L, index)) {
+        case LUA_TNUMBER: {
+          if (lua_isinteger(L, index)) {
+            view.bits = static_cast<uint64_t>(lua_tointeger(L, index));
+            break;
+          }
+
+          const double number = lua_tonumber(L, index);
+          if (number != number) {
+            umbra_fail(std::string(owner) + ": key cannot be NaN");
+          }
+
+          lua_Integer integer;
+          if (lua_numbertointeger(number, &integer) && static_cast<double>(integer) == number) {
+            view.bits = static_cast<uint64_t>(integer);
+          } else {
+            view.kind = HashKind::NUMBER;
+            view.bits = std::bit_cast<uint64_t>(number);
+          }
+          break;
+        }
+        case LUA_TBOOLEAN:
+          view.kind = HashKind::BOOLEAN;
+          view.bits = lua_toboolean(L, index) ? 1 : 0;
+          break;
+        case LUA_TSTRING: {
+          size_t length = 0;
+          const char* data = lua_tolstring(L, index, &length);
+          view.kind = HashKind::STRING;
+          view.string = std::string_view(data, length);
+          break;
+        }
+        case LUA_TNIL:
+        case LUA_TNONE:
+          umbra_fail(std::string(owner) + ": key cannot be nil");
+        default:
+          view.kind = HashKind::REFERENCE;
+          view.bits = reinterpret_cast<uintptr_t>(lua_topointer(L, index));
+          break;
+      }
+
+      return view;
+    }
+
+    uint64_t hash() const noexcept {
+      uint64_t value = kind == HashKind::STRING ? std::hash<std::string_view>{}(string) : bits;
+      value ^= static_cast<uint64_t>(kind) << 56;
+
+      // Murmur3 finalizer, so sequential integer keys spread over both the group index and the control byte
+      value ^= value >> 33;
+      value *= 0xff51afd7ed558ccdULL;
+      value ^= value >> 33;
+      value *= 0xc4ceb9fe1a85ec53ULL;
+      value ^= value >> 33;
+      return value;
+    }
+  };
+
+  // An owned key, 16 bytes. Integers, numbers and booleans are stored inline. Strings and references
+  // live behind an owned pointer, and references hold a LuaCell so the key object stays alive while it
+  // is in the table, whichever coroutine inserted it.
+  class HashKey final {
+  public:
+    HashKey() noexcept = default;
+
+    HashKey(const HashKeyView& view, lua_State* L, const int index) : kind_(view.kind), bits_(view.bits) {
+      if (kind_ == HashKind::STRING) {
+        bits_ = reinterpret_cast<uintptr_t>(new std::string(view.string));
+      } else if (kind_ == HashKind::REFERENCE) {
+        bits_ = reinterpret_cast<uintptr_t>(new Reference{ view.bits, LuaCell::from_stack(L, index) });
+      }
+    }
+
+    HashKey(const HashKey&) = delete;
+    HashKey& operator=(const HashKey&) = delete;
+
+    HashKey(HashKey&& other) noexcept : kind_(other.kind_), bits_(std::exchange(other.bits_, 0)) {
+      other.kind_ = HashKind::INTEGER;
+    }
+
+    HashKey& operator=(HashKey&& other) noexcept {
+      if (this != &other) {
+        release();
+        kind_ = std::exchange(other.kind_, HashKind::INTEGER);
+        bits_ = std::exchange(other.bits_, 0);
+      }
+
+      return *this;
+    }
+
+    ~HashKey() {
+      release();
+    }
+
+    HashKeyView view() const noexcept {
+      HashKeyView out;
+      out.kind = kind_;
+
+      switch (kind_) {
+        case HashKind::STRING:
+          out.string = *reinterpret_cast<const std::string*>(bits_);
+          break;
+        case HashKind::REFERENCE:
+          out.bits = reinterpret_cast<const Reference*>(bits_)->identity;
+          break;
+        default:
+          out.bits = bits_;
+          break;
+      }
+
+      return out;
+    }
+
+    bool operator==(const HashKeyView& other) const noexcept {
+      if (kind_ != other.kind) {
+        return false;
+      }
+
+      switch (kind_) {
+        case HashKind::STRING:
+          return *reinterpret_cast<const std::string*>(bits_) == other.string;
+        case HashKind::REFERENCE:
+          return reinterpret_cast<const Reference*>(bits_)->identity == other.bits;
+        default:
+          return bits_ == other.bits;
+      }
+    }
+
+    void push(lua_State* L) const {
+      switch (kind_) {
+        case HashKind::INTEGER:
+          lua_pushinteger(L, static_cast<lua_Integer>(bits_));
+          break;
+        case HashKind::NUMBER:
+          lua_pushnumber(L, std::bit_cast<double>(bits_));
+          break;
+        case HashKind::BOOLEAN:
+          lua_pushboolean(L, bits_ != 0);
+          break;
+        case HashKind::STRING: {
+          const auto* string = reinterpret_cast<const std::string*>(bits_);
+          lua_pushlstring(L, string->data(), string->size());
+          break;
+        }
+        case HashKind::REFERENCE:
+          reinterpret_cast<const Reference*>(bits_)->object.push(L);
+          break;
+      }
+    }
+
+    sol::object to_object(lua_State* L) const {
+      push(L);
+      return sol::stack::pop<sol::object>(L);
+    }
+
+  private:
+    struct Reference {
+      uint64_t identity;
+      LuaCell object;
+    };
+
+    HashKind kind_ = HashKind::INTEGER;
+    uint64_t bits_ = 0;
+
+    void release() noexcept {
+      if (kind_ == HashKind::STRING) {
+        delete reinterpret_cast<std::string*>(bits_);
+      } else if (kind_ == HashKind::REFERENCE) {
+        delete reinterpret_cast<Reference*>(bits_);
+      }
+
+      kind_ = HashKind::INTEGER;
+      bits_ = 0;
+    }
+  };
+
+  // Open-addressing table in the style of Swiss tables. One control byte per slot holds either EMPTY,
+  // DELETED, or the low 7 bits of a full slot's hash. Probing loads a group of 8 control bytes as one
+  // 64-bit word and compares all of them at once with SWAR bit tricks, so a lookup usually touches one
+  // control word and one slot. Groups are probed triangularly, which visits every group when the group
+  // count is a power of two.
+  //
+  // Slot is any struct with a `HashKey key` member.
+  template<class Slot>
+  class HashTable final {
+  public:
+    static constexpr size_t GROUP_WIDTH = 8;
+    static constexpr size_t NPOS = std::numeric_limits<size_t>::max();
+
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return slots_.size(); }
+
+    Slot& slot(const size_t index) noexcept { return slots_[index]; }
+    const Slot& slot(const size_t index) const noexcept { return slots_[index]; }
+
+    size_t find(const HashKeyView& key, const uint64_t hash) const noexcept {
+      if (slots_.empty()) {
+        return NPOS;
+      }
+
+      const auto h2 = static_cast<uint8_t>(hash & 0x7F);
+      size_t group = (hash >> 7) & group_mask();
+
+      for (size_t probe = 0; probe <= group_mask(); ++probe) {
+        const uint64_t control = load_group(group);
+
+        for (uint64_t match = match_byte(control, h2); match; match &= match - 1) {
+          const size_t index = group * GROUP_WIDTH + std::countr_zero(match) / 8;
+          if (control_[index] == h2 && slots_[index].key == key) {
+            return index;
+          }
+        }
+
+        if (match_empty(control)) {
+          return NPOS;
+        }
+
+        group = (group + probe + 1) & group_mask();
+      }
+
+      return NPOS;
+    }
+
+    // Returns the slot for `key` and whether it was newly inserted. A new slot owns its key; any other
+    // members are default constructed. The key object is read from index `index` of the Lua stack.
+    std::pair<size_t, bool> insert(const HashKeyView& key, const uint64_t hash, lua_State* L, const int index) {
+      if (const size_t existing = find(key, hash); existing != NPOS) {
+        return { existing, false };
+      }
+
+      if (growth_left_ == 0) {
+        // Mostly tombstones: rehashing at the same size reclaims them
+        const size_t current = capacity();
+        rehash(current != 0 && size_ <= max_load(current) / 2 ? current : std::max(current * 2, GROUP_WIDTH));
+      }
+
+      const size_t target = find_insert_slot(hash);
+      if (control_[target] == EMPTY) {
+        growth_left_--;
+      }
+
+      control_[target] = static_cast<uint8_t>(hash & 0x7F);
+      slots_[target].key = HashKey(key, L, index);
+      size_++;
+
+      return { target, true };
+    }
+
+    void erase_at(const size_t index) noexcept {
+      control_[index] = DELETED;
+      slots_[index] = Slot();
+      size_--;
+    }
+
+    void clear() noexcept {
+      std::fill(control_.begin(), control_.end(), EMPTY);
+      for (Slot& slot : slots_) {
+        slot = Slot();
+      }
+
+      size_ = 0;
+      growth_left_ = max_load(capacity());
+    }
+
+    // Sizes the table so `count` elements fit without rehashing
+    void reserve(const size_t count) {
+      const size_t needed = std::bit_ceil(std::max(GROUP_WIDTH, (count * 8 + 6) / 7));
+      if (needed > capacity()) {
+        rehash(needed);
+      }
+    }
+
+    // Index of the first full slot at or after `from`, or NPOS
+    size_t next(size_t from) const noexcept {
+      for (; from < control_.size(); ++from) {
+        if ((control_[from] & 0x80) == 0) {
+          return from;
+        }
+      }
+
+      return NPOS;
+    }
+
+  private:
+    static constexpr uint8_t EMPTY = 0x80;
+    static constexpr uint8_t DELETED = 0xFE;
+
+    static constexpr uint64_t LSBS = 0x0101010101010101ULL;
+    static constexpr uint64_t MSBS = 0x8080808080808080ULL;
+
+    std::vector<uint8_t> control_;
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+    size_t growth_left_ = 0;
+
+    // 7/8 maximum load factor
+    static size_t max_load(const size_t capacity) noexcept {
+      return capacity - capacity / 8;
+    }
+
+    size_t group_mask() const noexcept {
+      return slots_.size() / GROUP_WIDTH - 1;
+    }
+
+    // Byte i of the result is control byte i of the group, whatever the host byte order
+    uint64_t load_group(const size_t group) const noexcept {
+      uint64_t control;
+      std::memcpy(&control, control_.data() + group * GROUP_WIDTH, sizeof(control));
+
+      if constexpr (std::endian::native == std::endian::big) {
+        control = std::byteswap(control);
+      }
+
+      return control;
+    }
+
+    // High bit set in every byte equal to h2. May report false positives, which the caller rejects by
+    // comparing the control byte itself.
+    static uint64_t match_byte(const uint64_t control, const uint8_t h2) noexcept {
+      const uint64_t x = control ^ (LSBS * h2);
+      return (x - LSBS) & ~x & MSBS;
+    }
+
+    static uint64_t match_empty(const uint64_t control) noexcept {
+      return control & ~(control << 6) & MSBS;
+    }
+
+    static uint64_t match_empty_or_deleted(const uint64_t control) noexcept {
+      return control & ~(control << 7) & MSBS;
+    }
+
+    size_t find_insert_slot(const uint64_t hash) const noexcept {
+      size_t group = (hash >> 7) & group_mask();
+
+      for (size_t probe = 0;; ++probe) {
+        if (const uint64_t match = match_empty_or_deleted(load_group(group))) {
+          return group * GROUP_WIDTH + std::countr_zero(match) / 8;
+        }
+
+        group = (group + probe + 1) & group_mask();
+      }
+    }
+
+    void rehash(const size_t new_capacity) {
+      std::vector<uint8_t> old_control = std::move(control_);
+      std::vector<Slot> old_slots = std::move(slots_);
+
+      control_.assign(new_capacity, EMPTY);
+      slots_ = std::vector<Slot>(new_capacity);
+      growth_left_ = max_load(new_capacity) - size_;
+
+      for (size_t i = 0; i < old_control.size(); ++i) {
+        if (old_control[i] & 0x80) {
+          continue;
+        }
+
+        const uint64_t hash = old_slots[i].key.view().hash();
+        const size_t target = find_insert_slot(hash);
+
+        control_[target] = static_cast<uint8_t>(hash & 0x7F);
+        slots_[target] = std::move(old_slots[i]);
+      }
+    }
+  };
+
+}
@@ -51,6 +51,18 @@ namespace umbra {
     }
   }
 
+  namespace vfs {
+    // FNV-1a, used by mounts to derive content fingerprints.
+    constexpr uint64_t hash_bytes(const uint8_t* bytes, const size_t size, uint64_t hash = 14695981039346656037ULL) noexcept {
+      for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+      }
+
+      return hash;
+    }
+  }
+
   class UMBRA_API IVFSMount {
   public:
 
@@ -67,6 +79,11 @@ namespace umbra {
     void write(std::string_view virtual_path, const std::vector<uint8_t>& data) const;
 
     void execute(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const;
+    sol::protected_function load(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const;
+
+    // Cheap identifier of the current contents of a file, used to validate cached chunks without reading
+    // the file. Mounts whose files never change may keep the default.
+    uint64_t fingerprint(std::string_view virtual_path) const;
 
     constexpr vfs::permissions::VFSPermission permissions() const noexcept {
       return permissions_;
@@ -83,6 +100,9 @@ namespace umbra {
     virtual void write_s(std::string_view virtual_path, const std::vector<uint8_t>& data) const = 0;
 
     virtual void execute_s(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const = 0;
+    virtual sol::protected_function load_s(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const = 0;
+
+    virtual uint64_t fingerprint_s(std::string_view virtual_path) const { return 0; }
 
   private:
     vfs::permissions::VFSPermission permissions_;
@@ -110,13 +130,29 @@ namespace umbra {
     void remove(std::string_view virtual_path) const;
     void write(std::string_view virtual_path, const std::vector<uint8_t>& data) const;
 
+    // Compiled chunks are cached per path and reused while the mount reports the same fingerprint,
+    // so executing a script again skips I/O, decryption and parsing.
     void execute(std::string_view virtual_path) const;
+    sol::protected_function load(std::string_view virtual_path) const;
+
+    void invalidate(std::string_view virtual_path) const noexcept;
+    void invalidate_all() const noexcept;
 
     bool has_permission(std::string_view mount_prefix, vfs::permissions::VFSPermission permission) const noexcept;
 
+    // Creates a VFS for another lua state that shares this one's mounts but keeps its own chunk cache.
+    // Mounts are safe to read from several threads; later mount/unmount calls are not propagated.
+    std::shared_ptr<VFS> fork(const std::shared_ptr<sol::state>& lua_state) const;
+
   private:
 
-    std::unordered_map<std::string, std::unique_ptr<IVFSMount>> mounts_;
+    struct CachedChunk {
+      uint64_t fingerprint;
+      sol::protected_function chunk;
+    };
+
+    std::unordered_map<std::string, std::shared_ptr<IVFSMount>> mounts_;
+    mutable std::unordered_map<const IVFSMount*, std::unordered_map<std::string, CachedChunk>> chunk_cache_;
 
     std::pair<const IVFSMount*, std::string> route(std::string_view virtual_path) const noexcept;
 
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Umbra/umbra.hpp"
+#include "Umbra/lua_allocator.hpp"
+#include "Umbra/vfs.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sol/sol.hpp>
+
+namespace umbra {
+
+  // A message is a sequence of Lua values flattened into bytes, so it can cross between lua states owned by
+  // different threads. Only nil, booleans, numbers, strings and tables of those are representable.
+  using WorkerMessage = std::vector<uint8_t>;
+
+  // Unbounded multi-producer queue of messages. Messages are moved in and out, never copied.
+  class UMBRA_API MessageChannel final {
+  public:
+
+    MessageChannel() = default;
+
+    MessageChannel(const MessageChannel&) = delete;
+    MessageChannel& operator=(const MessageChannel&) = delete;
+
+    bool push(WorkerMessage&& message);
+    std::optional<WorkerMessage> try_pop();
+
+    // Blocks until a message arrives, the channel is closed or the timeout elapses
+    std::optional<WorkerMessage> pop(std::optional<std::chrono::milliseconds> timeout);
+
+    void close();
+    bool closed() const;
+    size_t size() const;
+
+  private:
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<WorkerMessage> queue_;
+    bool closed_ = false;
+  };
+
+  // An isolated lua state running a script from the VFS on its own thread. The script receives the spawn
+  // arguments as `...` and talks to the main state through the global `worker` table.
+  class UMBRA_API Worker final {
+  public:
+
+    Worker(const VFS& vfs, std::string virtual_path, WorkerMessage arguments);
+    ~Worker();
+
+    Worker(const Worker&) = delete;
+    Worker& operator=(const Worker&) = delete;
+    Worker(Worker&&) = delete;
+    Worker& operator=(Worker&&) = delete;
+
+    // Serializes `count` values starting at stack index `first`
+    static WorkerMessage pack(lua_State* L, int first, int count);
+
+    // Pushes the values of a message and returns how many were pushed
+    static int unpack(lua_State* L, const WorkerMessage& message);
+
+    void send(const sol::variadic_args& args, sol::this_state this_state);
+    sol::variadic_results receive(sol::this_state this_state);
+    size_t pending() const;
+
+    bool is_running() const;
+    sol::optional<std::string> get_error() const;
+
+    // Asks the worker to stop. A running script is interrupted at its next hook check.
+    void terminate();
+    void join();
+
+    const std::string& path() const { return path_; }
+
+  private:
+    std::shared_ptr<LuaAllocator> allocator_;
+    std::shared_ptr<sol::state> lua_state_;
+    std::shared_ptr<VFS> vfs_;
+
+    std::string path_;
+    WorkerMessage arguments_;
+
+    MessageChannel inbox_;
+    MessageChannel outbox_;
+
+    std::atomic<bool> stop_requested_ = false;
+    std::atomic<bool> running_ = true;
+
+    mutable std::mutex error_mutex_;
+    std::optional<std::string> error_;
+
+    std::thread thread_;
+
+    void run();
+    void bind_worker_global();
+
+    static void interrupt_hook(lua_State* L, lua_Debug* debug);
+  };
+
+}
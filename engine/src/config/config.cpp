@@ -1,5 +1,6 @@
 #include "Umbra/config.hpp"
 
+#include <algorithm>
 #include <fmt/format.h>
 #include <toml++/toml.hpp>
 
@@ -22,6 +23,32 @@ umbra::Config parse_config_from_table(toml::table config_toml, const std::filesy
   config.organization = config_toml["organization"].value_or("");
   config.version = config_toml["version"].value_or("");
   config.entry = require_string("entry");
+  config.pak_cache_budget = static_cast<size_t>(std::max<int64_t>(0, config_toml["pak_cache_mb"].value_or(int64_t{ 16 }))) * 1024 * 1024;
+  config.compress_user_data = config_toml["compress_user_data"].value_or(false);
+  config.ram_capacity = static_cast<size_t>(std::max<int64_t>(0, config_toml["ram_capacity_mb"].value_or(int64_t{ 64 }))) * 1024 * 1024;
+
+  config.gc_mode = config_toml["gc_mode"].value_or("incremental");
+  if (config.gc_mode != "incremental" && config.gc_mode != "generational") {
+    umbra::umbra_fail(fmt::format("Config: gc_mode must be 'incremental' or 'generational', got '{}'", config.gc_mode));
+  }
+
+  config.gc_pause = config_toml["gc_pause"].value_or(0);
+  config.gc_step_multiplier = config_toml["gc_step_multiplier"].value_or(0);
+  config.gc_step_size = config_toml["gc_step_size"].value_or(0);
+  config.gc_minor_multiplier = config_toml["gc_minor_multiplier"].value_or(0);
+  config.gc_major_multiplier = config_toml["gc_major_multiplier"].value_or(0);
+  config.gc_frame_budget_ms = std::max(0.0, config_toml["gc_frame_budget_ms"].value_or(1.0));
+
+  config.target_fps = std::max(0.0, config_toml["target_fps"].value_or(60.0));
+  config.idle_fps = std::max(0.0, config_toml["idle_fps"].value_or(10.0));
+  config.fixed_update_hz = config_toml["fixed_update_hz"].value_or(60.0);
+  config.max_updates_per_frame = std::max(1, config_toml["max_updates_per_frame"].value_or(5));
+
+  if (config.fixed_update_hz <= 0.0) {
+    umbra::umbra_fail(fmt::format("Config: fixed_update_hz must be positive, got {}", config.fixed_update_hz));
+  }
+
+  config.max_workers = static_cast<size_t>(std::max<int64_t>(0, config_toml["max_workers"].value_or(int64_t{ 0 })));
 
   if (!root.empty() && !config_path.empty()) {
     config.root_dir = root;
@@ -0,0 +1,132 @@
+#include "Umbra/lua_allocator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+umbra::LuaAllocator::~LuaAllocator() {
+  for (void* slab : slabs_) {
+    std::free(slab);
+  }
+}
+
+void* umbra::LuaAllocator::allocate(void* user_data, void* block, size_t old_size, const size_t new_size) noexcept {
+  auto* self = static_cast<LuaAllocator*>(user_data);
+
+  // For fresh allocations Lua passes the object type in old_size rather than a size
+  if (!block) {
+    old_size = 0;
+  }
+
+  if (new_size == 0) {
+    if (block) {
+      self->release(block, old_size);
+    }
+
+    return nullptr;
+  }
+
+  // Shrinking or growing within the same pooled class keeps the block in place
+  if (block && old_size <= LARGE_BLOCK && new_size <= LARGE_BLOCK && size_class(old_size) == size_class(new_size)) {
+    self->stats_.live_bytes = self->stats_.live_bytes - old_size + new_size;
+    self->stats_.peak_bytes = std::max(self->stats_.peak_bytes, self->stats_.live_bytes);
+    self->stats_.allocated_bytes += new_size > old_size ? new_size - old_size : 0;
+    return block;
+  }
+
+  if (block && old_size > LARGE_BLOCK && new_size > LARGE_BLOCK) {
+    void* resized = std::realloc(block, new_size);
+    if (!resized) {
+      return nullptr;
+    }
+
+    self->stats_.live_bytes = self->stats_.live_bytes - old_size + new_size;
+    self->stats_.peak_bytes = std::max(self->stats_.peak_bytes, self->stats_.live_bytes);
+    self->stats_.allocated_bytes += new_size > old_size ? new_size - old_size : 0;
+    return resized;
+  }
+
+  void* resized = self->acquire(new_size);
+  if (!resized) {
+    return nullptr;
+  }
+
+  if (block) {
+    std::memcpy(resized, block, std::min(old_size, new_size));
+    self->release(block, old_size);
+  }
+
+  return resized;
+}
+
+void* umbra::LuaAllocator::acquire(const size_t size) noexcept {
+  void* block = nullptr;
+
+  if (size > LARGE_BLOCK) {
+    block = std::malloc(size);
+  } else {
+    const size_t index = size_class(size);
+    if (!free_lists_[index] && !refill(index)) {
+      return nullptr;
+    }
+
+    FreeBlock* head = free_lists_[index];
+    free_lists_[index] = head->next;
+    block = head;
+  }
+
+  if (!block) {
+    return nullptr;
+  }
+
+  stats_.live_bytes += size;
+  stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.live_bytes);
+  stats_.allocated_bytes += size;
+  ++stats_.allocations;
+
+  return block;
+}
+
+void umbra::LuaAllocator::release(void* block, const size_t size) noexcept {
+  if (size > LARGE_BLOCK) {
+    std::free(block);
+  } else {
+    const size_t index = size_class(size);
+
+    auto* node = static_cast<FreeBlock*>(block);
+    node->next = free_lists_[index];
+    free_lists_[index] = node;
+  }
+
+  stats_.live_bytes -= size;
+  ++stats_.frees;
+}
+
+bool umbra::LuaAllocator::refill(const size_t size_class) noexcept {
+  const size_t block_size = (size_class + 1) * GRANULARITY;
+
+  // malloc alignment covers every Lua object; block sizes are multiples of GRANULARITY so it carries through
+  void* slab = std::malloc(SLAB_SIZE);
+  if (!slab) {
+    return false;
+  }
+
+  try {
+    slabs_.push_back(slab);
+  } catch (...) {
+    std::free(slab);
+    return false;
+  }
+
+  auto* bytes = static_cast<uint8_t*>(slab);
+  const size_t block_count = SLAB_SIZE / block_size;
+
+  for (size_t i = block_count; i-- > 0;) {
+    auto* node = reinterpret_cast<FreeBlock*>(bytes + i * block_size);
+    node->next = free_lists_[size_class];
+    free_lists_[size_class] = node;
+  }
+
+  stats_.pool_bytes += SLAB_SIZE;
+  return true;
+}
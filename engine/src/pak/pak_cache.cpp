@@ -0,0 +1,61 @@
+#include "Umbra/pak.hpp"
+
+std::shared_ptr<const std::vector<uint8_t>> umbra::PakCache::fetch(const size_t entry_index) {
+  std::lock_guard lock(mutex_);
+
+  const auto it = index_.find(entry_index);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+
+  slots_.splice(slots_.begin(), slots_, it->second);
+  return it->second->compressed;
+}
+
+void umbra::PakCache::store(const size_t entry_index, std::shared_ptr<const std::vector<uint8_t>> compressed) {
+  std::lock_guard lock(mutex_);
+
+  if (!compressed || compressed->size() > budget_ || index_.contains(entry_index)) {
+    return;
+  }
+
+  evict_to(budget_ - compressed->size());
+
+  resident_ += compressed->size();
+  slots_.push_front(Slot{ entry_index, std::move(compressed) });
+  index_[entry_index] = slots_.begin();
+}
+
+void umbra::PakCache::set_budget(const size_t budget) {
+  std::lock_guard lock(mutex_);
+
+  budget_ = budget;
+  evict_to(budget_);
+}
+
+void umbra::PakCache::clear() {
+  std::lock_guard lock(mutex_);
+
+  slots_.clear();
+  index_.clear();
+  resident_ = 0;
+}
+
+size_t umbra::PakCache::budget() const {
+  std::lock_guard lock(mutex_);
+  return budget_;
+}
+
+size_t umbra::PakCache::resident() const {
+  std::lock_guard lock(mutex_);
+  return resident_;
+}
+
+void umbra::PakCache::evict_to(const size_t budget) {
+  while (resident_ > budget && !slots_.empty()) {
+    const Slot& victim = slots_.back();
+    resident_ -= victim.compressed->size();
+    index_.erase(victim.entry_index);
+    slots_.pop_back();
+  }
+}
@@ -1,4 +1,5 @@
 #include "Umbra/pak.hpp"
+#include "Umbra/vfs.hpp"
 
 #include <cstring>
 #include <fstream>
@@ -72,6 +73,22 @@ std::vector<uint8_t> umbra::PakReader::read(const std::string& virtual_path) con
 
   const PakEntry& entry = pak_file.entries.at(it->second);
 
+  std::shared_ptr<const std::vector<uint8_t>> compressed = cache.fetch(it->second);
+  if (!compressed) {
+    compressed = read_compressed(entry);
+    cache.store(it->second, compressed);
+  }
+
+  std::vector<uint8_t> out(entry.raw_size);
+  const size_t result = ZSTD_decompress(out.data(), out.size(), compressed->data(), compressed->size());
+  if (ZSTD_isError(result) || result != out.size()) {
+    umbra_fail("PakReader: decompression failed");
+  }
+
+  return out;
+}
+
+std::shared_ptr<const std::vector<uint8_t>> umbra::PakReader::read_compressed(const PakEntry& entry) const {
   std::ifstream file(pak_file.path, std::ios::binary);
   if (!file) {
     umbra_fail("PakReader: failed to open file");
@@ -93,11 +110,11 @@ std::vector<uint8_t> umbra::PakReader::read(const std::string& virtual_path) con
   }
 
   const size_t compressed_capacity = entry.cipher_size - crypto_aead_xchacha20poly1305_ietf_ABYTES;
-  std::vector<uint8_t> compressed(compressed_capacity);
+  auto compressed = std::make_shared<std::vector<uint8_t>>(compressed_capacity);
 
   unsigned long long compressed_size = 0;
   if (crypto_aead_xchacha20poly1305_ietf_decrypt(
-    compressed.data(), &compressed_size, nullptr,
+    compressed->data(), &compressed_size, nullptr,
     cipher.data(), cipher.size(),
     ad, ad_len,
     entry.nonce.data(),
@@ -106,15 +123,8 @@ std::vector<uint8_t> umbra::PakReader::read(const std::string& virtual_path) con
     umbra_fail("PakReader: pak decryption failed");
   }
 
-  compressed.resize(compressed_size);
-
-  std::vector<uint8_t> out(entry.raw_size);
-  const size_t result = ZSTD_decompress(out.data(), out.size(), compressed.data(), compressed_size);
-  if (ZSTD_isError(result) || result != out.size()) {
-    umbra_fail("PakReader: decompression failed");
-  }
-
-  return out;
+  compressed->resize(compressed_size);
+  return compressed;
 }
 
 std::vector<std::string> umbra::PakReader::list() const {
@@ -125,3 +135,20 @@ std::vector<std::string> umbra::PakReader::list() const {
 
   return out;
 }
+
+uint64_t umbra::PakReader::fingerprint(const std::string& virtual_path) const {
+  const auto it = pak_file.index.find(virtual_path);
+  if (it == pak_file.index.end()) {
+    return 0;
+  }
+
+  const PakEntry& entry = pak_file.entries[it->second];
+
+  uint64_t hash = vfs::hash_bytes(entry.nonce.data(), entry.nonce.size());
+  hash = vfs::hash_bytes(reinterpret_cast<const uint8_t*>(&entry.cipher_size), sizeof(entry.cipher_size), hash);
+  return vfs::hash_bytes(reinterpret_cast<const uint8_t*>(&entry.raw_size), sizeof(entry.raw_size), hash);
+}
+
+void umbra::PakReader::set_cache_budget(const size_t budget) {
+  cache.set_budget(budget);
+}
@@ -1,6 +1,7 @@
 #include "Umbra/pak.hpp"
 
 #include <fstream>
+#include <lua.hpp>
 #include <zstd.h>
 #include <cstring>
 
@@ -50,6 +51,32 @@ static std::vector<uint8_t> zstd_compress(const std::vector<uint8_t>& in) {
   return out;
 }
 
+static int bytecode_writer(lua_State*, const void* chunk, const size_t size, void* user_data) {
+  auto* out = static_cast<std::vector<uint8_t>*>(user_data);
+  const auto* bytes = static_cast<const uint8_t*>(chunk);
+  out->insert(out->end(), bytes, bytes + size);
+  return 0;
+}
+
+static std::vector<uint8_t> compile_script(const std::vector<uint8_t>& source, const std::string& chunk_name, const bool strip_debug_info) {
+  const std::unique_ptr<lua_State, decltype(&lua_close)> lua_state(luaL_newstate(), &lua_close);
+  if (!lua_state) {
+    umbra::umbra_fail("PakWriter: failed to create lua state for compilation");
+  }
+
+  if (luaL_loadbufferx(lua_state.get(), reinterpret_cast<const char*>(source.data()), source.size(), chunk_name.c_str(), "t") != LUA_OK) {
+    const char* message = lua_tostring(lua_state.get(), -1);
+    umbra::umbra_fail("PakWriter: failed to compile '" + chunk_name + "': " + (message ? message : "unknown error"));
+  }
+
+  std::vector<uint8_t> bytecode;
+  if (lua_dump(lua_state.get(), bytecode_writer, &bytecode, strip_debug_info ? 1 : 0) != 0) {
+    umbra::umbra_fail("PakWriter: failed to dump bytecode for '" + chunk_name + "'");
+  }
+
+  return bytecode;
+}
+
 static void derive_key(std::vector<uint8_t>& out_key, const uint8_t salt[16], const std::vector<uint8_t>& secret) {
   out_key.resize(crypto_aead_xchacha20poly1305_ietf_KEYBYTES);
   if (crypto_pwhash(out_key.data(), out_key.size(), reinterpret_cast<const char*>(secret.data()), secret.size(), salt, crypto_pwhash_OPSLIMIT_MODERATE, crypto_pwhash_MEMLIMIT_MODERATE, crypto_pwhash_ALG_DEFAULT) != 0) {
@@ -57,7 +84,7 @@ static void derive_key(std::vector<uint8_t>& out_key, const uint8_t salt[16], co
   }
 }
 
-umbra::PakWriter::PakWriter(const std::filesystem::path &out_file, const std::vector<uint8_t> &secret, const std::filesystem::path &virtual_base) : out_file(out_file), virtual_base(virtual_base), secret(secret) {
+umbra::PakWriter::PakWriter(const std::filesystem::path &out_file, const std::vector<uint8_t> &secret, const std::filesystem::path &virtual_base, const PakWriterOptions& options) : out_file(out_file), virtual_base(virtual_base), options(options), secret(secret) {
   if (sodium_init() < 0) {
     umbra_fail("PakWriter: failed to initialize sodium");
   }
@@ -121,7 +148,11 @@ void umbra::PakWriter::add_file(const std::filesystem::path &disk_path, const st
   item.disk_path = disk_path;
   item.virtual_path = virtual_override.empty() ? relative(disk_path, virtual_base).generic_string() : virtual_override.generic_string();
 
-  const std::vector<uint8_t> raw = read_all(disk_path);
+  std::vector<uint8_t> raw = read_all(disk_path);
+  if (options.compile_scripts && disk_path.extension() == ".lua") {
+    raw = compile_script(raw, item.virtual_path, options.strip_debug_info);
+  }
+
   item.raw_size = raw.size();
 
   const std::vector<uint8_t> compressed = zstd_compress(raw);
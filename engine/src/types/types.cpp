@@ -0,0 +1,43 @@
+#include "Umbra/types.hpp"
+
+#include "Umbra/types/data/file.hpp"
+#include "Umbra/types/data/matrix4.hpp"
+#include "Umbra/types/data/quaternion.hpp"
+#include "Umbra/types/data/vector2.hpp"
+#include "Umbra/types/data/vector3.hpp"
+#include "Umbra/types/ordered/deque.hpp"
+#include "Umbra/types/ordered/dynamic_array.hpp"
+#include "Umbra/types/ordered/priority_queue.hpp"
+#include "Umbra/types/ordered/singly_linked_list.hpp"
+#include "Umbra/types/ordered/static_array.hpp"
+#include "Umbra/types/ordered/typed_array.hpp"
+#include "Umbra/types/ordered/vector_array.hpp"
+#include "Umbra/types/spatial/bvh.hpp"
+#include "Umbra/types/spatial/quadtree.hpp"
+#include "Umbra/types/spatial/uniform_grid.hpp"
+#include "Umbra/types/unordered/hash_map.hpp"
+#include "Umbra/types/unordered/hash_set.hpp"
+
+void umbra::register_builtin_types(TypeRegistry& type_registry) {
+  type_registry.register_type<Vector2>();
+  type_registry.register_type<Vector3>();
+  type_registry.register_type<Quaternion>();
+  type_registry.register_type<Matrix4>();
+  type_registry.register_type<DynamicArray>();
+  type_registry.register_type<StaticArray>();
+  type_registry.register_type<SinglyLinkedList>();
+  type_registry.register_type<Deque>();
+  type_registry.register_type<PriorityQueue>();
+  type_registry.register_type<Float32Array>();
+  type_registry.register_type<Float64Array>();
+  type_registry.register_type<Int32Array>();
+  type_registry.register_type<UInt8Array>();
+  type_registry.register_type<Vector2Array>();
+  type_registry.register_type<Vector3Array>();
+  type_registry.register_type<HashMap>();
+  type_registry.register_type<HashSet>();
+  type_registry.register_type<UniformGrid>();
+  type_registry.register_type<Quadtree>();
+  type_registry.register_type<Bvh>();
+  type_registry.register_type<File>();
+}
@@ -1,28 +1,34 @@
 #include "Umbra/umbra.hpp"
 #include "Umbra/builtins.hpp"
+#include "Umbra/builtins/require.hpp"
 #include "Umbra/config.hpp"
 #include "Umbra/engine_state.hpp"
+#include "Umbra/lua_allocator.hpp"
 #include "Umbra/umbra_exception.hpp"
 
 #include "Umbra/vfs.hpp"
 #include "Umbra/mounts/fs_mount.hpp"
 #include "Umbra/mounts/pak_mount.hpp"
+#include "Umbra/mounts/ram_mount.hpp"
 
 #include "Umbra/types.hpp"
-#include "Umbra/types/data/file.hpp"
-#include "Umbra/types/data/vector2.hpp"
 #include "Umbra/types/data/vector3.hpp"
-#include "Umbra/types/ordered/dynamic_array.hpp"
-#include "Umbra/types/ordered/singly_linked_list.hpp"
-#include "Umbra/types/ordered/static_array.hpp"
 
 #include "Umbra/services.hpp"
+#include "Umbra/services/garbage_collector.hpp"
+#include "Umbra/services/profiler.hpp"
 #include "Umbra/services/renderer.hpp"
+#include "Umbra/services/scheduler.hpp"
 #include "Umbra/services/virtual_file_system.hpp"
+#include "Umbra/services/worker.hpp"
 
-#define SOL_ALL_SAFETIES_ON 1
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <optional>
+#include <thread>
 #include <vector>
+#include <fmt/format.h>
 #include <sol/sol.hpp>
 #include <OgreRoot.h>
 #include <OgreEntity.h>
@@ -75,7 +81,7 @@ static int lua_exception(lua_State* L, const sol::optional<const std::exception&
   return sol::stack::push(L, description);
 }
 
-static void bind_umbra_global(const umbra::EngineState* engine_state, const int argc, char** argv) {
+static void bind_umbra_global(umbra::EngineState* engine_state, const int argc, char** argv) {
   sol::table umbra = engine_state->lua_state->create_named_table("umbra");
 
   { // Initialize umbra.command_line_args
@@ -91,6 +97,111 @@ static void bind_umbra_global(const umbra::EngineState* engine_state, const int
       return engine_state->service_registry->fetch_service_lua(service_name);
     });
   }
+
+  { // Define umbra.on_update and umbra.on_render; passing nil removes the callback
+    umbra.set_function("on_update", [engine_state](const sol::optional<sol::protected_function>& callback) {
+      engine_state->update_callback = callback.value_or(sol::protected_function{});
+    });
+
+    umbra.set_function("on_render", [engine_state](const sol::optional<sol::protected_function>& callback) {
+      engine_state->render_callback = callback.value_or(sol::protected_function{});
+    });
+  }
+}
+
+template<class... Args>
+static void invoke_callback(umbra::ProfilerService& profiler, const sol::protected_function& callback, const char* callback_name, Args&&... args) {
+  if (!callback.valid()) {
+    return;
+  }
+
+  profiler.enter_callback();
+  const sol::protected_function_result result = callback(std::forward<Args>(args)...);
+  profiler.leave_callback();
+
+  if (!result.valid()) {
+    const sol::error err = result;
+    umbra::umbra_fail(fmt::format("Lua: error in {} callback: {}", callback_name, err.what()));
+  }
+}
+
+// Runs until the window closes. Simulation advances in fixed steps of 1 / fixed_update_hz through the update
+// callback; the render callback runs once per frame with the fraction of a step left over, for interpolation.
+// Frames are capped at target_fps, and at idle_fps while the window is unfocused. While minimised, no frames
+// are produced at all and the thread sleeps in glfwWaitEventsTimeout.
+static void run_main_loop(umbra::EngineState& state) {
+  using clock = std::chrono::steady_clock;
+  using seconds = std::chrono::duration<double>;
+
+  const std::shared_ptr<umbra::RendererService> renderer = state.service_registry->fetch_service<umbra::RendererService>("Renderer");
+  const std::shared_ptr<umbra::ProfilerService> profiler = state.service_registry->fetch_service<umbra::ProfilerService>("Profiler");
+  const std::shared_ptr<umbra::SchedulerService> scheduler = state.service_registry->fetch_service<umbra::SchedulerService>("Scheduler");
+  const umbra::Config& config = state.config;
+
+  const double step = 1.0 / config.fixed_update_hz;
+
+  // Longer frames are treated as this long, so a stall does not turn into a burst of catch-up updates
+  constexpr double max_frame_time = 0.25;
+
+  double accumulator = 0.0;
+  clock::time_point previous = clock::now();
+
+  while (!renderer->should_close()) {
+    if (renderer->is_iconified()) {
+      renderer->wait_events(config.idle_fps > 0.0 ? 1.0 / config.idle_fps : 0.1);
+      previous = clock::now();
+      continue;
+    }
+
+    const clock::time_point frame_start = clock::now();
+    const double frame_time = std::min(seconds(frame_start - previous).count(), max_frame_time);
+    previous = frame_start;
+
+    renderer->begin_render();
+
+    // Resumed tasks are Lua code like the callbacks, so the profiler charges them the same way
+    if (scheduler) {
+      profiler->enter_callback();
+      scheduler->tick();
+      profiler->leave_callback();
+    }
+
+    accumulator += frame_time;
+
+    int updates = 0;
+    while (accumulator >= step && updates < config.max_updates_per_frame) {
+      invoke_callback(*profiler, state.update_callback, "update", step);
+      accumulator -= step;
+      ++updates;
+    }
+
+    // Still behind after the per-frame limit: drop the backlog rather than fall further behind next frame
+    if (accumulator >= step) {
+      accumulator = std::fmod(accumulator, step);
+    }
+
+    invoke_callback(*profiler, state.render_callback, "render", accumulator / step, frame_time);
+
+    renderer->end_render();
+
+    const bool idle = !renderer->is_focused();
+    const double fps_cap = idle ? config.idle_fps : config.target_fps;
+    if (fps_cap <= 0.0) {
+      continue;
+    }
+
+    const clock::time_point deadline = frame_start + std::chrono::duration_cast<clock::duration>(seconds(1.0 / fps_cap));
+    const double remaining = seconds(deadline - clock::now()).count();
+    if (remaining <= 0.0) {
+      continue;
+    }
+
+    if (idle) {
+      renderer->wait_events(remaining);
+    } else {
+      std::this_thread::sleep_until(deadline);
+    }
+  }
 }
 
 int umbra::umbra_run(const char* entry_path, const uint8_t* secret, const size_t secret_size, const int argc, char** argv) try {
@@ -109,9 +220,14 @@ int umbra::umbra_run(const char* entry_path, const uint8_t* secret, const size_t
 
   state.ogre_root = std::make_shared<Ogre::Root>("", "", "");
 
-  state.lua_state = std::make_shared<sol::state>();
+  state.lua_allocator = std::make_shared<LuaAllocator>();
+
+  // The deleter holds the allocator so it outlives every block the state still owns on close
+  state.lua_state = std::shared_ptr<sol::state>(
+    new sol::state(sol::c_call<decltype(&lua_panic), &lua_panic>, &LuaAllocator::allocate, state.lua_allocator.get()),
+    [allocator = state.lua_allocator](const sol::state* lua_state) { delete lua_state; }
+  );
   state.lua_state->set_exception_handler(&lua_exception);
-  state.lua_state->set_panic(sol::c_call<decltype(&lua_panic), &lua_panic>);
   state.lua_state->open_libraries(sol::lib::base, sol::lib::bit32, sol::lib::coroutine, sol::lib::math, sol::lib::string, sol::lib::table);
 
   state.vfs = std::make_shared<VFS>(state.lua_state);
@@ -125,12 +241,19 @@ int umbra::umbra_run(const char* entry_path, const uint8_t* secret, const size_t
       )
     );
 
+  if (!state.vfs->exists("cfg://umbra.toml")) {
+    umbra_fail("Umbra: cfg.pak does not contain umbra.toml");
+  }
+
+  state.config = load_config(state.vfs->read("cfg://umbra.toml"));
+
   state.vfs->mount(
     "src://",
     std::make_unique<VFSPakMount>(
       "src.pak",
       key,
-      vfs::permissions::EXECUTE | vfs::permissions::READ | vfs::permissions::LIST
+      vfs::permissions::EXECUTE | vfs::permissions::READ | vfs::permissions::LIST,
+      state.config.pak_cache_budget
     )
   );
 
@@ -139,7 +262,8 @@ int umbra::umbra_run(const char* entry_path, const uint8_t* secret, const size_t
     std::make_unique<VFSPakMount>(
       "ass.pak",
       key,
-      vfs::permissions::READ | vfs::permissions::LIST
+      vfs::permissions::READ | vfs::permissions::LIST,
+      state.config.pak_cache_budget
     )
   );
 
@@ -147,7 +271,8 @@ int umbra::umbra_run(const char* entry_path, const uint8_t* secret, const size_t
     "data://",
     std::make_unique<VFSFSMount>(
       "data",
-      vfs::permissions::READ | vfs::permissions::WRITE | vfs::permissions::CREATE | vfs::permissions::REMOVE | vfs::permissions::LIST
+      vfs::permissions::READ | vfs::permissions::WRITE | vfs::permissions::CREATE | vfs::permissions::REMOVE | vfs::permissions::LIST,
+      false
     )
   );
 
@@ -155,7 +280,16 @@ int umbra::umbra_run(const char* entry_path, const uint8_t* secret, const size_t
     "user://",
     std::make_unique<VFSFSMount>(
       user_data_root() / sanitize_alphanumeric(state.config.organization) / sanitize_alphanumeric(state.config.name),
-      vfs::permissions::READ | vfs::permissions::WRITE | vfs::permissions::CREATE | vfs::permissions::REMOVE | vfs::permissions::LIST
+      vfs::permissions::READ | vfs::permissions::WRITE | vfs::permissions::CREATE | vfs::permissions::REMOVE | vfs::permissions::LIST,
+      state.config.compress_user_data
+    )
+  );
+
+  state.vfs->mount(
+    "ram://",
+    std::make_unique<VFSRamMount>(
+      state.config.ram_capacity,
+      vfs::permissions::READ | vfs::permissions::WRITE | vfs::permissions::CREATE | vfs::permissions::REMOVE | vfs::permissions::LIST | vfs::permissions::EXECUTE
     )
   );
 
@@ -163,25 +297,16 @@ int umbra::umbra_run(const char* entry_path, const uint8_t* secret, const size_t
     umbra_fail("Umbra: entry script not found");
   }
 
-  if (!state.vfs->exists("cfg://umbra.toml")) {
-    umbra_fail("Umbra: cfg.pak does not contain umbra.toml");
-  }
-
-  state.config = load_config(state.vfs->read("cfg://umbra.toml"));
-
   { // Register Builtins
     state.builtin_registry = std::make_shared<BuiltinRegistry>(state.lua_state);
+
+    state.builtin_registry->register_builtin<RequireBuiltin>("require", state.vfs);
   }
 
   { // Register Types
     state.type_registry = std::make_shared<TypeRegistry>(state.lua_state);
 
-    state.type_registry->register_type<Vector2>();
-    state.type_registry->register_type<Vector3>();
-    state.type_registry->register_type<DynamicArray>();
-    state.type_registry->register_type<StaticArray>();
-    state.type_registry->register_type<SinglyLinkedList>();
-    state.type_registry->register_type<File>();
+    register_builtin_types(*state.type_registry);
   }
 
   { // Register Services
@@ -189,6 +314,10 @@ int umbra::umbra_run(const char* entry_path, const uint8_t* secret, const size_t
 
     state.service_registry->register_service<RendererService>(&state);
     state.service_registry->register_service<VirtualFileSystemService>(&state);
+    state.service_registry->register_service<GarbageCollectorService>(&state);
+    state.service_registry->register_service<SchedulerService>(&state);
+    state.service_registry->register_service<WorkerService>(&state);
+    state.service_registry->register_service<ProfilerService>(&state);
   }
 
   bind_umbra_global(&state, argc, argv);
@@ -196,7 +325,31 @@ int umbra::umbra_run(const char* entry_path, const uint8_t* secret, const size_t
   state.ogre_camera_node->setPosition(0, 0, 2.0f);
   state.ogre_camera_node->lookAt(static_cast<Ogre::Vector3>(Vector3(0, 0, 0)), Ogre::Node::TS_WORLD);
 
+  // --profile[=data://path.folded] samples the whole run and saves when the engine loop exits
+  std::optional<std::string> profile_path;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i] ? argv[i] : "";
+    if (arg == "--profile") {
+      profile_path = "data://profile.folded";
+    } else if (arg.starts_with("--profile=")) {
+      profile_path = std::string(arg.substr(std::string_view("--profile=").size()));
+    }
+  }
+
+  const std::shared_ptr<ProfilerService> profiler = state.service_registry->fetch_service<ProfilerService>("Profiler");
+  if (profile_path) {
+    profiler->start(sol::nullopt);
+  }
+
   state.vfs->execute("src://"s + entry_path);
+  profiler->leave_callback();
+
+  run_main_loop(state);
+
+  if (profile_path) {
+    profiler->stop();
+    profiler->save(*profile_path);
+  }
 
   return 0;
 } catch (const UmbraException&) {
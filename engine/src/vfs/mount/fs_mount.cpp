@@ -1,13 +1,57 @@
 #include "Umbra/mounts/fs_mount.hpp"
 #include "Umbra/umbra.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <fmt/format.h>
+#include <zstd.h>
 
 using namespace std::string_literals;
 
-umbra::VFSFSMount::VFSFSMount(const std::filesystem::path &directory, const vfs::permissions::VFSPermission permissions) : IVFSMount(permissions) {
+static std::vector<uint8_t> zstd_compress(const std::vector<uint8_t>& in) {
+  umbra::CompressedFileHeader header{};
+  std::memcpy(header.magic, umbra::FS_COMPRESSED_MAGIC, umbra::FS_COMPRESSED_MAGIC_LEN);
+  header.version = UMBRA_VERSION;
+  header.reserved = 0;
+  header.raw_size = in.size();
+
+  const size_t bound = ZSTD_compressBound(in.size());
+  std::vector<uint8_t> out(sizeof(header) + bound);
+  std::memcpy(out.data(), &header, sizeof(header));
+
+  const size_t result = ZSTD_compress(out.data() + sizeof(header), bound, in.data(), in.size(), 3);
+  if (ZSTD_isError(result)) {
+    umbra::umbra_fail("VFSFS: failed to compress data");
+  }
+
+  out.resize(sizeof(header) + result);
+  return out;
+}
+
+static bool is_compressed(const std::vector<uint8_t>& data) {
+  return data.size() >= sizeof(umbra::CompressedFileHeader) && std::memcmp(data.data(), umbra::FS_COMPRESSED_MAGIC, umbra::FS_COMPRESSED_MAGIC_LEN) == 0;
+}
+
+static std::vector<uint8_t> zstd_decompress(const std::vector<uint8_t>& in, const std::string_view virtual_path) {
+  umbra::CompressedFileHeader header{};
+  std::memcpy(&header, in.data(), sizeof(header));
+
+  if (ZSTD_getFrameContentSize(in.data() + sizeof(header), in.size() - sizeof(header)) != header.raw_size) {
+    umbra::umbra_fail(fmt::format("VFSFS: corrupt compressed file '{}'", virtual_path));
+  }
+
+  std::vector<uint8_t> out(header.raw_size);
+  const size_t result = ZSTD_decompress(out.data(), out.size(), in.data() + sizeof(header), in.size() - sizeof(header));
+  if (ZSTD_isError(result) || result != out.size()) {
+    umbra::umbra_fail(fmt::format("VFSFS: decompression failed for '{}'", virtual_path));
+  }
+
+  return out;
+}
+
+umbra::VFSFSMount::VFSFSMount(const std::filesystem::path &directory, const vfs::permissions::VFSPermission permissions, const bool compress) : IVFSMount(permissions) {
   directory_ = directory;
+  compress_ = compress;
 
   create_directories(directory_);
 }
@@ -17,7 +61,7 @@ bool umbra::VFSFSMount::exists_s(const std::string_view virtual_path) const {
 }
 
 std::vector<uint8_t> umbra::VFSFSMount::read_s(const std::string_view virtual_path) const {
-  std::ifstream file(directory_ / virtual_path);
+  std::ifstream file(directory_ / virtual_path, std::ios::binary);
   if (!file.is_open()) {
     umbra_fail("VFSFS: could not open file '"s + std::string(virtual_path) + "'");
   }
@@ -28,6 +72,11 @@ std::vector<uint8_t> umbra::VFSFSMount::read_s(const std::string_view virtual_pa
   file.read(reinterpret_cast<char*>(data.data()), file_size);
 
   file.close();
+
+  if (compress_ && is_compressed(data)) {
+    return zstd_decompress(data, virtual_path);
+  }
+
   return data;
 }
 
@@ -47,24 +96,43 @@ void umbra::VFSFSMount::write_s(const std::string_view virtual_path, const std::
     umbra_fail("VFSFS: path did not resolve to an existing file");
   }
 
-  std::ofstream file(directory_ / virtual_path);
-  file.write(reinterpret_cast<char*>(const_cast<unsigned char*>(data.data())), data.size());
+  std::ofstream file(directory_ / virtual_path, std::ios::binary | std::ios::trunc);
+
+  if (compress_) {
+    const std::vector<uint8_t> compressed = zstd_compress(data);
+    file.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+  } else {
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+  }
+
   file.close();
 }
 
-void umbra::VFSFSMount::execute_s(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const {
+void umbra::VFSFSMount::execute_s(const std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const {
+  const sol::protected_function chunk = load_s(virtual_path, lua_state);
+
+  const sol::protected_function_result result = chunk();
+  if (!result.valid()) {
+    const sol::error err = result;
+    umbra_fail(fmt::format("Lua: error in script '{}': {}", virtual_path, err.what()));
+  }
+}
+
+sol::protected_function umbra::VFSFSMount::load_s(const std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const {
   if (!exists_s(virtual_path)) {
-    umbra_fail("VFSPak: path did not resolve to an existing file");
+    umbra_fail("VFSFS: path did not resolve to an existing file");
   }
 
-  std::vector<uint8_t> script_bytes = read_s(virtual_path);
-  const std::string script(script_bytes.begin(), script_bytes.end());
+  const std::vector<uint8_t> script_bytes = read_s(virtual_path);
+  const std::string_view script(reinterpret_cast<const char*>(script_bytes.data()), script_bytes.size());
 
-  const sol::protected_function_result result = lua_state->do_string(script, std::string(virtual_path), sol::load_mode::text);
+  const sol::load_result result = lua_state->load(script, std::string(virtual_path), sol::load_mode::text);
   if (!result.valid()) {
     const sol::error err = result;
     umbra_fail(fmt::format("Lua: error in script '{}': {}", virtual_path, err.what()));
   }
+
+  return result.get<sol::protected_function>();
 }
 
 void umbra::VFSFSMount::create_s(const std::string_view virtual_path) const {
@@ -87,3 +155,18 @@ void umbra::VFSFSMount::remove_s(const std::string_view virtual_path) const {
 
   std::filesystem::remove(directory_ / virtual_path);
 }
+
+uint64_t umbra::VFSFSMount::fingerprint_s(const std::string_view virtual_path) const {
+  std::error_code ec;
+  const auto write_time = std::filesystem::last_write_time(directory_ / virtual_path, ec);
+  if (ec) {
+    return 0;
+  }
+
+  const uint64_t size = std::filesystem::file_size(directory_ / virtual_path, ec);
+  const auto ticks = static_cast<uint64_t>(write_time.time_since_epoch().count());
+
+  uint64_t hash = vfs::hash_bytes(reinterpret_cast<const uint8_t*>(&ticks), sizeof(ticks));
+  hash = vfs::hash_bytes(reinterpret_cast<const uint8_t*>(&size), sizeof(size), hash);
+  return hash;
+}
@@ -2,8 +2,9 @@
 
 #include <fmt/format.h>
 
-umbra::VFSPakMount::VFSPakMount(const std::filesystem::path &pak_path, const std::vector<uint8_t> &secret, const vfs::permissions::VFSPermission permissions) : IVFSMount(permissions) {
+umbra::VFSPakMount::VFSPakMount(const std::filesystem::path &pak_path, const std::vector<uint8_t> &secret, const vfs::permissions::VFSPermission permissions, const size_t cache_budget) : IVFSMount(permissions) {
   reader_ = std::make_unique<PakReader>(pak_path, secret);
+  reader_->set_cache_budget(cache_budget);
   all_ = reader_->list();
   std::ranges::sort(all_);
 }
@@ -39,19 +40,32 @@ void umbra::VFSPakMount::write_s(std::string_view virtual_path, const std::vecto
   umbra_fail("VFSPak: pak mounts do not support write");
 }
 
-void umbra::VFSPakMount::execute_s(std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const {
+void umbra::VFSPakMount::execute_s(const std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const {
+  const sol::protected_function chunk = load_s(virtual_path, lua_state);
+
+  const sol::protected_function_result result = chunk();
+  if (!result.valid()) {
+    const sol::error err = result;
+    umbra_fail(fmt::format("Lua: error in script '{}': {}", virtual_path, err.what()));
+  }
+}
+
+sol::protected_function umbra::VFSPakMount::load_s(const std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const {
   if (!exists_s(virtual_path)) {
     umbra_fail("VFSPak: path did not resolve to an existing file");
   }
 
-  std::vector<uint8_t> script_bytes = read_s(virtual_path);
-  const std::string script(script_bytes.begin(), script_bytes.end());
+  const std::vector<uint8_t> script_bytes = read_s(virtual_path);
+  const std::string_view script(reinterpret_cast<const char*>(script_bytes.data()), script_bytes.size());
 
-  const sol::protected_function_result result = lua_state->do_string(script, std::string(virtual_path), sol::load_mode::text);
+  // Pak contents are authenticated, so precompiled bytecode from the CLI is accepted alongside source.
+  const sol::load_result result = lua_state->load(script, std::string(virtual_path), sol::load_mode::any);
   if (!result.valid()) {
     const sol::error err = result;
     umbra_fail(fmt::format("Lua: error in script '{}': {}", virtual_path, err.what()));
   }
+
+  return result.get<sol::protected_function>();
 }
 
 void umbra::VFSPakMount::create_s(std::string_view virtual_path) const {
@@ -61,3 +75,7 @@ void umbra::VFSPakMount::create_s(std::string_view virtual_path) const {
 void umbra::VFSPakMount::remove_s(std::string_view virtual_path) const {
   umbra_fail("VFSPak: pak mounts do not support remove");
 }
+
+uint64_t umbra::VFSPakMount::fingerprint_s(const std::string_view virtual_path) const {
+  return reader_->fingerprint(std::string(virtual_path));
+}
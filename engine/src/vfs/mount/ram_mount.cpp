@@ -0,0 +1,134 @@
+#include "Umbra/mounts/ram_mount.hpp"
+#include "Umbra/umbra.hpp"
+
+#include <algorithm>
+#include <fmt/format.h>
+
+using namespace std::string_literals;
+
+static std::pmr::pool_options ram_pool_options() {
+  std::pmr::pool_options options;
+  options.max_blocks_per_chunk = 256;
+  options.largest_required_pool_block = 64 * 1024;
+  return options;
+}
+
+umbra::VFSRamMount::VFSRamMount(const size_t capacity, const vfs::permissions::VFSPermission permissions)
+  : IVFSMount(permissions), capacity_(capacity), pool_(ram_pool_options()), files_(&pool_) {}
+
+size_t umbra::VFSRamMount::used() const {
+  std::lock_guard lock(mutex_);
+  return used_;
+}
+
+bool umbra::VFSRamMount::exists_s(const std::string_view virtual_path) const {
+  std::lock_guard lock(mutex_);
+  return files_.contains(std::pmr::string(virtual_path, &pool_));
+}
+
+std::vector<uint8_t> umbra::VFSRamMount::read_s(const std::string_view virtual_path) const {
+  std::lock_guard lock(mutex_);
+
+  const auto it = files_.find(std::pmr::string(virtual_path, &pool_));
+  if (it == files_.end()) {
+    umbra_fail("VFSRam: could not open file '"s + std::string(virtual_path) + "'");
+  }
+
+  return std::vector<uint8_t>(it->second.bytes.begin(), it->second.bytes.end());
+}
+
+std::vector<std::string> umbra::VFSRamMount::list_s(const std::string_view virtual_path) const {
+  std::lock_guard lock(mutex_);
+
+  auto directory = std::string(virtual_path);
+  if (!directory.empty() && directory.back() != '/') {
+    directory.push_back('/');
+  }
+
+  std::vector<std::string> out;
+  for (const auto& [path, _] : files_) {
+    if (path.starts_with(directory)) {
+      out.emplace_back(path);
+    }
+  }
+
+  std::ranges::sort(out);
+  return out;
+}
+
+void umbra::VFSRamMount::write_s(const std::string_view virtual_path, const std::vector<uint8_t>& data) const {
+  std::lock_guard lock(mutex_);
+
+  const auto it = files_.find(std::pmr::string(virtual_path, &pool_));
+  if (it == files_.end()) {
+    umbra_fail("VFSRam: path did not resolve to an existing file");
+  }
+
+  const size_t after = used_ - it->second.bytes.size() + data.size();
+  if (after > capacity_) {
+    umbra_fail(fmt::format("VFSRam: writing '{}' would exceed the {} byte capacity", virtual_path, capacity_));
+  }
+
+  it->second.bytes.assign(data.begin(), data.end());
+  it->second.bytes.shrink_to_fit();
+  it->second.fingerprint = vfs::hash_bytes(data.data(), data.size());
+  used_ = after;
+}
+
+void umbra::VFSRamMount::execute_s(const std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const {
+  const sol::protected_function chunk = load_s(virtual_path, lua_state);
+
+  const sol::protected_function_result result = chunk();
+  if (!result.valid()) {
+    const sol::error err = result;
+    umbra_fail(fmt::format("Lua: error in script '{}': {}", virtual_path, err.what()));
+  }
+}
+
+sol::protected_function umbra::VFSRamMount::load_s(const std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const {
+  const std::vector<uint8_t> script_bytes = read_s(virtual_path);
+  const std::string_view script(reinterpret_cast<const char*>(script_bytes.data()), script_bytes.size());
+
+  const sol::load_result result = lua_state->load(script, std::string(virtual_path), sol::load_mode::text);
+  if (!result.valid()) {
+    const sol::error err = result;
+    umbra_fail(fmt::format("Lua: error in script '{}': {}", virtual_path, err.what()));
+  }
+
+  return result.get<sol::protected_function>();
+}
+
+void umbra::VFSRamMount::create_s(const std::string_view virtual_path) const {
+  std::lock_guard lock(mutex_);
+
+  std::pmr::string path(virtual_path, &pool_);
+  if (files_.contains(path)) {
+    umbra_fail("VFSRam: a file already exists at the path '"s + std::string(virtual_path) + "'");
+  }
+
+  if (used_ + path.size() > capacity_) {
+    umbra_fail(fmt::format("VFSRam: creating '{}' would exceed the {} byte capacity", virtual_path, capacity_));
+  }
+
+  used_ += path.size();
+  files_.emplace(std::move(path), RamFile{ std::pmr::vector<uint8_t>(&pool_), vfs::hash_bytes(nullptr, 0) });
+}
+
+void umbra::VFSRamMount::remove_s(const std::string_view virtual_path) const {
+  std::lock_guard lock(mutex_);
+
+  const auto it = files_.find(std::pmr::string(virtual_path, &pool_));
+  if (it == files_.end()) {
+    umbra_fail("VFSRam: path did not resolve to an existing file");
+  }
+
+  used_ -= it->first.size() + it->second.bytes.size();
+  files_.erase(it);
+}
+
+uint64_t umbra::VFSRamMount::fingerprint_s(const std::string_view virtual_path) const {
+  std::lock_guard lock(mutex_);
+
+  const auto it = files_.find(std::pmr::string(virtual_path, &pool_));
+  return it == files_.end() ? 0 : it->second.fingerprint;
+}
@@ -1,6 +1,8 @@
 #include "Umbra/vfs.hpp"
 #include "Umbra/umbra.hpp"
 
+#include <fmt/format.h>
+
 umbra::IVFSMount::IVFSMount(const vfs::permissions::VFSPermission permissions) {
   permissions_ = permissions;
 }
@@ -45,6 +47,18 @@ void umbra::IVFSMount::execute(const std::string_view virtual_path, const std::s
   execute_s(virtual_path, lua_state);
 }
 
+sol::protected_function umbra::IVFSMount::load(const std::string_view virtual_path, const std::shared_ptr<sol::state>& lua_state) const {
+  if (!has_all_permissions(permissions(), vfs::permissions::EXECUTE)) {
+    umbra_fail("VFS: insufficient execute permissions");
+  }
+
+  return load_s(virtual_path, lua_state);
+}
+
+uint64_t umbra::IVFSMount::fingerprint(const std::string_view virtual_path) const {
+  return fingerprint_s(virtual_path);
+}
+
 void umbra::IVFSMount::create(const std::string_view virtual_path) const {
   if (!has_all_permissions(permissions(), vfs::permissions::CREATE)) {
     umbra_fail("VFS: insufficient create permissions");
@@ -68,11 +82,18 @@ void umbra::VFS::mount(std::string prefix, std::unique_ptr<IVFSMount> mount) {
     umbra_fail("VFS: mount prefix must end with '://'");
   }
 
+  if (const auto it = mounts_.find(prefix); it != mounts_.end()) {
+    chunk_cache_.erase(it->second.get());
+  }
+
   mounts_[std::move(prefix)] = std::move(mount);
 }
 
 void umbra::VFS::unmount(const std::string_view prefix) noexcept {
-  mounts_.erase(std::string(prefix));
+  if (const auto it = mounts_.find(std::string(prefix)); it != mounts_.end()) {
+    chunk_cache_.erase(it->second.get());
+    mounts_.erase(it);
+  }
 }
 
 bool umbra::VFS::exists(const std::string_view virtual_path) const noexcept {
@@ -104,7 +125,8 @@ void umbra::VFS::create(const std::string_view virtual_path) const {
     umbra_fail("VFS: mount not found");
   }
 
-  return mount->create(sub);
+  mount->create(sub);
+  invalidate(virtual_path);
 }
 
 void umbra::VFS::remove(const std::string_view virtual_path) const {
@@ -113,7 +135,8 @@ void umbra::VFS::remove(const std::string_view virtual_path) const {
     umbra_fail("VFS: mount not found");
   }
 
-  return mount->remove(sub);
+  mount->remove(sub);
+  invalidate(virtual_path);
 }
 
 
@@ -124,15 +147,51 @@ void umbra::VFS::write(const std::string_view virtual_path, const std::vector<ui
   }
 
   mount->write(sub, data);
+  invalidate(virtual_path);
 }
 
 void umbra::VFS::execute(const std::string_view virtual_path) const {
+  const sol::protected_function chunk = load(virtual_path);
+
+  const sol::protected_function_result result = chunk();
+  if (!result.valid()) {
+    const sol::error err = result;
+    umbra_fail(fmt::format("Lua: error in script '{}': {}", virtual_path, err.what()));
+  }
+}
+
+sol::protected_function umbra::VFS::load(const std::string_view virtual_path) const {
   auto [mount, sub] = route(virtual_path);
   if (!mount) {
     umbra_fail("VFS: mount not found");
   }
 
-  return mount->execute(sub, lua_state_);
+  const uint64_t fingerprint = mount->fingerprint(sub);
+
+  std::unordered_map<std::string, CachedChunk>& mount_cache = chunk_cache_[mount];
+  if (const auto it = mount_cache.find(sub); it != mount_cache.end() && it->second.fingerprint == fingerprint) {
+    return it->second.chunk;
+  }
+
+  sol::protected_function chunk = mount->load(sub, lua_state_);
+  mount_cache.insert_or_assign(std::move(sub), CachedChunk{ fingerprint, chunk });
+
+  return chunk;
+}
+
+void umbra::VFS::invalidate(const std::string_view virtual_path) const noexcept {
+  auto [mount, sub] = route(virtual_path);
+  if (!mount) {
+    return;
+  }
+
+  if (const auto it = chunk_cache_.find(mount); it != chunk_cache_.end()) {
+    it->second.erase(sub);
+  }
+}
+
+void umbra::VFS::invalidate_all() const noexcept {
+  chunk_cache_.clear();
 }
 
 std::pair<const umbra::IVFSMount *, std::string> umbra::VFS::route(const std::string_view virtual_path) const noexcept {
@@ -160,3 +219,10 @@ bool umbra::VFS::has_permission(const std::string_view mount_prefix, const vfs::
 
   return has_all_permissions(mount->permissions(), permission);
 }
+
+std::shared_ptr<umbra::VFS> umbra::VFS::fork(const std::shared_ptr<sol::state>& lua_state) const {
+  auto forked = std::make_shared<VFS>(lua_state);
+  forked->mounts_ = mounts_;
+
+  return forked;
+}
@@ -0,0 +1,421 @@
+#include "Umbra/worker.hpp"
+
+#include "Umbra/builtins.hpp"
+#include "Umbra/builtins/require.hpp"
+#include "Umbra/types.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <fmt/format.h>
+
+namespace {
+  enum MessageTag : uint8_t {
+    TAG_NIL = 0,
+    TAG_FALSE = 1,
+    TAG_TRUE = 2,
+    TAG_INTEGER = 3,
+    TAG_NUMBER = 4,
+    TAG_STRING = 5,
+    TAG_TABLE = 6
+  };
+
+  // Deep enough for real data, shallow enough to turn a cyclic table into an error instead of a stack overflow
+  constexpr int MAX_DEPTH = 64;
+
+  // How many VM instructions run between checks for a terminate request
+  constexpr int INTERRUPT_INTERVAL = 10000;
+
+  template<class T>
+  void append(umbra::WorkerMessage& out, const T value) {
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+  }
+
+  template<class T>
+  T consume(const umbra::WorkerMessage& message, size_t& cursor) {
+    if (message.size() - cursor < sizeof(T)) {
+      umbra::umbra_fail("Worker: corrupt message");
+    }
+
+    T value;
+    std::memcpy(&value, message.data() + cursor, sizeof(T));
+    cursor += sizeof(T);
+
+    return value;
+  }
+
+  void pack_value(lua_State* L, int index, umbra::WorkerMessage& out, const int depth) {
+    index = lua_absindex(L, index);
+
+    switch (lua_type(L, index)) {
+      case LUA_TNIL:
+        out.push_back(TAG_NIL);
+        break;
+      case LUA_TBOOLEAN:
+        out.push_back(lua_toboolean(L, index) ? TAG_TRUE : TAG_FALSE);
+        break;
+      case LUA_TNUMBER:
+        if (lua_isinteger(L, index)) {
+          out.push_back(TAG_INTEGER);
+          append<int64_t>(out, lua_tointeger(L, index));
+        } else {
+          out.push_back(TAG_NUMBER);
+          append<double>(out, lua_tonumber(L, index));
+        }
+        break;
+      case LUA_TSTRING: {
+        size_t length = 0;
+        const char* data = lua_tolstring(L, index, &length);
+
+        out.push_back(TAG_STRING);
+        append<uint64_t>(out, length);
+        out.insert(out.end(), data, data + length);
+        break;
+      }
+      case LUA_TTABLE: {
+        if (depth >= MAX_DEPTH) {
+          umbra::umbra_fail("Worker: table nested too deeply to send (is it cyclic?)");
+        }
+
+        if (!lua_checkstack(L, 3)) {
+          umbra::umbra_fail("Worker: out of stack space while packing a message");
+        }
+
+        out.push_back(TAG_TABLE);
+
+        const size_t count_offset = out.size();
+        append<uint32_t>(out, 0);
+
+        uint32_t count = 0;
+        lua_pushnil(L);
+        while (lua_next(L, index) != 0) {
+          pack_value(L, -2, out, depth + 1);
+          pack_value(L, -1, out, depth + 1);
+          lua_pop(L, 1);
+          ++count;
+        }
+
+        std::memcpy(out.data() + count_offset, &count, sizeof(count));
+        break;
+      }
+      default:
+        umbra::umbra_fail(fmt::format("Worker: cannot send a value of type '{}'", luaL_typename(L, index)));
+    }
+  }
+
+  void unpack_value(lua_State* L, const umbra::WorkerMessage& message, size_t& cursor, const int depth) {
+    if (depth >= MAX_DEPTH || !lua_checkstack(L, 3)) {
+      umbra::umbra_fail("Worker: corrupt message");
+    }
+
+    switch (consume<uint8_t>(message, cursor)) {
+      case TAG_NIL:
+        lua_pushnil(L);
+        break;
+      case TAG_FALSE:
+        lua_pushboolean(L, 0);
+        break;
+      case TAG_TRUE:
+        lua_pushboolean(L, 1);
+        break;
+      case TAG_INTEGER:
+        lua_pushinteger(L, consume<int64_t>(message, cursor));
+        break;
+      case TAG_NUMBER:
+        lua_pushnumber(L, consume<double>(message, cursor));
+        break;
+      case TAG_STRING: {
+        const auto length = consume<uint64_t>(message, cursor);
+        if (message.size() - cursor < length) {
+          umbra::umbra_fail("Worker: corrupt message");
+        }
+
+        lua_pushlstring(L, reinterpret_cast<const char*>(message.data() + cursor), length);
+        cursor += length;
+        break;
+      }
+      case TAG_TABLE: {
+        const auto count = consume<uint32_t>(message, cursor);
+
+        lua_createtable(L, 0, static_cast<int>(std::min<uint32_t>(count, 1024)));
+        for (uint32_t i = 0; i < count; ++i) {
+          unpack_value(L, message, cursor, depth + 1);
+          unpack_value(L, message, cursor, depth + 1);
+          lua_rawset(L, -3);
+        }
+        break;
+      }
+      default:
+        umbra::umbra_fail("Worker: corrupt message");
+    }
+  }
+}
+
+bool umbra::MessageChannel::push(WorkerMessage&& message) {
+  {
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+      return false;
+    }
+
+    queue_.push_back(std::move(message));
+  }
+
+  available_.notify_one();
+  return true;
+}
+
+std::optional<umbra::WorkerMessage> umbra::MessageChannel::try_pop() {
+  std::lock_guard lock(mutex_);
+  if (queue_.empty()) {
+    return std::nullopt;
+  }
+
+  WorkerMessage message = std::move(queue_.front());
+  queue_.pop_front();
+
+  return message;
+}
+
+std::optional<umbra::WorkerMessage> umbra::MessageChannel::pop(const std::optional<std::chrono::milliseconds> timeout) {
+  std::unique_lock lock(mutex_);
+
+  const auto ready = [this] { return !queue_.empty() || closed_; };
+  if (timeout) {
+    available_.wait_for(lock, *timeout, ready);
+  } else {
+    available_.wait(lock, ready);
+  }
+
+  if (queue_.empty()) {
+    return std::nullopt;
+  }
+
+  WorkerMessage message = std::move(queue_.front());
+  queue_.pop_front();
+
+  return message;
+}
+
+void umbra::MessageChannel::close() {
+  {
+    std::lock_guard lock(mutex_);
+    closed_ = true;
+  }
+
+  available_.notify_all();
+}
+
+bool umbra::MessageChannel::closed() const {
+  std::lock_guard lock(mutex_);
+  return closed_;
+}
+
+size_t umbra::MessageChannel::size() const {
+  std::lock_guard lock(mutex_);
+  return queue_.size();
+}
+
+umbra::Worker::Worker(const VFS& vfs, std::string virtual_path, WorkerMessage arguments) : path_(std::move(virtual_path)), arguments_(std::move(arguments)) {
+  allocator_ = std::make_shared<LuaAllocator>();
+  lua_state_ = std::shared_ptr<sol::state>(
+    new sol::state(sol::default_at_panic, &LuaAllocator::allocate, allocator_.get()),
+    [allocator = allocator_](const sol::state* lua_state) { delete lua_state; }
+  );
+
+  // Forking reads the main VFS's mount table, so it has to happen here on the spawning thread
+  vfs_ = vfs.fork(lua_state_);
+
+  thread_ = std::thread(&Worker::run, this);
+}
+
+umbra::Worker::~Worker() {
+  terminate();
+  join();
+}
+
+umbra::WorkerMessage umbra::Worker::pack(lua_State* L, const int first, const int count) {
+  WorkerMessage message;
+  append<uint32_t>(message, static_cast<uint32_t>(count));
+
+  for (int i = 0; i < count; ++i) {
+    pack_value(L, first + i, message, 0);
+  }
+
+  return message;
+}
+
+int umbra::Worker::unpack(lua_State* L, const WorkerMessage& message) {
+  size_t cursor = 0;
+  const auto count = consume<uint32_t>(message, cursor);
+
+  if (!lua_checkstack(L, static_cast<int>(std::min<uint32_t>(count, 1u << 16)) + 3)) {
+    umbra_fail("Worker: message has too many values");
+  }
+
+  for (uint32_t i = 0; i < count; ++i) {
+    unpack_value(L, message, cursor, 0);
+  }
+
+  return static_cast<int>(count);
+}
+
+void umbra::Worker::send(const sol::variadic_args& args, const sol::this_state this_state) {
+  if (!inbox_.push(pack(this_state, args.stack_index(), static_cast<int>(args.size())))) {
+    umbra_fail("Worker: cannot send to a worker that has stopped");
+  }
+}
+
+sol::variadic_results umbra::Worker::receive(const sol::this_state this_state) {
+  sol::variadic_results results;
+
+  const std::optional<WorkerMessage> message = outbox_.try_pop();
+  if (!message) {
+    return results;
+  }
+
+  lua_State* L = this_state;
+  const int count = unpack(L, *message);
+  const int first = lua_gettop(L) - count + 1;
+
+  for (int i = 0; i < count; ++i) {
+    results.push_back(sol::object(L, first + i));
+  }
+  lua_pop(L, count);
+
+  return results;
+}
+
+size_t umbra::Worker::pending() const {
+  return outbox_.size();
+}
+
+bool umbra::Worker::is_running() const {
+  return running_.load();
+}
+
+sol::optional<std::string> umbra::Worker::get_error() const {
+  std::lock_guard lock(error_mutex_);
+  if (!error_) {
+    return sol::nullopt;
+  }
+
+  return *error_;
+}
+
+void umbra::Worker::terminate() {
+  stop_requested_.store(true);
+  inbox_.close();
+}
+
+void umbra::Worker::join() {
+  if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+    thread_.join();
+  }
+}
+
+void umbra::Worker::run() {
+  try {
+    sol::state& lua = *lua_state_;
+    lua.open_libraries(sol::lib::base, sol::lib::bit32, sol::lib::coroutine, sol::lib::math, sol::lib::string, sol::lib::table);
+
+    { // Register Builtins
+      BuiltinRegistry builtin_registry(lua_state_);
+      builtin_registry.register_builtin<RequireBuiltin>("require", vfs_);
+    }
+
+    { // Register Types
+      TypeRegistry type_registry(lua_state_);
+
+      register_builtin_types(type_registry);
+    }
+
+    bind_worker_global();
+
+    lua_State* L = lua.lua_state();
+
+    *static_cast<Worker**>(lua_getextraspace(L)) = this;
+    lua_sethook(L, &Worker::interrupt_hook, LUA_MASKCOUNT, INTERRUPT_INTERVAL);
+
+    const sol::protected_function chunk = vfs_->load(path_);
+
+    chunk.push();
+    const int argument_count = unpack(L, arguments_);
+
+    if (lua_pcall(L, argument_count, 0, 0) != LUA_OK) {
+      const char* message = lua_tostring(L, -1);
+      const std::string error = message ? message : "(error object is not a string)";
+      lua_pop(L, 1);
+
+      if (!stop_requested_.load()) {
+        umbra_fail(fmt::format("Worker: error in '{}': {}", path_, error));
+      }
+    }
+  } catch (const std::exception& e) {
+    std::lock_guard lock(error_mutex_);
+    error_ = e.what();
+  }
+
+  outbox_.close();
+
+  // Release the state from the thread that used it; nothing else touches these after construction
+  vfs_.reset();
+  lua_state_.reset();
+
+  running_.store(false);
+}
+
+void umbra::Worker::bind_worker_global() {
+  sol::state& lua = *lua_state_;
+  sol::table worker = lua.create_named_table("worker");
+
+  worker["path"] = path_;
+
+  worker.set_function("send", [this](const sol::variadic_args& args, const sol::this_state this_state) {
+    if (!outbox_.push(pack(this_state, args.stack_index(), static_cast<int>(args.size())))) {
+      umbra_fail("Worker: outbox is closed");
+    }
+  });
+
+  // Blocks until a message arrives. Returns nothing once the worker is asked to stop or the timeout passes.
+  worker.set_function("receive", [this](const sol::optional<double> timeout_seconds, const sol::this_state this_state) -> sol::variadic_results {
+    std::optional<std::chrono::milliseconds> timeout;
+    if (timeout_seconds) {
+      timeout = std::chrono::milliseconds(static_cast<int64_t>(std::max(0.0, *timeout_seconds) * 1000.0));
+    }
+
+    sol::variadic_results results;
+
+    const std::optional<WorkerMessage> message = inbox_.pop(timeout);
+    if (!message) {
+      return results;
+    }
+
+    lua_State* L = this_state;
+    const int count = unpack(L, *message);
+    const int first = lua_gettop(L) - count + 1;
+
+    for (int i = 0; i < count; ++i) {
+      results.push_back(sol::object(L, first + i));
+    }
+    lua_pop(L, count);
+
+    return results;
+  });
+
+  worker.set_function("pending", [this]() -> size_t {
+    return inbox_.size();
+  });
+
+  worker.set_function("should_stop", [this]() -> bool {
+    return stop_requested_.load();
+  });
+}
+
+void umbra::Worker::interrupt_hook(lua_State* L, lua_Debug*) {
+  const Worker* self = *static_cast<Worker**>(lua_getextraspace(L));
+  if (self && self->stop_requested_.load()) {
+    luaL_error(L, "Worker: terminated");
+  }
+}
@@ -4,10 +4,10 @@ local vfs = umbra.get_service("VirtualFileSystem")
 local icon = vfs:read("assets://window_icon.png")
 renderer:set_icon(icon)
 
-while not renderer:should_close() do
-    renderer:begin_render()
-
+umbra.on_update(function(dt)
     -- here is where the game begins
+end)
+
+umbra.on_render(function(alpha, frame_time)
 
-    renderer:end_render()
-end
\ No newline at end of file
+end)
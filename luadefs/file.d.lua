@@ -10,4 +10,81 @@ function File:size() end
 
 ---The contents of the file as a string
 ---@return string
-function File:as_string() end
\ No newline at end of file
+function File:as_string() end
+
+---Reads an unsigned 8-bit integer at the 1-based byte offset.
+---@param offset number
+---@return number|nil
+function File:read_u8(offset) end
+
+---Reads a signed 8-bit integer at the 1-based byte offset.
+---@param offset number
+---@return number|nil
+function File:read_i8(offset) end
+
+---Reads an unsigned 16-bit integer at the 1-based byte offset.
+---@param offset number
+---@param big_endian boolean|nil # defaults to little endian
+---@return number|nil
+function File:read_u16(offset, big_endian) end
+
+---Reads a signed 16-bit integer at the 1-based byte offset.
+---@param offset number
+---@param big_endian boolean|nil # defaults to little endian
+---@return number|nil
+function File:read_i16(offset, big_endian) end
+
+---Reads an unsigned 32-bit integer at the 1-based byte offset.
+---@param offset number
+---@param big_endian boolean|nil # defaults to little endian
+---@return number|nil
+function File:read_u32(offset, big_endian) end
+
+---Reads a signed 32-bit integer at the 1-based byte offset.
+---@param offset number
+---@param big_endian boolean|nil # defaults to little endian
+---@return number|nil
+function File:read_i32(offset, big_endian) end
+
+---Reads a signed 64-bit integer at the 1-based byte offset.
+---@param offset number
+---@param big_endian boolean|nil # defaults to little endian
+---@return number|nil
+function File:read_i64(offset, big_endian) end
+
+---Reads a 32-bit float at the 1-based byte offset.
+---@param offset number
+---@param big_endian boolean|nil # defaults to little endian
+---@return number|nil
+function File:read_f32(offset, big_endian) end
+
+---Reads a 64-bit float at the 1-based byte offset.
+---@param offset number
+---@param big_endian boolean|nil # defaults to little endian
+---@return number|nil
+function File:read_f64(offset, big_endian) end
+
+---Reads `length` bytes at the 1-based byte offset as a string.
+---@param offset number
+---@param length number
+---@return string|nil
+function File:read_string(offset, length) end
+
+---Decodes `count` consecutive values into an owned typed array: u8 into a UInt8Array; i8, u16, i16 and i32
+---into an Int32Array; f32 into a Float32Array; u32 and f64 into a Float64Array. i64 decodes into a
+---sequential table of integers, since no typed array holds every i64 exactly.
+---@param type "u8"|"i8"|"u16"|"i16"|"u32"|"i32"|"i64"|"f32"|"f64"
+---@param offset number
+---@param count number
+---@param big_endian boolean|nil # defaults to little endian
+---@return UInt8Array|Int32Array|Float32Array|Float64Array|integer[]
+function File:read_array(type, offset, count, big_endian) end
+
+---Unpacks values using a string.unpack format, without copying the file into a string.
+---Returns the unpacked values followed by the position of the first unread byte.
+---@param format string
+---@param offset number|nil # 1-based, defaults to 1
+---@return any ...
+function File:unpack(format, offset) end
+
+---@operator len(): number
@@ -4,7 +4,7 @@
 ---@class umbra : userdata
 umbra = {}
 
----@alias ServiceNames "Renderer"
+---@alias ServiceNames "Renderer"|"VirtualFileSystem"|"GarbageCollector"|"Scheduler"|"Workers"|"Profiler"
 
 ---@generic T : ServiceNames
 ---@param service_name T
@@ -17,4 +17,21 @@ function umbra.get_service(service_name)
     return nil
 end
 
-local test = umbra.get_service("Renderer")
\ No newline at end of file
+local test = umbra.get_service("Renderer")
+
+---Sets the function the engine loop calls at a fixed rate (fixed_update_hz in umbra.toml) to advance the
+---simulation. `dt` is always the fixed step in seconds. Passing nil removes the callback.
+---@param callback fun(dt: number)|nil
+function umbra.on_update(callback) end
+
+---Sets the function the engine loop calls once per rendered frame. `alpha` in [0, 1) is how far the current
+---time is between the last two updates, for interpolating what is drawn; `frame_time` is the real time since
+---the previous frame in seconds. Passing nil removes the callback.
+---@param callback fun(alpha: number, frame_time: number)|nil
+function umbra.on_render(callback) end
+
+---Loads a module from src:// through the virtual file system. "a.b" resolves to "src://a/b.lua" or
+---"src://a/b/init.lua". Each module runs once; later calls return the cached result.
+---@param module_name string
+---@return any
+function require(module_name) end
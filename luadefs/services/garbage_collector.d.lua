@@ -0,0 +1,73 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class GarbageCollector : userdata
+GarbageCollector = {}
+
+---Switches the collector to generational mode. Omitted or 0 parameters keep their current value.
+---@param minor_multiplier integer|nil
+---@param major_multiplier integer|nil
+function GarbageCollector:set_generational(minor_multiplier, major_multiplier) end
+
+---Switches the collector to incremental mode. Omitted or 0 parameters keep their current value.
+---@param pause integer|nil
+---@param step_multiplier integer|nil
+---@param step_size integer|nil
+function GarbageCollector:set_incremental(pause, step_multiplier, step_size) end
+
+---Gets the current collector mode.
+---@return "incremental"|"generational"
+function GarbageCollector:mode() end
+
+---Runs a full collection cycle.
+function GarbageCollector:collect() end
+
+---Runs a single collector step. Returns true when the step finished a cycle.
+---@param size_kb integer|nil
+---@return boolean
+function GarbageCollector:step(size_kb) end
+
+---Stops automatic collection. Per-frame steps are also skipped while stopped.
+function GarbageCollector:stop() end
+
+---Restarts automatic collection.
+function GarbageCollector:restart() end
+
+---Returns whether automatic collection is running.
+---@return boolean
+function GarbageCollector:is_running() end
+
+---Gets the Lua heap size in kilobytes.
+---@return number
+function GarbageCollector:count() end
+
+---Sets the most time, in milliseconds, the collector may use at the end of each frame.
+---@param budget_ms number
+function GarbageCollector:set_frame_budget(budget_ms) end
+
+---Gets the per-frame collector budget in milliseconds.
+---@return number
+function GarbageCollector:get_frame_budget() end
+
+---Gets how long, in milliseconds, the last per-frame step took.
+---@return number
+function GarbageCollector:get_last_step_time() end
+
+---Runs collector steps for up to available_ms, capped by the frame budget. Renderer:end_render calls this
+---with the time left in the frame.
+---@param available_ms number
+function GarbageCollector:step_frame(available_ms) end
+
+---@class AllocationStats
+---@field live_bytes integer Bytes currently allocated by Lua
+---@field peak_bytes integer Highest live_bytes seen
+---@field pool_bytes integer Bytes reserved for small-block pools
+---@field allocations integer Total allocations
+---@field frees integer Total frees
+---@field allocated_bytes integer Total bytes ever allocated
+---@field allocations_per_second number Allocation rate over the last sampling window
+---@field bytes_per_second number Allocated bytes per second over the last sampling window
+
+---Gets counters from the engine's Lua allocator. Rates update about twice a second while frames are rendered.
+---@return AllocationStats
+function GarbageCollector:get_allocation_stats() end
@@ -0,0 +1,32 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---Samples Lua call stacks and writes them as collapsed stacks for flame graph tools. Passing --profile or
+-----profile=data://path.folded on the command line profiles the whole run.
+---@class Profiler : userdata
+Profiler = {}
+
+---Starts sampling every `interval` VM instructions (default 1000). Coroutines created before this call are
+---not sampled.
+---@param interval integer|nil
+function Profiler:start(interval) end
+
+---Stops sampling. Collected samples are kept until reset.
+function Profiler:stop() end
+
+---Returns whether the profiler is sampling.
+---@return boolean
+function Profiler:is_running() end
+
+---Discards all collected samples.
+function Profiler:reset() end
+
+---Gets the number of samples collected.
+---@return integer
+function Profiler:get_sample_count() end
+
+---Writes time-weighted stacks (microseconds) to the virtual path and allocation-weighted stacks (bytes) next
+---to it with an ".alloc" suffix. Returns the path written.
+---@param virtual_path string|nil defaults to "data://profile.folded"
+---@return string
+function Profiler:save(virtual_path) end
@@ -31,3 +31,11 @@ function Renderer:get_size() end
 ---@param new_position Vector2
 function Renderer:move(new_position) end
 
+
+---Returns whether the window is minimised.
+---@return boolean
+function Renderer:is_iconified() end
+
+---Returns whether the window has input focus.
+---@return boolean
+function Renderer:is_focused() end
@@ -0,0 +1,54 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class Scheduler : userdata
+Scheduler = {}
+
+---Starts fn(...) as a task. The task runs immediately until it first waits. Errors inside a task are
+---reported and end only that task; its status becomes "error" until the message is read with get_error.
+---@param fn function
+---@param ... any
+---@return integer handle
+function Scheduler:spawn(fn, ...) end
+
+---Stops a task so it is never resumed again. Returns false if the task already finished.
+---@param handle integer
+---@return boolean
+function Scheduler:cancel(handle) end
+
+---Gets a task's status.
+---@param handle integer
+---@return "running"|"waiting"|"error"|"dead"
+function Scheduler:status(handle) end
+
+---Gets the error and traceback of a task that failed, or nil. Reading it clears the error, after which
+---the task's status is "dead".
+---@param handle integer
+---@return string|nil
+function Scheduler:get_error(handle) end
+
+---Gets the number of live tasks.
+---@return integer
+function Scheduler:count() end
+
+---Gets the number of frames the scheduler has ticked.
+---@return integer
+function Scheduler:get_frame() end
+
+---Gets the scheduler clock in seconds.
+---@return number
+function Scheduler:get_time() end
+
+---Suspends the calling task for at least the given number of seconds. 0 or no value waits one frame.
+---Only valid inside a task.
+---@param seconds number|nil
+function Scheduler:wait(seconds) end
+
+---Suspends the calling task for the given number of frames (at least 1). Only valid inside a task.
+---@param count integer|nil
+function Scheduler:wait_frames(count) end
+
+---Suspends the calling task until another task finishes. Returns immediately if it already has.
+---Only valid inside a task.
+---@param handle integer
+function Scheduler:wait_for(handle) end
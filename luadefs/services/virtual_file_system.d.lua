@@ -0,0 +1,42 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class VirtualFileSystem : userdata
+VirtualFileSystem = {}
+
+---Returns whether a file exists at the virtual path.
+---@param virtual_path string
+---@return boolean
+function VirtualFileSystem:exists(virtual_path) end
+
+---Reads the file at the virtual path.
+---@param virtual_path string
+---@return File
+function VirtualFileSystem:read(virtual_path) end
+
+---Lists the files under the virtual directory.
+---@param virtual_path string
+---@return string[]
+function VirtualFileSystem:list(virtual_path) end
+
+---Creates an empty file at the virtual path.
+---@param virtual_path string
+function VirtualFileSystem:create(virtual_path) end
+
+---Removes the file at the virtual path.
+---@param virtual_path string
+function VirtualFileSystem:remove(virtual_path) end
+
+---Overwrites the file at the virtual path.
+---@param virtual_path string
+---@param data string
+function VirtualFileSystem:write(virtual_path, data) end
+
+---Executes the script at the virtual path. Compiled chunks are cached, so running a script again skips
+---reading and parsing it unless the file changed.
+---@param virtual_path string
+function VirtualFileSystem:execute(virtual_path) end
+
+---Drops the cached compiled chunk for the virtual path, or every cached chunk when no path is given.
+---@param virtual_path string|nil
+function VirtualFileSystem:invalidate(virtual_path) end
@@ -0,0 +1,77 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class Workers : userdata
+Workers = {}
+
+---Starts the script at the virtual path in a new worker lua state on its own thread. Extra arguments are
+---copied into the worker and passed to the script as `...`. Only nil, booleans, numbers, strings and tables
+---of those can cross between states.
+---@param virtual_path string
+---@param ... any
+---@return Worker
+function Workers:spawn(virtual_path, ...) end
+
+---Gets the number of workers still running.
+---@return integer
+function Workers:count() end
+
+---Gets the most workers that may run at once.
+---@return integer
+function Workers:get_limit() end
+
+---@class Worker : userdata
+Worker = {}
+
+---Copies the values into the worker's inbox.
+---@param ... any
+function Worker:send(...) end
+
+---Takes the oldest message the worker sent, or returns nothing if none is waiting. Never blocks.
+---@return any ...
+function Worker:receive() end
+
+---Gets the number of messages waiting to be received from the worker.
+---@return integer
+function Worker:pending() end
+
+---Returns whether the worker's script is still running.
+---@return boolean
+function Worker:is_running() end
+
+---Gets the error the worker stopped with, if any.
+---@return string|nil
+function Worker:get_error() end
+
+---Asks the worker to stop. A running script is interrupted shortly after.
+function Worker:terminate() end
+
+---Blocks until the worker has stopped.
+function Worker:join() end
+
+---Gets the virtual path of the worker's script.
+---@return string
+function Worker:get_path() end
+
+---Only available inside worker scripts.
+---@class worker
+---@field path string
+worker = {}
+
+---Copies the values into the spawning state's inbox for this worker.
+---@param ... any
+function worker.send(...) end
+
+---Blocks until a message arrives and returns its values. Returns nothing once the worker is asked to stop
+---or the timeout passes.
+---@param timeout_seconds number|nil
+---@return any ...
+function worker.receive(timeout_seconds) end
+
+---Gets the number of messages waiting to be received.
+---@return integer
+function worker.pending() end
+
+---Returns whether the spawning state asked this worker to stop.
+---@return boolean
+function worker.should_stop() end
@@ -0,0 +1,86 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class Deque : userdata
+Deque = {}
+
+---Creates a Deque.
+---@return Deque
+function Deque.new() end
+
+---Gets the current size of the Deque.
+---@return number
+function Deque:size() end
+
+---Gets the current capacity of the Deque.
+---@return number
+function Deque:capacity() end
+
+---Returns whether the Deque is empty or not.
+---@return boolean
+function Deque:empty() end
+
+---Removes all elements from the Deque.
+function Deque:clear() end
+
+---Reserves memory for the specified amount of objects in the Deque.
+---@param quantity number
+function Deque:reserve(quantity) end
+
+---Reduces the Deque's capacity to the quantity of objects currently stored.
+function Deque:shrink_to_fit() end
+
+---Gets the object at the specified index.
+---@param index number
+---@return any|nil
+function Deque:get(index) end
+
+---Sets the value at the specified index.
+---@param index number
+---@param value any
+function Deque:set(index, value) end
+
+---Gets the first object without removing it.
+---@return any|nil
+function Deque:front() end
+
+---Gets the last object without removing it.
+---@return any|nil
+function Deque:back() end
+
+---Adds the value at the end of the Deque.
+---@param value any
+function Deque:push_back(value) end
+
+---Adds the value at the beginning of the Deque.
+---@param value any
+function Deque:push_front(value) end
+
+---Removes the value at the beginning of the Deque and returns it.
+---@return any|nil
+function Deque:pop_front() end
+
+---Removes the value at the end of the Deque and returns it.
+---@return any|nil
+function Deque:pop_back() end
+
+---Inserts the value at the specified index.
+---@param index number
+---@param value any
+function Deque:insert(index, value) end
+
+---Erases the value at the specified index.
+---@param index number
+function Deque:erase(index) end
+
+---Creates a Deque based on the given table.
+---@param table table
+---@return Deque
+function Deque.from_table(table) end
+
+---Creates an ordered table based on the Deque.
+---@return table
+function Deque:to_table() end
+
+---@operator len(): number
+---@operator add(Deque): Deque
\ No newline at end of file
@@ -74,5 +74,41 @@ function DynamicArray.from_table(table) end
 ---@return table
 function DynamicArray:to_table() end
 
+---Sorts the DynamicArray in place, with an optional comparator that returns whether a goes before b. Without one, elements that are all numbers or all strings are sorted natively in ascending order. The sort is stable. Adding or removing elements from inside the comparator is an error.
+---@param comparator? fun(a: any, b: any): boolean
+function DynamicArray:sort(comparator) end
+
+---Sorts the DynamicArray in place, keeping equal elements in their original order.
+---@param comparator? fun(a: any, b: any): boolean
+function DynamicArray:stable_sort(comparator) end
+
+---Returns the first index whose value is not less than the given value, or size + 1. The DynamicArray must be sorted.
+---@param value any
+---@param comparator? fun(a: any, b: any): boolean
+---@return number
+function DynamicArray:lower_bound(value, comparator) end
+
+---Returns the first index whose value is greater than the given value, or size + 1. The DynamicArray must be sorted.
+---@param value any
+---@param comparator? fun(a: any, b: any): boolean
+---@return number
+function DynamicArray:upper_bound(value, comparator) end
+
+---Returns whether the sorted DynamicArray contains the value.
+---@param value any
+---@param comparator? fun(a: any, b: any): boolean
+---@return boolean
+function DynamicArray:binary_search(value, comparator) end
+
+---Moves the values for which the predicate returns true in front of the others, keeping their order. Returns the index of the first other value, or size + 1.
+---@param predicate fun(value: any): boolean
+---@return number
+function DynamicArray:partition(predicate) end
+
+---Reorders the DynamicArray so the value at index n is the one a full sort would put there, with no greater value before it and no smaller value after it.
+---@param n number
+---@param comparator? fun(a: any, b: any): boolean
+function DynamicArray:nth_element(n, comparator) end
+
 ---@operator len(): number
 ---@operator add(DynamicArray): DynamicArray
\ No newline at end of file
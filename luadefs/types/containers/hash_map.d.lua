@@ -0,0 +1,67 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class HashMap : userdata
+HashMap = {}
+
+---Creates a HashMap.
+---@return HashMap
+function HashMap.new() end
+
+---Gets the number of entries in the HashMap.
+---@return number
+function HashMap:size() end
+
+---Gets the number of slots in the HashMap.
+---@return number
+function HashMap:capacity() end
+
+---Returns whether the HashMap is empty or not.
+---@return boolean
+function HashMap:empty() end
+
+---Removes all entries from the HashMap.
+function HashMap:clear() end
+
+---Reserves room for the specified amount of entries.
+---@param quantity number
+function HashMap:reserve(quantity) end
+
+---Gets the value stored under the key.
+---@param key any
+---@return any|nil
+function HashMap:get(key) end
+
+---Stores the value under the key. Setting nil removes the key.
+---@param key any
+---@param value any
+function HashMap:set(key, value) end
+
+---Returns whether the key is present.
+---@param key any
+---@return boolean
+function HashMap:has(key) end
+
+---Removes the key and returns whether it was present.
+---@param key any
+---@return boolean
+function HashMap:erase(key) end
+
+---Creates a HashMap from every key and value of a table.
+---@param table table
+---@return HashMap
+function HashMap.from_table(table) end
+
+---Creates a table with every key and value of the HashMap.
+---@return table
+function HashMap:to_table() end
+
+---Creates an ordered table of the keys.
+---@return table
+function HashMap:keys() end
+
+---Creates an ordered table of the values.
+---@return table
+function HashMap:values() end
+
+---@operator len(): number
\ No newline at end of file
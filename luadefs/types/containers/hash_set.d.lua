@@ -0,0 +1,54 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class HashSet : userdata
+HashSet = {}
+
+---Creates a HashSet.
+---@return HashSet
+function HashSet.new() end
+
+---Gets the number of keys in the HashSet.
+---@return number
+function HashSet:size() end
+
+---Gets the number of slots in the HashSet.
+---@return number
+function HashSet:capacity() end
+
+---Returns whether the HashSet is empty or not.
+---@return boolean
+function HashSet:empty() end
+
+---Removes all keys from the HashSet.
+function HashSet:clear() end
+
+---Reserves room for the specified amount of keys.
+---@param quantity number
+function HashSet:reserve(quantity) end
+
+---Adds the key and returns whether it was not already present.
+---@param key any
+---@return boolean
+function HashSet:add(key) end
+
+---Returns whether the key is present.
+---@param key any
+---@return boolean
+function HashSet:has(key) end
+
+---Removes the key and returns whether it was present.
+---@param key any
+---@return boolean
+function HashSet:erase(key) end
+
+---Creates a HashSet from the values of an ordered table.
+---@param table table
+---@return HashSet
+function HashSet.from_table(table) end
+
+---Creates an ordered table of the keys.
+---@return table
+function HashSet:to_table() end
+
+---@operator len(): number
\ No newline at end of file
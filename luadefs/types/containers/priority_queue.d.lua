@@ -0,0 +1,69 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class PriorityQueue : userdata
+PriorityQueue = {}
+
+---Creates a PriorityQueue. Lower priorities pop first.
+---@return PriorityQueue
+function PriorityQueue.new() end
+
+---Creates a PriorityQueue from an ordered table of values and a matching table of priorities. Without priorities, the values must be numbers and are used as their own priorities.
+---@param values table
+---@param priorities? table
+---@return PriorityQueue
+function PriorityQueue.from_table(values, priorities) end
+
+---Gets the number of entries in the PriorityQueue.
+---@return number
+function PriorityQueue:size() end
+
+---Returns whether the PriorityQueue is empty or not.
+---@return boolean
+function PriorityQueue:empty() end
+
+---Removes all entries from the PriorityQueue.
+function PriorityQueue:clear() end
+
+---Reserves memory for the specified amount of entries.
+---@param quantity number
+function PriorityQueue:reserve(quantity) end
+
+---Adds the value with the given priority and returns a handle to the entry.
+---@param value any
+---@param priority number
+---@return integer
+function PriorityQueue:push(value, priority) end
+
+---Removes the entry with the lowest priority and returns its value and priority.
+---@return any|nil value
+---@return number|nil priority
+function PriorityQueue:pop() end
+
+---Returns the value and priority of the entry with the lowest priority without removing it.
+---@return any|nil value
+---@return number|nil priority
+function PriorityQueue:peek() end
+
+---Returns whether the handle refers to an entry that is still queued.
+---@param handle integer
+---@return boolean
+function PriorityQueue:contains(handle) end
+
+---Gets the priority of a queued entry.
+---@param handle integer
+---@return number|nil
+function PriorityQueue:get_priority(handle) end
+
+---Changes the priority of a queued entry and returns whether the handle was still queued.
+---@param handle integer
+---@param priority number
+---@return boolean
+function PriorityQueue:decrease_key(handle, priority) end
+
+---Removes a queued entry and returns its value.
+---@param handle integer
+---@return any|nil
+function PriorityQueue:remove(handle) end
+
+---@operator len(): number
\ No newline at end of file
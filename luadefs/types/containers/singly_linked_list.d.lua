@@ -16,6 +16,10 @@ function SinglyLinkedList:size() end
 ---@return boolean
 function SinglyLinkedList:empty() end
 
+---Pre-sizes the node pool so the next pushes do not allocate.
+---@param count number
+function SinglyLinkedList:reserve(count) end
+
 ---Clears the SinglyLinkedList
 function SinglyLinkedList:clear() end
 
@@ -68,6 +72,41 @@ function SinglyLinkedList.from_table(table) end
 ---@return table
 function SinglyLinkedList:to_table() end
 
+---Creates a cursor at the first item of the SinglyLinkedList.
+---@return SinglyLinkedListCursor
+function SinglyLinkedList:cursor() end
+
 ---@operator len(): number
 ---@operator add(SinglyLinkedList): SinglyLinkedList
----@operator concat(SinglyLinkedList): SinglyLinkedList
\ No newline at end of file
+---@operator concat(SinglyLinkedList): SinglyLinkedList
+
+---@class SinglyLinkedListCursor : userdata
+SinglyLinkedListCursor = {}
+
+---Returns whether the cursor points at an item.
+---@return boolean
+function SinglyLinkedListCursor:valid() end
+
+---Gets the value at the cursor, or nil past the end of the list.
+---@return any|nil
+function SinglyLinkedListCursor:get() end
+
+---Sets the value at the cursor.
+---@param value any
+function SinglyLinkedListCursor:set(value) end
+
+---Moves the cursor to the next item and returns whether there was one.
+---@return boolean
+function SinglyLinkedListCursor:next() end
+
+---Inserts the value after the cursor.
+---@param value any
+function SinglyLinkedListCursor:insert_after(value) end
+
+---Removes the item after the cursor and returns it.
+---@return any|nil
+function SinglyLinkedListCursor:remove_after() end
+
+---Creates a copy of the cursor at the same position.
+---@return SinglyLinkedListCursor
+function SinglyLinkedListCursor:clone() end
\ No newline at end of file
@@ -41,4 +41,40 @@ function StaticArray.from_table(table) end
 ---@return table
 function StaticArray:to_table() end
 
+---Sorts the StaticArray in place, with an optional comparator that returns whether a goes before b. Without one, elements that are all numbers or all strings are sorted natively in ascending order. The sort is stable.
+---@param comparator? fun(a: any, b: any): boolean
+function StaticArray:sort(comparator) end
+
+---Sorts the StaticArray in place, keeping equal elements in their original order.
+---@param comparator? fun(a: any, b: any): boolean
+function StaticArray:stable_sort(comparator) end
+
+---Returns the first index whose value is not less than the given value, or size + 1. The StaticArray must be sorted.
+---@param value any
+---@param comparator? fun(a: any, b: any): boolean
+---@return number
+function StaticArray:lower_bound(value, comparator) end
+
+---Returns the first index whose value is greater than the given value, or size + 1. The StaticArray must be sorted.
+---@param value any
+---@param comparator? fun(a: any, b: any): boolean
+---@return number
+function StaticArray:upper_bound(value, comparator) end
+
+---Returns whether the sorted StaticArray contains the value.
+---@param value any
+---@param comparator? fun(a: any, b: any): boolean
+---@return boolean
+function StaticArray:binary_search(value, comparator) end
+
+---Moves the values for which the predicate returns true in front of the others, keeping their order. Returns the index of the first other value, or size + 1.
+---@param predicate fun(value: any): boolean
+---@return number
+function StaticArray:partition(predicate) end
+
+---Reorders the StaticArray so the value at index n is the one a full sort would put there, with no greater value before it and no smaller value after it.
+---@param n number
+---@param comparator? fun(a: any, b: any): boolean
+function StaticArray:nth_element(n, comparator) end
+
 ---@operator len(): number
\ No newline at end of file
@@ -0,0 +1,470 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class Float32Array : userdata
+Float32Array = {}
+
+---Creates a zero-filled Float32Array with the given number of elements.
+---@param count? number
+---@return Float32Array
+function Float32Array.new(count) end
+
+---Creates a Float32Array from the numbers in an ordered table.
+---@param table table
+---@return Float32Array
+function Float32Array.from_table(table) end
+
+---Creates a Float32Array over the bytes of a File without copying, starting at the 1-based byte offset. Values are read in native byte order and the offset must be aligned to the element size.
+---@param file File
+---@param offset number
+---@param count? number
+---@return Float32Array
+function Float32Array.view(file, offset, count) end
+
+---Gets the number of elements.
+---@return number
+function Float32Array:size() end
+
+---Returns whether the Float32Array is empty or not.
+---@return boolean
+function Float32Array:empty() end
+
+---Returns whether the Float32Array is a view over a File.
+---@return boolean
+function Float32Array:is_view() end
+
+---Gets the element at the specified index.
+---@param index number
+---@return number|nil
+function Float32Array:get(index) end
+
+---Sets the element at the specified index.
+---@param index number
+---@param value number
+function Float32Array:set(index, value) end
+
+---Sets every element to the value.
+---@param value number
+function Float32Array:fill(value) end
+
+---Adds a number or the matching elements of another Float32Array to every element.
+---@param value number|Float32Array
+function Float32Array:add(value) end
+
+---Subtracts a number or the matching elements of another Float32Array from every element.
+---@param value number|Float32Array
+function Float32Array:sub(value) end
+
+---Multiplies every element by a number or the matching elements of another Float32Array.
+---@param value number|Float32Array
+function Float32Array:mul(value) end
+
+---Adds a * b to every element, where b is a number or another Float32Array.
+---@param a Float32Array
+---@param b number|Float32Array
+function Float32Array:fma(a, b) end
+
+---Clamps every element between low and high.
+---@param low number
+---@param high number
+function Float32Array:clamp(low, high) end
+
+---Returns the sum of all elements.
+---@return number
+function Float32Array:sum() end
+
+---Returns the dot product with another Float32Array.
+---@param other Float32Array
+---@return number
+function Float32Array:dot(other) end
+
+---Returns the smallest element, or nil when empty.
+---@return number|nil
+function Float32Array:min() end
+
+---Returns the largest element, or nil when empty.
+---@return number|nil
+function Float32Array:max() end
+
+---Sorts the Float32Array in ascending order, with NaN last.
+function Float32Array:sort() end
+
+---Returns the first index whose value is not less than the given value, or size + 1. The Float32Array must be sorted.
+---@param value number
+---@return number
+function Float32Array:lower_bound(value) end
+
+---Returns the first index whose value is greater than the given value, or size + 1. The Float32Array must be sorted.
+---@param value number
+---@return number
+function Float32Array:upper_bound(value) end
+
+---Returns whether the sorted Float32Array contains the value.
+---@param value number
+---@return boolean
+function Float32Array:binary_search(value) end
+
+---Reorders the Float32Array so the value at index n is the one a full sort would put there.
+---@param n number
+function Float32Array:nth_element(n) end
+
+---Creates a copy that owns its memory.
+---@return Float32Array
+function Float32Array:copy() end
+
+---Creates an ordered table from the Float32Array.
+---@return table
+function Float32Array:to_table() end
+
+---@operator len(): number
+
+---@class Float64Array : userdata
+Float64Array = {}
+
+---Creates a zero-filled Float64Array with the given number of elements.
+---@param count? number
+---@return Float64Array
+function Float64Array.new(count) end
+
+---Creates a Float64Array from the numbers in an ordered table.
+---@param table table
+---@return Float64Array
+function Float64Array.from_table(table) end
+
+---Creates a Float64Array over the bytes of a File without copying, starting at the 1-based byte offset. Values are read in native byte order and the offset must be aligned to the element size.
+---@param file File
+---@param offset number
+---@param count? number
+---@return Float64Array
+function Float64Array.view(file, offset, count) end
+
+---Gets the number of elements.
+---@return number
+function Float64Array:size() end
+
+---Returns whether the Float64Array is empty or not.
+---@return boolean
+function Float64Array:empty() end
+
+---Returns whether the Float64Array is a view over a File.
+---@return boolean
+function Float64Array:is_view() end
+
+---Gets the element at the specified index.
+---@param index number
+---@return number|nil
+function Float64Array:get(index) end
+
+---Sets the element at the specified index.
+---@param index number
+---@param value number
+function Float64Array:set(index, value) end
+
+---Sets every element to the value.
+---@param value number
+function Float64Array:fill(value) end
+
+---Adds a number or the matching elements of another Float64Array to every element.
+---@param value number|Float64Array
+function Float64Array:add(value) end
+
+---Subtracts a number or the matching elements of another Float64Array from every element.
+---@param value number|Float64Array
+function Float64Array:sub(value) end
+
+---Multiplies every element by a number or the matching elements of another Float64Array.
+---@param value number|Float64Array
+function Float64Array:mul(value) end
+
+---Adds a * b to every element, where b is a number or another Float64Array.
+---@param a Float64Array
+---@param b number|Float64Array
+function Float64Array:fma(a, b) end
+
+---Clamps every element between low and high.
+---@param low number
+---@param high number
+function Float64Array:clamp(low, high) end
+
+---Returns the sum of all elements.
+---@return number
+function Float64Array:sum() end
+
+---Returns the dot product with another Float64Array.
+---@param other Float64Array
+---@return number
+function Float64Array:dot(other) end
+
+---Returns the smallest element, or nil when empty.
+---@return number|nil
+function Float64Array:min() end
+
+---Returns the largest element, or nil when empty.
+---@return number|nil
+function Float64Array:max() end
+
+---Sorts the Float64Array in ascending order, with NaN last.
+function Float64Array:sort() end
+
+---Returns the first index whose value is not less than the given value, or size + 1. The Float64Array must be sorted.
+---@param value number
+---@return number
+function Float64Array:lower_bound(value) end
+
+---Returns the first index whose value is greater than the given value, or size + 1. The Float64Array must be sorted.
+---@param value number
+---@return number
+function Float64Array:upper_bound(value) end
+
+---Returns whether the sorted Float64Array contains the value.
+---@param value number
+---@return boolean
+function Float64Array:binary_search(value) end
+
+---Reorders the Float64Array so the value at index n is the one a full sort would put there.
+---@param n number
+function Float64Array:nth_element(n) end
+
+---Creates a copy that owns its memory.
+---@return Float64Array
+function Float64Array:copy() end
+
+---Creates an ordered table from the Float64Array.
+---@return table
+function Float64Array:to_table() end
+
+---@operator len(): number
+
+---@class Int32Array : userdata
+Int32Array = {}
+
+---Creates a zero-filled Int32Array with the given number of elements.
+---@param count? number
+---@return Int32Array
+function Int32Array.new(count) end
+
+---Creates a Int32Array from the numbers in an ordered table.
+---@param table table
+---@return Int32Array
+function Int32Array.from_table(table) end
+
+---Creates a Int32Array over the bytes of a File without copying, starting at the 1-based byte offset. Values are read in native byte order and the offset must be aligned to the element size.
+---@param file File
+---@param offset number
+---@param count? number
+---@return Int32Array
+function Int32Array.view(file, offset, count) end
+
+---Gets the number of elements.
+---@return number
+function Int32Array:size() end
+
+---Returns whether the Int32Array is empty or not.
+---@return boolean
+function Int32Array:empty() end
+
+---Returns whether the Int32Array is a view over a File.
+---@return boolean
+function Int32Array:is_view() end
+
+---Gets the element at the specified index.
+---@param index number
+---@return number|nil
+function Int32Array:get(index) end
+
+---Sets the element at the specified index.
+---@param index number
+---@param value number
+function Int32Array:set(index, value) end
+
+---Sets every element to the value.
+---@param value number
+function Int32Array:fill(value) end
+
+---Adds a number or the matching elements of another Int32Array to every element.
+---@param value number|Int32Array
+function Int32Array:add(value) end
+
+---Subtracts a number or the matching elements of another Int32Array from every element.
+---@param value number|Int32Array
+function Int32Array:sub(value) end
+
+---Multiplies every element by a number or the matching elements of another Int32Array.
+---@param value number|Int32Array
+function Int32Array:mul(value) end
+
+---Adds a * b to every element, where b is a number or another Int32Array.
+---@param a Int32Array
+---@param b number|Int32Array
+function Int32Array:fma(a, b) end
+
+---Clamps every element between low and high.
+---@param low number
+---@param high number
+function Int32Array:clamp(low, high) end
+
+---Returns the sum of all elements.
+---@return number
+function Int32Array:sum() end
+
+---Returns the dot product with another Int32Array.
+---@param other Int32Array
+---@return number
+function Int32Array:dot(other) end
+
+---Returns the smallest element, or nil when empty.
+---@return number|nil
+function Int32Array:min() end
+
+---Returns the largest element, or nil when empty.
+---@return number|nil
+function Int32Array:max() end
+
+---Sorts the Int32Array in ascending order, with NaN last.
+function Int32Array:sort() end
+
+---Returns the first index whose value is not less than the given value, or size + 1. The Int32Array must be sorted.
+---@param value number
+---@return number
+function Int32Array:lower_bound(value) end
+
+---Returns the first index whose value is greater than the given value, or size + 1. The Int32Array must be sorted.
+---@param value number
+---@return number
+function Int32Array:upper_bound(value) end
+
+---Returns whether the sorted Int32Array contains the value.
+---@param value number
+---@return boolean
+function Int32Array:binary_search(value) end
+
+---Reorders the Int32Array so the value at index n is the one a full sort would put there.
+---@param n number
+function Int32Array:nth_element(n) end
+
+---Creates a copy that owns its memory.
+---@return Int32Array
+function Int32Array:copy() end
+
+---Creates an ordered table from the Int32Array.
+---@return table
+function Int32Array:to_table() end
+
+---@operator len(): number
+
+---@class UInt8Array : userdata
+UInt8Array = {}
+
+---Creates a zero-filled UInt8Array with the given number of elements.
+---@param count? number
+---@return UInt8Array
+function UInt8Array.new(count) end
+
+---Creates a UInt8Array from the numbers in an ordered table.
+---@param table table
+---@return UInt8Array
+function UInt8Array.from_table(table) end
+
+---Creates a UInt8Array over the bytes of a File without copying, starting at the 1-based byte offset. Values are read in native byte order and the offset must be aligned to the element size.
+---@param file File
+---@param offset number
+---@param count? number
+---@return UInt8Array
+function UInt8Array.view(file, offset, count) end
+
+---Gets the number of elements.
+---@return number
+function UInt8Array:size() end
+
+---Returns whether the UInt8Array is empty or not.
+---@return boolean
+function UInt8Array:empty() end
+
+---Returns whether the UInt8Array is a view over a File.
+---@return boolean
+function UInt8Array:is_view() end
+
+---Gets the element at the specified index.
+---@param index number
+---@return number|nil
+function UInt8Array:get(index) end
+
+---Sets the element at the specified index.
+---@param index number
+---@param value number
+function UInt8Array:set(index, value) end
+
+---Sets every element to the value.
+---@param value number
+function UInt8Array:fill(value) end
+
+---Adds a number or the matching elements of another UInt8Array to every element.
+---@param value number|UInt8Array
+function UInt8Array:add(value) end
+
+---Subtracts a number or the matching elements of another UInt8Array from every element.
+---@param value number|UInt8Array
+function UInt8Array:sub(value) end
+
+---Multiplies every element by a number or the matching elements of another UInt8Array.
+---@param value number|UInt8Array
+function UInt8Array:mul(value) end
+
+---Adds a * b to every element, where b is a number or another UInt8Array.
+---@param a UInt8Array
+---@param b number|UInt8Array
+function UInt8Array:fma(a, b) end
+
+---Clamps every element between low and high.
+---@param low number
+---@param high number
+function UInt8Array:clamp(low, high) end
+
+---Returns the sum of all elements.
+---@return number
+function UInt8Array:sum() end
+
+---Returns the dot product with another UInt8Array.
+---@param other UInt8Array
+---@return number
+function UInt8Array:dot(other) end
+
+---Returns the smallest element, or nil when empty.
+---@return number|nil
+function UInt8Array:min() end
+
+---Returns the largest element, or nil when empty.
+---@return number|nil
+function UInt8Array:max() end
+
+---Sorts the UInt8Array in ascending order, with NaN last.
+function UInt8Array:sort() end
+
+---Returns the first index whose value is not less than the given value, or size + 1. The UInt8Array must be sorted.
+---@param value number
+---@return number
+function UInt8Array:lower_bound(value) end
+
+---Returns the first index whose value is greater than the given value, or size + 1. The UInt8Array must be sorted.
+---@param value number
+---@return number
+function UInt8Array:upper_bound(value) end
+
+---Returns whether the sorted UInt8Array contains the value.
+---@param value number
+---@return boolean
+function UInt8Array:binary_search(value) end
+
+---Reorders the UInt8Array so the value at index n is the one a full sort would put there.
+---@param n number
+function UInt8Array:nth_element(n) end
+
+---Creates a copy that owns its memory.
+---@return UInt8Array
+function UInt8Array:copy() end
+
+---Creates an ordered table from the UInt8Array.
+---@return table
+function UInt8Array:to_table() end
+
+---@operator len(): number
\ No newline at end of file
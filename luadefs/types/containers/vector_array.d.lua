@@ -0,0 +1,232 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class Vector2Array : userdata
+Vector2Array = {}
+
+---Creates a Vector2Array with the given number of zero vectors.
+---@param count? number
+---@return Vector2Array
+function Vector2Array.new(count) end
+
+---Creates a Vector2Array from an ordered table of Vector2.
+---@param table table
+---@return Vector2Array
+function Vector2Array.from_table(table) end
+
+---Gets the number of elements.
+---@return number
+function Vector2Array:size() end
+
+---Gets the current capacity of the Vector2Array.
+---@return number
+function Vector2Array:capacity() end
+
+---Returns whether the Vector2Array is empty or not.
+---@return boolean
+function Vector2Array:empty() end
+
+---Removes all elements from the Vector2Array.
+function Vector2Array:clear() end
+
+---Reserves memory for the specified amount of elements.
+---@param quantity number
+function Vector2Array:reserve(quantity) end
+
+---Resizes the Vector2Array; new elements are zero.
+---@param count number
+function Vector2Array:resize(count) end
+
+---Adds a Vector2 at the end of the Vector2Array.
+---@param vector Vector2
+function Vector2Array:push(vector) end
+
+---Gets the element at the specified index.
+---@param index number
+---@return Vector2|nil
+function Vector2Array:get(index) end
+
+---Sets the element at the specified index.
+---@param index number
+---@param vector Vector2
+function Vector2Array:set(index, vector) end
+
+---Adds a Vector2 or the matching elements of another Vector2Array to every element.
+---@param value Vector2|Vector2Array
+function Vector2Array:add(value) end
+
+---Subtracts a Vector2 or the matching elements of another Vector2Array from every element.
+---@param value Vector2|Vector2Array
+function Vector2Array:sub(value) end
+
+---Multiplies every element component-wise by a Vector2 or the matching elements of another Vector2Array.
+---@param value Vector2|Vector2Array
+function Vector2Array:mul(value) end
+
+---Multiplies every element by a number.
+---@param scalar number
+function Vector2Array:scale(scalar) end
+
+---Adds other * scalar to every element.
+---@param other Vector2Array
+---@param scalar number
+function Vector2Array:add_scaled(other, scalar) end
+
+---Moves every element towards a Vector2 or the matching elements of another Vector2Array.
+---@param value Vector2|Vector2Array
+---@param alpha number
+function Vector2Array:lerp(value, alpha) end
+
+---Normalizes every element. Zero vectors stay zero.
+function Vector2Array:normalize() end
+
+---Returns the length of every element.
+---@return Float32Array
+function Vector2Array:lengths() end
+
+---Returns the dot product of every element with a Vector2 or the matching elements of another Vector2Array.
+---@param value Vector2|Vector2Array
+---@return Float32Array
+function Vector2Array:dot(value) end
+
+---Rotates every element counter-clockwise by the angle in radians.
+---@param angle number
+function Vector2Array:rotate(angle) end
+
+---Returns the axis-aligned bounds of the Vector2Array, or nil when empty.
+---@return Vector2|nil min
+---@return Vector2|nil max
+function Vector2Array:bounds() end
+
+---Applies a row-major affine matrix given as 6 or 9 numbers. Translation is the last column.
+---@param matrix number[]
+function Vector2Array:transform(matrix) end
+
+---Creates a copy of the Vector2Array.
+---@return Vector2Array
+function Vector2Array:copy() end
+
+---Creates an ordered table of Vector2 from the Vector2Array.
+---@return table
+function Vector2Array:to_table() end
+
+---@operator len(): number
+
+---@class Vector3Array : userdata
+Vector3Array = {}
+
+---Creates a Vector3Array with the given number of zero vectors.
+---@param count? number
+---@return Vector3Array
+function Vector3Array.new(count) end
+
+---Creates a Vector3Array from an ordered table of Vector3.
+---@param table table
+---@return Vector3Array
+function Vector3Array.from_table(table) end
+
+---Gets the number of elements.
+---@return number
+function Vector3Array:size() end
+
+---Gets the current capacity of the Vector3Array.
+---@return number
+function Vector3Array:capacity() end
+
+---Returns whether the Vector3Array is empty or not.
+---@return boolean
+function Vector3Array:empty() end
+
+---Removes all elements from the Vector3Array.
+function Vector3Array:clear() end
+
+---Reserves memory for the specified amount of elements.
+---@param quantity number
+function Vector3Array:reserve(quantity) end
+
+---Resizes the Vector3Array; new elements are zero.
+---@param count number
+function Vector3Array:resize(count) end
+
+---Adds a Vector3 at the end of the Vector3Array.
+---@param vector Vector3
+function Vector3Array:push(vector) end
+
+---Gets the element at the specified index.
+---@param index number
+---@return Vector3|nil
+function Vector3Array:get(index) end
+
+---Sets the element at the specified index.
+---@param index number
+---@param vector Vector3
+function Vector3Array:set(index, vector) end
+
+---Adds a Vector3 or the matching elements of another Vector3Array to every element.
+---@param value Vector3|Vector3Array
+function Vector3Array:add(value) end
+
+---Subtracts a Vector3 or the matching elements of another Vector3Array from every element.
+---@param value Vector3|Vector3Array
+function Vector3Array:sub(value) end
+
+---Multiplies every element component-wise by a Vector3 or the matching elements of another Vector3Array.
+---@param value Vector3|Vector3Array
+function Vector3Array:mul(value) end
+
+---Multiplies every element by a number.
+---@param scalar number
+function Vector3Array:scale(scalar) end
+
+---Adds other * scalar to every element.
+---@param other Vector3Array
+---@param scalar number
+function Vector3Array:add_scaled(other, scalar) end
+
+---Moves every element towards a Vector3 or the matching elements of another Vector3Array.
+---@param value Vector3|Vector3Array
+---@param alpha number
+function Vector3Array:lerp(value, alpha) end
+
+---Normalizes every element. Zero vectors stay zero.
+function Vector3Array:normalize() end
+
+---Returns the length of every element.
+---@return Float32Array
+function Vector3Array:lengths() end
+
+---Returns the dot product of every element with a Vector3 or the matching elements of another Vector3Array.
+---@param value Vector3|Vector3Array
+---@return Float32Array
+function Vector3Array:dot(value) end
+
+---Replaces every element with its cross product with a Vector3 or the matching elements of another Vector3Array.
+---@param value Vector3|Vector3Array
+function Vector3Array:cross(value) end
+
+---Rotates every element by a unit quaternion, given as a Quaternion or as its (w, x, y, z) components.
+---@overload fun(self: Vector3Array, rotation: Quaternion)
+---@param w number
+---@param x number
+---@param y number
+---@param z number
+function Vector3Array:rotate(w, x, y, z) end
+
+---Returns the axis-aligned bounds of the Vector3Array, or nil when empty.
+---@return Vector3|nil min
+---@return Vector3|nil max
+function Vector3Array:bounds() end
+
+---Transforms every element as a point by a Matrix4 or a row-major affine matrix given as 12 or 16 numbers. Translation is the last column.
+---@param matrix Matrix4|number[]
+function Vector3Array:transform(matrix) end
+
+---Creates a copy of the Vector3Array.
+---@return Vector3Array
+function Vector3Array:copy() end
+
+---Creates an ordered table of Vector3 from the Vector3Array.
+---@return table
+function Vector3Array:to_table() end
+
+---@operator len(): number
\ No newline at end of file
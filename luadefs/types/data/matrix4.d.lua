@@ -0,0 +1,97 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class Matrix4 : userdata
+Matrix4 = {}
+
+---Creates an identity Matrix4. Matrices are row-major with the translation in the last column, as in Ogre.
+---@return Matrix4
+function Matrix4.new() end
+
+---The identity matrix.
+---@return Matrix4
+function Matrix4.identity() end
+
+---Translation matrix.
+---@param translation Vector3
+---@return Matrix4
+function Matrix4.from_translation(translation) end
+
+---Scale matrix.
+---@param scale Vector3
+---@return Matrix4
+function Matrix4.from_scale(scale) end
+
+---Rotation matrix.
+---@param rotation Quaternion
+---@return Matrix4
+function Matrix4.from_rotation(rotation) end
+
+---Translation * rotation * scale, as used for scene nodes.
+---@param translation Vector3
+---@param rotation Quaternion
+---@param scale Vector3
+---@return Matrix4
+function Matrix4.compose(translation, rotation, scale) end
+
+---Creates a Matrix4 from an ordered table of 16 numbers in row-major order.
+---@param table number[]
+---@return Matrix4
+function Matrix4.from_table(table) end
+
+---Splits an affine matrix into translation, rotation and scale.
+---@return Vector3 translation
+---@return Quaternion rotation
+---@return Vector3 scale
+function Matrix4:decompose() end
+
+---Translation part.
+---@return Vector3
+function Matrix4:translation() end
+
+---Gets an element. Rows and columns are 1-based.
+---@param row number
+---@param column number
+---@return number
+function Matrix4:get(row, column) end
+
+---Sets an element. Rows and columns are 1-based.
+---@param row number
+---@param column number
+---@param value number
+function Matrix4:set(row, column, value) end
+
+---Transforms a point, dividing by w for projective matrices. Same as `matrix * point`.
+---@param point Vector3
+---@return Vector3
+function Matrix4:transform_point(point) end
+
+---Transforms a direction by the upper 3x3 part, ignoring translation.
+---@param direction Vector3
+---@return Vector3
+function Matrix4:transform_direction(direction) end
+
+---Transposed copy.
+---@return Matrix4
+function Matrix4:transpose() end
+
+---Determinant.
+---@return number
+function Matrix4:determinant() end
+
+---Inverse. Errors if the matrix is singular.
+---@return Matrix4
+function Matrix4:inverse() end
+
+---Approximate equality, per element.
+---@param other Matrix4
+---@param epsilon? number
+---@return boolean
+function Matrix4:fuzzy_eq(other, epsilon) end
+
+---Returns the 16 elements in row-major order.
+---@return number[]
+function Matrix4:to_table() end
+
+---@operator mul(Matrix4): Matrix4
+---@operator mul(Vector3): Vector3
\ No newline at end of file
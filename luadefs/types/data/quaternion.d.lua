@@ -0,0 +1,95 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class Quaternion : userdata
+---@field w number
+---@field x number
+---@field y number
+---@field z number
+Quaternion = {}
+
+---Creates a Quaternion with the specified W, X, Y, and Z values. Without arguments, creates the identity rotation.
+---@overload fun(): Quaternion
+---@param w number
+---@param x number
+---@param y number
+---@param z number
+---@return Quaternion
+function Quaternion.new(w, x, y, z) end
+
+---The identity rotation.
+---@return Quaternion
+function Quaternion.identity() end
+
+---Rotation by the angle in radians around the axis. The axis does not need to be normalized.
+---@param axis Vector3
+---@param angle number
+---@return Quaternion
+function Quaternion.from_axis_angle(axis, angle) end
+
+---Rotation about X, then Y, then Z, in radians.
+---@param pitch number
+---@param yaw number
+---@param roll number
+---@return Quaternion
+function Quaternion.from_euler(pitch, yaw, roll) end
+
+---Dot product.
+---@param other Quaternion
+---@return number
+function Quaternion:dot(other) end
+
+---Length (magnitude)
+---@return number
+function Quaternion:length() end
+
+---Unit-length copy.
+---@return Quaternion
+function Quaternion:normalized() end
+
+---Conjugate, the inverse of a unit quaternion.
+---@return Quaternion
+function Quaternion:conjugate() end
+
+---Inverse, or zero for a zero quaternion.
+---@return Quaternion
+function Quaternion:inverse() end
+
+---Rotates a vector. Same as `quaternion * vector`.
+---@param vector Vector3
+---@return Vector3
+function Quaternion:rotate(vector) end
+
+---Spherical interpolation along the shorter arc.
+---@param other Quaternion
+---@param alpha number
+---@return Quaternion
+function Quaternion:slerp(other, alpha) end
+
+---Axis and angle in radians.
+---@return Vector3 axis
+---@return number angle
+function Quaternion:to_axis_angle() end
+
+---Approximate equality.
+---@param other Quaternion
+---@param epsilon? number
+---@return boolean
+function Quaternion:fuzzy_eq(other, epsilon) end
+
+---Overwrites every component in place.
+---@param w number
+---@param x number
+---@param y number
+---@param z number
+function Quaternion:set(w, x, y, z) end
+
+---Returns every component as a separate number.
+---@return number w
+---@return number x
+---@return number y
+---@return number z
+function Quaternion:unpack() end
+
+---@operator mul(Quaternion): Quaternion
+---@operator mul(Vector3): Vector3
\ No newline at end of file
@@ -71,6 +71,28 @@ function Vector2:lerp(other, alpha) end
 ---@return boolean
 function Vector2:fuzzy_eq(other, epsilon) end
 
+---Adds other to this vector in place, without allocating a new Vector2.
+---@param other Vector2
+function Vector2:add_assign(other) end
+
+---Subtracts other from this vector in place, without allocating a new Vector2.
+---@param other Vector2
+function Vector2:sub_assign(other) end
+
+---Multiplies this vector by a scalar in place, without allocating a new Vector2.
+---@param scalar number
+function Vector2:scale_assign(scalar) end
+
+---Overwrites every component in place.
+---@param x number
+---@param y number
+function Vector2:set(x, y) end
+
+---Returns every component as a separate number.
+---@return number x
+---@return number y
+function Vector2:unpack() end
+
 ---@operator add(Vector2): Vector2
 ---@operator sub(Vector2): Vector2
 ---@operator mul(number): Vector2
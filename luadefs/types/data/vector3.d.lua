@@ -70,6 +70,30 @@ function Vector3:lerp(other, alpha) end
 ---@return boolean
 function Vector3:fuzzy_eq(other, epsilon) end
 
+---Adds other to this vector in place, without allocating a new Vector3.
+---@param other Vector3
+function Vector3:add_assign(other) end
+
+---Subtracts other from this vector in place, without allocating a new Vector3.
+---@param other Vector3
+function Vector3:sub_assign(other) end
+
+---Multiplies this vector by a scalar in place, without allocating a new Vector3.
+---@param scalar number
+function Vector3:scale_assign(scalar) end
+
+---Overwrites every component in place.
+---@param x number
+---@param y number
+---@param z number
+function Vector3:set(x, y, z) end
+
+---Returns every component as a separate number.
+---@return number x
+---@return number y
+---@return number z
+function Vector3:unpack() end
+
 ---@operator add(Vector3): Vector3
 ---@operator sub(Vector3): Vector3
 ---@operator mul(number): Vector3
@@ -0,0 +1,74 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class Bvh : userdata
+Bvh = {}
+
+---Creates a dynamic bounding volume hierarchy for 3D objects. Boxes are padded by the margin so small moves do not restructure the tree.
+---@param margin? number
+---@return Bvh
+function Bvh.new(margin) end
+
+---Gets the margin of the Bvh.
+---@return number
+function Bvh:margin() end
+
+---Gets the height of the tree.
+---@return number
+function Bvh:height() end
+
+---Gets the number of objects in the Bvh.
+---@return number
+function Bvh:size() end
+
+---Returns whether the Bvh is empty or not.
+---@return boolean
+function Bvh:empty() end
+
+---Returns whether the handle refers to an object that is still in the Bvh.
+---@param handle integer
+---@return boolean
+function Bvh:contains(handle) end
+
+---Removes all objects from the Bvh.
+function Bvh:clear() end
+
+---Adds an object with the given bounding box and returns its handle. Handles are positive integers. Removing an object invalidates its handle, and later objects get different handles until the same slot has been reused 2048 times, so key a table by handle rather than using it as an array index.
+---@param min Vector3
+---@param max Vector3
+---@return integer
+function Bvh:insert(min, max) end
+
+---Updates the bounding box of an object and returns whether the handle was still in the Bvh.
+---@param handle integer
+---@param min Vector3
+---@param max Vector3
+---@return boolean
+function Bvh:move(handle, min, max) end
+
+---Removes an object and returns whether the handle was still in the Bvh.
+---@param handle integer
+---@return boolean
+function Bvh:remove(handle) end
+
+---Returns the handles of every object overlapping the box.
+---@param min Vector3
+---@param max Vector3
+---@return Int32Array
+function Bvh:query_box(min, max) end
+
+---Returns the handles of every object within the radius of the center.
+---@param center Vector3
+---@param radius number
+---@return Int32Array
+function Bvh:query_radius(center, radius) end
+
+---Casts a ray and returns the handle of the nearest object hit and the distance to it.
+---@param origin Vector3
+---@param direction Vector3
+---@param max_distance? number
+---@return integer|nil handle
+---@return number|nil distance
+function Bvh:raycast(origin, direction, max_distance) end
+
+---@operator len(): number
\ No newline at end of file
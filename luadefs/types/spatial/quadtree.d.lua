@@ -0,0 +1,72 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class Quadtree : userdata
+Quadtree = {}
+
+---Creates a Quadtree for 2D objects covering the given world bounds. Objects outside the bounds are still supported but are not subdivided.
+---@param min Vector2
+---@param max Vector2
+---@param max_depth? number
+---@return Quadtree
+function Quadtree.new(min, max, max_depth) end
+
+---Gets the maximum depth of the Quadtree.
+---@return number
+function Quadtree:max_depth() end
+
+---Gets the number of objects in the Quadtree.
+---@return number
+function Quadtree:size() end
+
+---Returns whether the Quadtree is empty or not.
+---@return boolean
+function Quadtree:empty() end
+
+---Returns whether the handle refers to an object that is still in the Quadtree.
+---@param handle integer
+---@return boolean
+function Quadtree:contains(handle) end
+
+---Removes all objects from the Quadtree.
+function Quadtree:clear() end
+
+---Adds an object with the given bounding box and returns its handle. Handles are positive integers. Removing an object invalidates its handle, and later objects get different handles until the same slot has been reused 2048 times, so key a table by handle rather than using it as an array index.
+---@param min Vector2
+---@param max Vector2
+---@return integer
+function Quadtree:insert(min, max) end
+
+---Updates the bounding box of an object and returns whether the handle was still in the Quadtree.
+---@param handle integer
+---@param min Vector2
+---@param max Vector2
+---@return boolean
+function Quadtree:move(handle, min, max) end
+
+---Removes an object and returns whether the handle was still in the Quadtree.
+---@param handle integer
+---@return boolean
+function Quadtree:remove(handle) end
+
+---Returns the handles of every object overlapping the box.
+---@param min Vector2
+---@param max Vector2
+---@return Int32Array
+function Quadtree:query_box(min, max) end
+
+---Returns the handles of every object within the radius of the center.
+---@param center Vector2
+---@param radius number
+---@return Int32Array
+function Quadtree:query_radius(center, radius) end
+
+---Casts a ray and returns the handle of the nearest object hit and the distance to it.
+---@param origin Vector2
+---@param direction Vector2
+---@param max_distance? number
+---@return integer|nil handle
+---@return number|nil distance
+function Quadtree:raycast(origin, direction, max_distance) end
+
+---@operator len(): number
\ No newline at end of file
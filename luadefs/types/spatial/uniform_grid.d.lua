@@ -0,0 +1,70 @@
+---@meta
+---@diagnostic disable: missing-return
+
+---@class UniformGrid : userdata
+UniformGrid = {}
+
+---Creates a loose UniformGrid for 2D objects. Works best when the cell size is close to the typical object size.
+---@param cell_size number
+---@return UniformGrid
+function UniformGrid.new(cell_size) end
+
+---Gets the cell size of the UniformGrid.
+---@return number
+function UniformGrid:cell_size() end
+
+---Gets the number of objects in the UniformGrid.
+---@return number
+function UniformGrid:size() end
+
+---Returns whether the UniformGrid is empty or not.
+---@return boolean
+function UniformGrid:empty() end
+
+---Returns whether the handle refers to an object that is still in the UniformGrid.
+---@param handle integer
+---@return boolean
+function UniformGrid:contains(handle) end
+
+---Removes all objects from the UniformGrid.
+function UniformGrid:clear() end
+
+---Adds an object with the given bounding box and returns its handle. Handles are positive integers. Removing an object invalidates its handle, and later objects get different handles until the same slot has been reused 2048 times, so key a table by handle rather than using it as an array index.
+---@param min Vector2
+---@param max Vector2
+---@return integer
+function UniformGrid:insert(min, max) end
+
+---Updates the bounding box of an object and returns whether the handle was still in the UniformGrid.
+---@param handle integer
+---@param min Vector2
+---@param max Vector2
+---@return boolean
+function UniformGrid:move(handle, min, max) end
+
+---Removes an object and returns whether the handle was still in the UniformGrid.
+---@param handle integer
+---@return boolean
+function UniformGrid:remove(handle) end
+
+---Returns the handles of every object overlapping the box.
+---@param min Vector2
+---@param max Vector2
+---@return Int32Array
+function UniformGrid:query_box(min, max) end
+
+---Returns the handles of every object within the radius of the center.
+---@param center Vector2
+---@param radius number
+---@return Int32Array
+function UniformGrid:query_radius(center, radius) end
+
+---Casts a ray and returns the handle of the nearest object hit and the distance to it.
+---@param origin Vector2
+---@param direction Vector2
+---@param max_distance? number
+---@return integer|nil handle
+---@return number|nil distance
+function UniformGrid:raycast(origin, direction, max_distance) end
+
+---@operator len(): number
\ No newline at end of file